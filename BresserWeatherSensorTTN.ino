@@ -125,6 +125,44 @@
 // 20240606 Replaced ESP32AnalogRead by analogReadMilliVolts()
 //          Updated board configurations after changes in 
 //          Arduino ESP32 package v3.0.X
+// 20261017 Added execution time measurement of uplink phases (PHASE_TIMER_EN)
+//          Replaced payload encoding by table-driven encoder (src/Payload)
+//          Added delta/varint compressed uplink on FPort 4 (PAYLOAD_COMPRESSED_EN)
+//          Added RETAINED_ATTR for variables retained in RAM on RP2040
+//          Added batched multi-sample uplink on FPort 5 (BATCH_EN)
+//          Added continuous receive mode with radio context switch (CONTINUOUS_RX_EN)
+//          Added fast boot mode (FAST_BOOT_EN) and boot phase timing
+//          Added receive policy with early exit and adaptive deadline (RX_POLICY_EN)
+//          Added wake-up scheduling by sensor arrival prediction (ARRIVAL_PREDICTION_EN)
+//          Indoor temperature/humidity: use first valid BLE sensor instead of first in list
+//          Added passive (BLE_SCAN_PASSIVE_EN) and adaptive (BLE_SCAN_ADAPTIVE_EN) BLE scan
+//          Added multi-sensor uplink on FPort 6 (MULTI_SENSOR_EN)
+//          Replaced weatherSensor.findType() by sensor type -> slot index (SensorIndex)
+//          Added rain statistics retained in RAM with O(1) queries (RAIN_HISTORY_EN)
+//          Added storage of preferences/session as CRC-checked blobs (PERSIST_BLOB_EN)
+//          Session state: flash write only if changed, FCntUp every SESSION_FCNT_INTERVAL uplinks
+//          Added energy accounting per wake/sleep cycle (ENERGY_MODEL_EN)
+//          Added diagnostic uplink with wake cycle histograms on FPort 7 (TELEMETRY_EN)
+//          Added deferred binary logging of uplink data (BINLOG_EN)
+//          ReceiveCb(): fixed quadratic hex dump of downlink data
+//          Added per-subsystem log levels; debug-only code excluded at compile time
+//          Added transmit policy (TX_POLICY_EN): confirmed every n-th uplink,
+//          payload truncated at low data rates (FPort 8), sleep backoff on poor link
+//          Added tickless idle while waiting for the LMIC (TICKLESS_IDLE_EN)
+//          Added lightning event history on FPort 9 (LIGHTNING_HISTORY_EN)
+//          Fixed sleep decision with pending uplinks - moved from ReceiveCb() to loop()
+//          prepareSleep(): use prefs.sleep_interval with PERSIST_BLOB_EN
+//          TX_POLICY_EN: batch frames (BATCH_EN) are always confirmed
+//          BATCH_EN: added check for SLEEP_EN, skip uplink if batch frame does not fit
+//          doCfgUplink(): payload hex dump via logm_d()
+//          RAIN_HISTORY_EN: rain history saved to flash on RP2040
+//          ARRIVAL_PREDICTION_EN: period measurement only every ARRIVAL_LEARN_INTERVAL cycles
+//          MULTI_SENSOR_EN: requested config/status uplink is sent before multi-sensor frames
+//          TELEMETRY_EN: requested config/status uplink is sent before diagnostic frame
+//          LIGHTNING_HISTORY_EN: requested config/status uplink is sent before lightning events
+//          TX_POLICY_EN: size limit and confirmation policy also apply to FPort 6, 7 and 9 frames
+//          ARRIVAL_PREDICTION_EN: arrival time taken when the weather sensor message is decoded
+//          PERSIST_BLOB_EN: RP2040 - FCntUp since last flash write kept in watchdog scratch register
 //
 // ToDo:
 // - Split this file
@@ -175,7 +213,12 @@
 #include <M5Unified.h>
 #endif
 
-#ifdef RAINDATA_EN
+#if defined(RAINDATA_EN) && defined(RAIN_HISTORY_EN)
+    #include "src/RainHistory/RainHistory.h"
+    #if !defined(ESP32)
+        #include "src/PersistStore/PersistStore.h"
+    #endif
+#elif defined(RAINDATA_EN)
     #include "RainGauge.h"
 #endif
 
@@ -215,9 +258,117 @@
     #include "src/BleSensors/BleSensors.h"
 #endif
 
+#ifdef PHASE_TIMER_EN
+    #include "src/PhaseTimer/PhaseTimer.h"
+    #define PHASE_START(p) phaseTimer.start(p)
+    #define PHASE_STOP(p)  phaseTimer.stop(p)
+#else
+    #define PHASE_START(p)
+    #define PHASE_STOP(p)
+#endif
+
+// Deferred binary logging - blog_*() falls back to log_*() if disabled
+#ifdef BINLOG_EN
+    #include "src/BinLog/BinLog.h"
+    #if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_ERROR
+        #define blog_e(fmt, ...) binLog.write(ARDUHAL_LOG_LEVEL_ERROR, BINLOG_ID(fmt), ##__VA_ARGS__)
+    #else
+        #define blog_e(...) {}
+    #endif
+    #if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_WARN
+        #define blog_w(fmt, ...) binLog.write(ARDUHAL_LOG_LEVEL_WARN, BINLOG_ID(fmt), ##__VA_ARGS__)
+    #else
+        #define blog_w(...) {}
+    #endif
+    #if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_INFO
+        #define blog_i(fmt, ...) binLog.write(ARDUHAL_LOG_LEVEL_INFO, BINLOG_ID(fmt), ##__VA_ARGS__)
+    #else
+        #define blog_i(...) {}
+    #endif
+    #if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_DEBUG
+        #define blog_d(fmt, ...) binLog.write(ARDUHAL_LOG_LEVEL_DEBUG, BINLOG_ID(fmt), ##__VA_ARGS__)
+    #else
+        #define blog_d(...) {}
+    #endif
+    #if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_VERBOSE
+        #define blog_v(fmt, ...) binLog.write(ARDUHAL_LOG_LEVEL_VERBOSE, BINLOG_ID(fmt), ##__VA_ARGS__)
+    #else
+        #define blog_v(...) {}
+    #endif
+#else
+    #define blog_e log_e
+    #define blog_w log_w
+    #define blog_i log_i
+    #define blog_d log_d
+    #define blog_v log_v
+#endif
+
+#ifdef ENERGY_MODEL_EN
+    #include "src/EnergyModel/EnergyModel.h"
+    #define ENERGY_START(p)     energyModel.start(p)
+    #define ENERGY_STOP(p)      energyModel.stop(p)
+    #define ENERGY_ADD(p, us)   energyModel.add(p, us)
+#else
+    #define ENERGY_START(p)
+    #define ENERGY_STOP(p)
+    #define ENERGY_ADD(p, us)
+#endif
+
 // LoRa_Serialization
 #include <LoraMessage.h>
 
+// Sensor type -> slot index
+#include "src/SensorIndex/SensorIndex.h"
+
+#ifdef PERSIST_BLOB_EN
+    #include "src/PersistStore/PersistStore.h"
+#endif
+
+// Uplink payload schema and encoder
+#include "src/Payload/PayloadEncoder.h"
+#ifdef PAYLOAD_COMPRESSED_EN
+    #include "src/Payload/PayloadCompressor.h"
+#endif
+#ifdef BATCH_EN
+    #include "src/SampleBatch/SampleBatch.h"
+#endif
+#ifdef CONTINUOUS_RX_EN
+    #include "src/RadioCtx/RadioCtx.h"
+#endif
+#ifdef RX_POLICY_EN
+    #include "src/RxPolicy/RxPolicy.h"
+#endif
+#ifdef TX_POLICY_EN
+    #include "src/TxPolicy/TxPolicy.h"
+#endif
+#ifdef TICKLESS_IDLE_EN
+    #include "src/TicklessIdle/TicklessIdle.h"
+#endif
+#ifdef ARRIVAL_PREDICTION_EN
+    #include "src/ArrivalPredictor/ArrivalPredictor.h"
+#endif
+#ifdef MULTI_SENSOR_EN
+    #include "src/MultiSensor/MultiSensor.h"
+#endif
+#ifdef TELEMETRY_EN
+    #include "src/Telemetry/Telemetry.h"
+#endif
+#ifdef LIGHTNING_HISTORY_EN
+    #include "src/LightningHistory/LightningHistory.h"
+#endif
+
+#if defined(CONTINUOUS_RX_EN) && (defined(SLEEP_EN) || defined(FORCE_SLEEP) || defined(BATCH_EN))
+    #error "CONTINUOUS_RX_EN requires SLEEP_EN, FORCE_SLEEP and BATCH_EN to be disabled!"
+#endif
+
+#if defined(BATCH_EN) && !defined(SLEEP_EN)
+    #error "BATCH_EN requires SLEEP_EN!"
+#endif
+
+#if defined(LIGHTNING_HISTORY_EN) && !defined(LIGHTNINGSENSOR_EN)
+    #error "LIGHTNING_HISTORY_EN requires LIGHTNINGSENSOR_EN!"
+#endif
+
 // Pin mapping for ESP32 (MCCI Arduino LoRaWAN Library)
 // Note: Pin mapping for BresserWeatherSensorReceiver is done in WeatherSensorCfg.h!
 // SPI2 is used on ESP32 per default! (e.g. see https://github.com/espressif/arduino-esp32/tree/master/variants/doitESP32devkitV1)
@@ -336,6 +487,27 @@
 // The maximum allowed for all data rates is 51 bytes.
 const uint8_t PAYLOAD_SIZE = 51;
 
+static_assert(payloadFrameSize() <= PAYLOAD_SIZE, 
+    "Uplink payload exceeds PAYLOAD_SIZE - disable some features in BresserWeatherSensorTTNCfg.h!");
+
+#ifdef PAYLOAD_COMPRESSED_EN
+// Keyframe: 1 byte header + payload
+static_assert(1 + payloadFrameSize() <= PAYLOAD_SIZE, 
+    "Compressed uplink keyframe exceeds PAYLOAD_SIZE - disable some features in BresserWeatherSensorTTNCfg.h!");
+#endif
+
+#ifdef BATCH_EN
+static_assert((BATCH_SIZE >= 1) && (BATCH_SIZE <= SAMPLE_BATCH_MAX),
+    "BATCH_SIZE out of range - see SAMPLE_BATCH_MAX in src/SampleBatch/SampleBatch.h!");
+static_assert(SAMPLE_BATCH_HDR_SIZE + SAMPLE_BATCH_MAX * SAMPLE_BATCH_REC_SIZE <= PAYLOAD_SIZE,
+    "Batch uplink exceeds PAYLOAD_SIZE!");
+#endif
+
+#ifdef LIGHTNING_HISTORY_EN
+static_assert(LGT_FRAME_SIZE <= PAYLOAD_SIZE,
+    "Lightning history uplink exceeds PAYLOAD_SIZE - see LGT_HISTORY_SIZE in src/LightningHistory/LightningHistory.h!");
+#endif
+
 // RTC Memory Handling
 #define MAGIC1 (('m' << 24) | ('g' < 16) | ('c' << 8) | '1')
 #define MAGIC2 (('m' << 24) | ('g' < 16) | ('c' << 8) | '2')
@@ -347,6 +519,8 @@ const uint8_t PAYLOAD_SIZE = 51;
 // Arduino IDE: Tools->Core Debug Level: "Debug|Verbose"
 // or
 // set CORE_DEBUG_LEVEL in BresserWeatherSensorTTNCfg.h
+// Per-subsystem levels (LoRaWAN, sensor, BLE, RTC, persistence) can be lowered
+// with LOG_LEVEL_<subsystem> (see logging.h)
 
 // Downlink messages
 // ------------------
@@ -411,6 +585,7 @@ const uint8_t PAYLOAD_SIZE = 51;
 #define CMD_SET_DATETIME                0x88
 
 void printDateTime(void);
+int64_t epochMs(void);
     
 /****************************************************************************\
 |
@@ -572,6 +747,42 @@ public:
 private:
     void doUplink();
 
+    #ifdef MULTI_SENSOR_EN
+        /*!
+         * \fn doMultiUplink
+         * 
+         * \brief Send next pending multi-sensor frame (FPort 6)
+         */
+        void doMultiUplink(void);
+    #endif
+
+    #ifdef TELEMETRY_EN
+        /*!
+         * \fn doTelemetryUplink
+         * 
+         * \brief Send diagnostic frame (FPort 7)
+         */
+        void doTelemetryUplink(void);
+    #endif
+
+    #ifdef LIGHTNING_HISTORY_EN
+        /*!
+         * \fn doLightningUplink
+         * 
+         * \brief Send lightning event history (FPort 9)
+         */
+        void doLightningUplink(void);
+    #endif
+
+    /*!
+     * \fn getSensorData
+     * 
+     * \brief Receive weather sensor data and update rain gauge/lightning statistics
+     * 
+     * \returns true if receiving weather sensor data was successful
+     */
+    bool getSensorData(void);
+
     bool m_fUplinkRequest;              //!< set true when uplink is requested
     bool m_fBusy;                       //!< set true while sending an uplink
     std::uint32_t m_uplinkPeriodMs;     //!< uplink period in milliseconds
@@ -610,6 +821,19 @@ const cMyLoRaWAN::lmic_pinmap myPinMap = {
 };
 
 
+// Attribute for variables which must retain their values after deep sleep
+// ESP32:  RTC RAM
+// RP2040: RAM section which is not initialized at startup - it has NOT been
+//         verified that the contents survive pico_sleep() and the watchdog reset
+//         used for wake-up (see prepareSleep()); they are undefined after power-on.
+//         The data must be validated (e.g. by a magic number) and its loss must be
+//         tolerated - data which must not be lost is saved to flash (Preferences)!
+#if defined(ESP32)
+    #define RETAINED_ATTR RTC_DATA_ATTR
+#else
+    #define RETAINED_ATTR __attribute__((section(".uninitialized_data.retained")))
+#endif
+
 #if !defined(SESSION_IN_PREFERENCES)
     // The following variables are stored in the ESP32's RTC RAM -
     // their value is retained after a Sleep Reset.
@@ -637,6 +861,9 @@ const cMyLoRaWAN::lmic_pinmap myPinMap = {
 /// Bresser Weather Sensor Receiver
 WeatherSensor weatherSensor;
 
+/// Sensor type -> slot index (updated after sensor data reception)
+SensorIndex sensorIndex(weatherSensor);
+
 /// ESP32 preferences (stored in flash memory)
 static Preferences preferences;
 
@@ -646,7 +873,58 @@ uint16_t  sleep_interval;       //!< preferences: sleep interval
 uint16_t  sleep_interval_long;  //!< preferences: sleep interval long
 } prefs;
 
-#ifdef RAINDATA_EN
+#ifdef PERSIST_BLOB_EN
+    #define PERSIST_VERSION_PREFS   1   //!< version of struct sPrefs
+    #define PERSIST_VERSION_SESSION 1   //!< version of SessionInfo/SessionState
+
+    /// Preferences (struct sPrefs) stored as a single blob
+    PersistStore persistPrefs(preferences, "BWS-TTN");
+
+    #if defined(SESSION_IN_PREFERENCES)
+        static_assert((sizeof(Arduino_LoRaWAN::SessionInfo) <= PERSIST_SIZE_MAX) && (sizeof(Arduino_LoRaWAN::SessionState) <= PERSIST_SIZE_MAX),
+            "LoRaWAN session data exceeds PERSIST_SIZE_MAX!");
+        
+        /// LoRaWAN session info/state stored as blobs
+        PersistStore persistSession(preferences, "BWS-TTN-S");
+
+        #define SESSION_SHADOW_MAGIC 0x53534844 //!< "SSHD"
+
+        /// Shadow of the last session state - retained across deep sleep
+        struct SessionShadowS {
+            uint32_t                      magic;        //!< validation of retained data
+            uint32_t                      fcnt_saved;   //!< FCntUp of session state in flash
+            Arduino_LoRaWAN::SessionState state;        //!< last session state
+        };
+        #if defined(ARDUINO_ARCH_RP2040)
+            // Retention of RAM during sleep has not been verified on RP2040 (see RETAINED_ATTR) -
+            // the shadow is rebuilt from flash after each wake-up, the number of uplinks since
+            // the last flash write is kept in a watchdog scratch register (like the RTC time)
+            #define SESSION_FCNT_SCRATCH    3           //!< watchdog scratch register (4..7 used by pico-sdk)
+            #define SESSION_FCNT_TAG        0x46430000  //!< "FC" - validation of scratch register
+
+            SessionShadowS sessionShadow;
+        #else
+            RETAINED_ATTR SessionShadowS sessionShadow;
+        #endif
+    #endif
+#endif
+
+#if defined(RAINDATA_EN) && defined(RAIN_HISTORY_EN)
+    /// Rain history - must be retained across deep sleep
+    RETAINED_ATTR rain_history_t rainHistory;
+
+    #if !defined(ESP32)
+        #define PERSIST_VERSION_RAIN 1  //!< version of rain_history_t
+
+        static_assert(sizeof(rain_history_t) <= PERSIST_SIZE_MAX, "rain_history_t exceeds PERSIST_SIZE_MAX!");
+
+        /// Rain history stored in flash before sleep (RAM retention is not guaranteed)
+        PersistStore persistRain(preferences, "BWS-TTN-R");
+    #endif
+
+    /// Rain data statistics 
+    RainHistory rainGauge(&rainHistory);
+#elif defined(RAINDATA_EN)
     /// Rain data statistics 
     RainGauge rainGauge;
 #endif
@@ -656,6 +934,128 @@ uint16_t  sleep_interval_long;  //!< preferences: sleep interval long
     Lightning lightningProc;
 #endif
 
+#ifdef PHASE_TIMER_EN
+    #if defined(ESP32)
+        // Stored in RTC RAM - statistics are accumulated across deep sleep cycles
+        RTC_DATA_ATTR phase_stats_t phaseStats[PHASE_NUM];
+    #else
+        // Statistics are accumulated since last reset
+        phase_stats_t phaseStats[PHASE_NUM];
+    #endif
+
+    /// Execution time measurement of uplink phases
+    PhaseTimer phaseTimer(phaseStats);
+#endif
+
+#ifdef BINLOG_EN
+    /// Binary log - retained across deep sleep, dumped on demand
+    RETAINED_ATTR binlog_state_t binLogState;
+    RETAINED_ATTR uint32_t binLogBuf[BINLOG_WORDS];
+
+    /// Deferred binary logging
+    BinLog binLog(&binLogState, binLogBuf, BINLOG_WORDS);
+#endif
+
+#ifdef ENERGY_MODEL_EN
+    /// Energy accounting state - results of last cycle must be retained across deep sleep
+    RETAINED_ATTR energy_state_t energyState;
+
+    /// Supply currents of the board
+    const uint32_t energyCurrent[ENERGY_NUM] = ENERGY_CURRENT_UA;
+
+    /// Energy accounting of wake/sleep cycles
+    EnergyModel energyModel(&energyState, energyCurrent, ENERGY_BATTERY_MAH);
+#endif
+
+#ifdef PAYLOAD_COMPRESSED_EN
+    /// Compressor state - reference frame must be retained across deep sleep
+    RETAINED_ATTR payload_delta_state_t payloadDeltaState;
+
+    /// Delta/varint compressed uplink payload encoder
+    PayloadCompressor payloadCompressor(&payloadDeltaState, PAYLOAD_KEYFRAME_INTERVAL);
+#endif
+
+#ifdef BATCH_EN
+    /// Weather sensor samples - must be retained across deep sleep
+    RETAINED_ATTR batch_state_t batchState;
+
+    /// Batching of weather sensor samples
+    SampleBatch sampleBatch(&batchState);
+#endif
+
+#ifdef CONTINUOUS_RX_EN
+    /// Radio context switch between LoRaWAN and sensor data reception
+    RadioCtx radioCtx;
+#endif
+
+#ifdef RX_POLICY_EN
+    /// Sensor arrival time history - must be retained across deep sleep
+    RETAINED_ATTR rx_history_t rxHistory;
+
+    /// Weather sensor receive policy
+    RxPolicy rxPolicy(weatherSensor, &rxHistory);
+#endif
+
+#ifdef TX_POLICY_EN
+    // Max. application payload size [bytes] by data rate (LoRaWAN Regional Parameters,
+    // without MAC commands in FOpts)
+    #if defined(CFG_us915)
+        static const uint8_t txMaxPayload[] = {11, 53, 125, 242, 242};
+    #else
+        static const uint8_t txMaxPayload[] = {51, 51, 51, 115, 242, 242, 242, 242};
+    #endif
+
+    /// Uplink acknowledgement history - must be retained across deep sleep
+    RETAINED_ATTR tx_history_t txHistory;
+
+    /// LoRaWAN uplink transmit policy
+    TxPolicy txPolicy(&txHistory, TX_CONFIRM_EVERY, TX_BACKOFF_MAX, txMaxPayload, sizeof(txMaxPayload));
+#endif
+
+/// Max. uplink payload size at the current data rate
+static uint8_t maxUplinkLen(void) {
+    #ifdef TX_POLICY_EN
+        uint8_t maxLen = txPolicy.maxPayload(LMIC.datarate);
+        return (maxLen < PAYLOAD_SIZE) ? maxLen : PAYLOAD_SIZE;
+    #else
+        return PAYLOAD_SIZE;
+    #endif
+}
+
+#ifdef TICKLESS_IDLE_EN
+    /// Low power idle until the next LMIC job or radio interrupt
+    TicklessIdle ticklessIdle(PIN_LMIC_DIO0, PIN_LMIC_DIO1, TICKLESS_MIN_MS, TICKLESS_MAX_MS, TICKLESS_GUARD_MS);
+#endif
+
+#ifdef ARRIVAL_PREDICTION_EN
+    /// Sensor arrival prediction state - must be retained across deep sleep
+    RETAINED_ATTR arrival_state_t arrivalState;
+
+    /// Sensor arrival prediction for wake-up scheduling
+    ArrivalPredictor arrivalPredictor(&arrivalState, ARRIVAL_PERIOD_MAX, ARRIVAL_LEARN_INTERVAL);
+#endif
+
+#ifdef MULTI_SENSOR_EN
+    /// Multi-sensor uplink encoder
+    MultiSensor multiSensor;
+#endif
+
+#ifdef TELEMETRY_EN
+    /// Wake cycle histograms and error counters - must be retained across deep sleep
+    RETAINED_ATTR telemetry_state_t telemetryState;
+
+    /// Wake cycle diagnostics
+    Telemetry telemetry(&telemetryState, TELEMETRY_CYCLES);
+#endif
+
+#ifdef LIGHTNING_HISTORY_EN
+    /// Lightning events - must be retained across deep sleep
+    RETAINED_ATTR lightning_history_t lightningHistoryState;
+
+    /// Lightning event history
+    LightningHistory lightningHistory(&lightningHistoryState);
+#endif
+
 #ifdef ONEWIRE_EN
     // Setup a oneWire instance to communicate with any OneWire devices (not just Maxim/Dallas temperature ICs)
     OneWire oneWire(PIN_ONEWIRE_BUS); //!< OneWire bus
@@ -682,6 +1082,15 @@ uint16_t  sleep_interval_long;  //!< preferences: sleep interval long
 #endif
 #ifdef THEENGSDECODER_EN
     BleSensors bleSensors(knownBLEAddresses);
+    #if defined(BLE_SCAN_ADAPTIVE_EN)
+        // Adaptive BLE scan state (retained across deep sleep)
+        RETAINED_ATTR ble_scan_state_t bleScanState;
+    #endif
+    #if defined(BLE_SCAN_PASSIVE_EN)
+        #define BLE_SCAN_PASSIVE true
+    #else
+        #define BLE_SCAN_PASSIVE false
+    #endif
 #endif
 
 /// LoRaWAN uplink payload buffer
@@ -756,6 +1165,13 @@ ESP32Time rtc;
 
 /// Arduino setup
 void setup() {
+    PHASE_START(PHASE_SETUP);
+    #ifdef ENERGY_MODEL_EN
+        energyModel.begin();
+    #endif
+    #ifdef BINLOG_EN
+        binLog.begin();
+    #endif
     #if defined(ARDUINO_ARCH_RP2040)
         // see pico-sdk/src/rp2_common/hardware_rtc/rtc.c
         rtc_init();
@@ -787,24 +1203,45 @@ void setup() {
     #endif
 
     // set baud rate
+    PHASE_START(PHASE_SERIAL_INIT);
     Serial.begin(115200);
-    delay(3000);
-    Serial.setDebugOutput(true);
+    #if defined(FAST_BOOT_EN)
+        #if defined(ARDUINO_ARCH_RP2040) || (defined(ARDUINO_USB_CDC_ON_BOOT) && ARDUINO_USB_CDC_ON_BOOT)
+            // USB CDC: wait for serial to be ready - or timeout if USB host has not opened the port
+            while (!Serial && (millis() < FAST_BOOT_SERIAL_TIMEOUT)) {
+                delay(10);
+            }
+        #endif
+        // UART (USB-to-serial bridge): no waiting required
+        Serial.setDebugOutput(true);
+    #else
+        delay(3000);
+        Serial.setDebugOutput(true);
 
-    // wait for serial to be ready - or timeout if USB is not connected
-    delay(500);
+        // wait for serial to be ready - or timeout if USB is not connected
+        delay(500);
+    #endif
+    PHASE_STOP(PHASE_SERIAL_INIT);
 
     #if defined(ARDUINO_ARCH_RP2040)
         log_i("Time saved: %llu", time_saved);
     #endif
+    #ifdef PERSIST_BLOB_EN
+    if (!persistPrefs.load("prefs", &prefs, sizeof(prefs), PERSIST_VERSION_PREFS)) {
+    #endif
     preferences.begin("BWS-TTN", false);
     prefs.ws_timeout = preferences.getUChar("ws_timeout", WEATHERSENSOR_TIMEOUT);
-    log_d("Preferences: weathersensor_timeout: %u s", prefs.ws_timeout);
     prefs.sleep_interval      = preferences.getUShort("sleep_int", SLEEP_INTERVAL);
-    log_d("Preferences: sleep_interval:        %u s", prefs.sleep_interval);
     prefs.sleep_interval_long = preferences.getUShort("sleep_int_long", SLEEP_INTERVAL_LONG);
-    log_d("Preferences: sleep_interval_long:   %u s", prefs.sleep_interval_long);
     preferences.end();
+    #ifdef PERSIST_BLOB_EN
+        // Convert from separate keys (or defaults)
+        persistPrefs.save("prefs", &prefs, sizeof(prefs), PERSIST_VERSION_PREFS);
+    }
+    #endif
+    log_d("Preferences: weathersensor_timeout: %u s", prefs.ws_timeout);
+    log_d("Preferences: sleep_interval:        %u s", prefs.sleep_interval);
+    log_d("Preferences: sleep_interval_long:   %u s", prefs.sleep_interval_long);
     
     sleepTimeout = sec2osticks(SLEEP_TIMEOUT_INITIAL);
 
@@ -816,7 +1253,7 @@ void setup() {
     
     // Check if clock was never synchronized or sync interval has expired 
     if ((rtcLastClockSync == 0) || ((rtc.getLocalEpoch() - rtcLastClockSync) > (CLOCK_SYNC_INTERVAL * 60))) {
-        log_i("RTC sync required");
+        logm_i(RTC, "RTC sync required");
         rtcSyncReq = true;
     }
 
@@ -824,15 +1261,64 @@ void setup() {
     myEventLog.setup();
     log_v("myEventlog.setup() - done");
 
+    #ifdef PAYLOAD_COMPRESSED_EN
+        payloadCompressor.begin();
+    #endif
+    #ifdef BATCH_EN
+        sampleBatch.begin();
+    #endif
+    #ifdef RX_POLICY_EN
+        rxPolicy.begin();
+    #endif
+    #ifdef TX_POLICY_EN
+        txPolicy.begin();
+    #endif
+    #ifdef TICKLESS_IDLE_EN
+        ticklessIdle.begin();
+    #endif
+    #ifdef ARRIVAL_PREDICTION_EN
+        arrivalPredictor.begin();
+    #endif
+    #ifdef TELEMETRY_EN
+        telemetry.begin();
+    #endif
+    #ifdef LIGHTNING_HISTORY_EN
+        lightningHistory.begin();
+    #endif
+    #if defined(RAINDATA_EN) && defined(RAIN_HISTORY_EN)
+        #if !defined(ESP32)
+            // Restore from flash - invalid data in RAM is cleared by begin()
+            persistRain.load("rain_hist", &rainHistory, sizeof(rainHistory), PERSIST_VERSION_RAIN);
+        #endif
+        rainGauge.begin();
+    #endif
+
     // set up the sensors.
-    mySensor.setup();
+    #ifdef CONTINUOUS_RX_EN
+        // Uplink (and sensor data reception) at sleep interval
+        mySensor.setup((std::uint32_t)prefs.sleep_interval * 1000);
+    #else
+        mySensor.setup();
+    #endif
     log_v("mySensor.setup() - done");
 
+    #ifdef BATCH_EN
+        // Skip LoRaWAN (join/TX/RX windows) until BATCH_SIZE samples have been collected -
+        // unless the RTC has to be synchronized to network time
+        if (!rtcSyncReq && (sampleBatch.count() < BATCH_SIZE)) {
+            log_i("Batch: %u of %u samples - skipping uplink", sampleBatch.count(), BATCH_SIZE);
+            prepareSleep();
+        }
+    #endif
+
     // set up lorawan.
+    PHASE_START(PHASE_LORAWAN_INIT);
     myLoRaWAN.setup();
+    PHASE_STOP(PHASE_LORAWAN_INIT);
     log_v("myLoRaWAN.setup() - done");
     
     mySensor.uplinkRequest();
+    PHASE_STOP(PHASE_SETUP);
 }
 
 /****************************************************************************\
@@ -841,6 +1327,22 @@ void setup() {
 |
 \****************************************************************************/
 
+/// Check if uplinks (config/status, multi-sensor frames, diagnostic frame,
+/// lightning events) are pending or in progress
+bool uplinkPending(void) {
+    bool pending = (uplinkReq != 0) || mySensor.isBusy() || myLoRaWAN.isBusy();
+    #ifdef MULTI_SENSOR_EN
+        pending = pending || multiSensor.pending();
+    #endif
+    #ifdef TELEMETRY_EN
+        pending = pending || telemetry.pending();
+    #endif
+    #ifdef LIGHTNING_HISTORY_EN
+        pending = pending || lightningHistory.pending();
+    #endif
+    return pending;
+}
+
 /// Arduino execution loop
 void loop() {
     // the order of these is arbitrary, but you must poll them all.
@@ -848,11 +1350,18 @@ void loop() {
     mySensor.loop();
     myEventLog.loop();
 
+    #ifdef BINLOG_EN
+        // Dump binary log on request (decode with scripts/binlog_decode.py)
+        if (Serial.available() && (Serial.read() == BINLOG_DUMP_CMD)) {
+            binLog.dump(Serial);
+        }
+    #endif
+
     if (uplinkReq != 0) {
       myLoRaWAN.doCfgUplink();
     }
     #ifdef SLEEP_EN
-        if (sleepReq & !rtcSyncReq) {
+        if (sleepReq && !rtcSyncReq && !uplinkPending()) {
             myLoRaWAN.Shutdown();
             prepareSleep();
         }
@@ -861,12 +1370,21 @@ void loop() {
     #ifdef FORCE_SLEEP
         if (os_getTime() > sleepTimeout) {
             runtimeExpired = true;
+            #ifdef TELEMETRY_EN
+                telemetry.sleepTimeout();
+            #endif
             myLoRaWAN.Shutdown();
             #ifdef FORCE_JOIN_AFTER_SLEEP_TIMEOUT
                 // Force join (instead of re-join)
                 #if !defined(SESSION_IN_PREFERENCES)
                     magicFlag1 = 0;
                     magicFlag2 = 0;
+                #elif defined(PERSIST_BLOB_EN)
+                    persistSession.clear();
+                    sessionShadow.magic = 0;
+                    #if defined(ARDUINO_ARCH_RP2040)
+                        watchdog_hw->scratch[SESSION_FCNT_SCRATCH] = 0;
+                    #endif
                 #else
                     preferences.begin("BWS-TTN-S");
                     preferences.clear();
@@ -877,6 +1395,13 @@ void loop() {
             prepareSleep();
         }
     #endif
+
+    #ifdef TICKLESS_IDLE_EN
+        // Nothing to do until the next LMIC job or radio interrupt
+        if ((uplinkReq == 0) && !sleepReq) {
+            ticklessIdle.idle();
+        }
+    #endif
 }
 
 /****************************************************************************\
@@ -894,22 +1419,25 @@ void ReceiveCb(
 
     (void)pCtx;        
     uplinkReq = 0;
-    log_v("Port: %d", uPort);
-    char buf[255];
-    *buf = '\0';
+    logm_v(LORAWAN, "Port: %d", uPort);
 
     if (uPort > 0) {
-        for (size_t i = 0; i < nBuffer; i++) {
-              sprintf(&buf[strlen(buf)], "%02X ", pBuffer[i]);
-        }
-        log_v("Data: %s", buf);
+        #if LOG_ENABLED(LORAWAN, ARDUHAL_LOG_LEVEL_VERBOSE)
+            char buf[255];
+            size_t len = 0;
+            *buf = '\0';
+            for (size_t i = 0; (i < nBuffer) && (len + 4 <= sizeof(buf)); i++) {
+                len += snprintf(&buf[len], sizeof(buf) - len, "%02X ", pBuffer[i]);
+            }
+            logm_v(LORAWAN, "Data: %s", buf);
+        #endif
 
         if ((pBuffer[0] == CMD_GET_DATETIME) && (nBuffer == 1)) {
-            log_d("Get date/time");
+            logm_d(LORAWAN, "Get date/time");
             uplinkReq = CMD_GET_DATETIME;
         }
         if ((pBuffer[0] == CMD_GET_CONFIG) && (nBuffer == 1)) {
-            log_d("Get config");
+            logm_d(LORAWAN, "Get config");
             uplinkReq = CMD_GET_CONFIG; 
         }
         if ((pBuffer[0] == CMD_SET_DATETIME) && (nBuffer == 5)) {
@@ -917,51 +1445,70 @@ void ReceiveCb(
             time_t set_time = pBuffer[4] | (pBuffer[3] << 8) | (pBuffer[2] << 16) | (pBuffer[1] << 24);
             rtc.setTime(set_time);
             rtcLastClockSync = rtc.getLocalEpoch();
-            #if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_DEBUG
+            #if LOG_ENABLED(RTC, ARDUHAL_LOG_LEVEL_DEBUG)
                 char tbuf[25];
                 struct tm timeinfo;
            
                 localtime_r(&set_time, &timeinfo);
                 strftime(tbuf, 25, "%Y-%m-%d %H:%M:%S", &timeinfo);
-                log_d("Set date/time: %s", tbuf);
+                logm_d(RTC, "Set date/time: %s", tbuf);
             #endif
         }
+        #ifdef PERSIST_BLOB_EN
         if ((pBuffer[0] == CMD_SET_WEATHERSENSOR_TIMEOUT) && (nBuffer == 2)) {
-            log_d("Set weathersensor_timeout: %u s", pBuffer[1]);
+            prefs.ws_timeout = pBuffer[1];
+            logm_d(LORAWAN, "Set weathersensor_timeout: %u s", prefs.ws_timeout);
+            persistPrefs.save("prefs", &prefs, sizeof(prefs), PERSIST_VERSION_PREFS);
+        }
+        if ((pBuffer[0] == CMD_SET_SLEEP_INTERVAL) && (nBuffer == 3)){
+            prefs.sleep_interval = pBuffer[2] | (pBuffer[1] << 8);
+            logm_d(LORAWAN, "Set sleep_interval: %u s", prefs.sleep_interval);
+            persistPrefs.save("prefs", &prefs, sizeof(prefs), PERSIST_VERSION_PREFS);
+        }
+        if ((pBuffer[0] == CMD_SET_SLEEP_INTERVAL_LONG) && (nBuffer == 3)){
+            prefs.sleep_interval_long = pBuffer[2] | (pBuffer[1] << 8);
+            logm_d(LORAWAN, "Set sleep_interval_long: %u s", prefs.sleep_interval_long);
+            persistPrefs.save("prefs", &prefs, sizeof(prefs), PERSIST_VERSION_PREFS);
+        }
+        #else
+        if ((pBuffer[0] == CMD_SET_WEATHERSENSOR_TIMEOUT) && (nBuffer == 2)) {
+            logm_d(LORAWAN, "Set weathersensor_timeout: %u s", pBuffer[1]);
             preferences.begin("BWS-TTN", false);
             preferences.putUChar("ws_timeout", pBuffer[1]);
             preferences.end();
         }
         if ((pBuffer[0] == CMD_SET_SLEEP_INTERVAL) && (nBuffer == 3)){
             prefs.sleep_interval = pBuffer[2] | (pBuffer[1] << 8);
-            log_d("Set sleep_interval: %u s", prefs.sleep_interval);
+            logm_d(LORAWAN, "Set sleep_interval: %u s", prefs.sleep_interval);
             preferences.begin("BWS-TTN", false);
             preferences.putUShort("sleep_int", prefs.sleep_interval);
             preferences.end();            
         }
         if ((pBuffer[0] == CMD_SET_SLEEP_INTERVAL_LONG) && (nBuffer == 3)){
             prefs.sleep_interval_long = pBuffer[2] | (pBuffer[1] << 8);
-            log_d("Set sleep_interval_long: %u s", prefs.sleep_interval_long);
+            logm_d(LORAWAN, "Set sleep_interval_long: %u s", prefs.sleep_interval_long);
             preferences.begin("BWS-TTN", false);
             preferences.putUShort("sleep_int_long", prefs.sleep_interval_long);
             preferences.end();            
         }
+        #endif
         #ifdef RAINDATA_EN
             if (pBuffer[0] == CMD_RESET_RAINGAUGE) {
                 if (nBuffer == 1) {
-                    log_d("Reset raingauge");
+                    logm_d(LORAWAN, "Reset raingauge");
                     rainGauge.reset();
                 }
                 else if (nBuffer == 2) {
-                    log_d("Reset raingauge - flags: 0x%X", pBuffer[1]);
+                    logm_d(LORAWAN, "Reset raingauge - flags: 0x%X", pBuffer[1]);
                     rainGauge.reset(pBuffer[1] & 0xF);
                 }
             }
         #endif
     }
-    if (uplinkReq == 0) {
-        sleepReq = true;
-    }
+    // Sleep is entered in loop() after all pending uplinks have been sent
+    // (see uplinkPending()) - this callback is invoked before the uplink's
+    // completion callback
+    sleepReq = true;
 }
 
 // our setup routine does the class setup and then registers an event handler so
@@ -983,6 +1530,11 @@ cMyLoRaWAN::setup() {
         [](void *pClientInfo, uint32_t event) -> void {
             auto const pThis = (cMyLoRaWAN *)pClientInfo;
 
+            #ifdef TELEMETRY_EN
+                if ((event == EV_TXSTART) && (LMIC.opmode & OP_JOINING)) {
+                    telemetry.joinAttempt();
+                }
+            #endif
             // for tx start, we quickly capture the channel and the RPS
             if (event == EV_TXSTART) {
                 // use another lambda to make log prints easy
@@ -993,25 +1545,44 @@ cMyLoRaWAN::setup() {
                     0,
                     // the print-out function
                     [](cEventLog::EventNode_t const *pEvent) -> void {
-                        #if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_INFO
+                        #if LOG_ENABLED(LORAWAN, ARDUHAL_LOG_LEVEL_INFO)
                             //rps_t _rps = rps_t(pEvent->getData(1));
                             //Serial.printf("rps (1): %02X\n", _rps);
                             uint8_t rps = pEvent->getData(1);
                             uint32_t tstamp = osticks2ms(pEvent->getTime());
+
+                            // see MCCI_Arduino_LoRaWAN_Library/src/lib/arduino_lorawan_cEventLog.cpp
+                            log_i("TX @%lu ms: ch=%d rps=0x%02x (%s %s %s %s IH=%d)", 
+                                tstamp,
+                                std::uint8_t(pEvent->getData(0)),
+                                rps,
+                                myEventLog.getSfName(rps),
+                                myEventLog.getBwName(rps),
+                                myEventLog.getCrName(rps),
+                                myEventLog.getCrcName(rps),
+                                unsigned(getIh(rps)));
+                        #else
+                            (void)pEvent;
                         #endif
-                        // see MCCI_Arduino_LoRaWAN_Library/src/lib/arduino_lorawan_cEventLog.cpp
-                        log_i("TX @%lu ms: ch=%d rps=0x%02x (%s %s %s %s IH=%d)", 
-                            tstamp,
-                            std::uint8_t(pEvent->getData(0)),
-                            rps,
-                            myEventLog.getSfName(rps),
-                            myEventLog.getBwName(rps),
-                            myEventLog.getCrName(rps),
-                            myEventLog.getCrcName(rps),
-                            unsigned(getIh(rps)));      
                     }
                 );
+                // time-on-air of join request or data frame
+                ENERGY_ADD(ENERGY_TX, osticks2us(calcAirTime(LMIC.rps, LMIC.dataLen)));
+            }
+            #ifdef ENERGY_MODEL_EN
+            else if (event == EV_RXSTART) {
+                // receive window: min. LMIC.rxsyms symbols, 2^SF / 125 kHz each (w/o received frame)
+                if (getSf(LMIC.rps) != FSK) {
+                    ENERGY_ADD(ENERGY_RX, (uint32_t)LMIC.rxsyms << (getSf(LMIC.rps) + 6 + 3));
+                }
+            }
+            else if (event == EV_JOINING) {
+                ENERGY_START(ENERGY_JOIN);
+            }
+            else if (event == EV_JOINED) {
+                ENERGY_STOP(ENERGY_JOIN);
             }
+            #endif
             // else if (event == some other), record with print-out function
             else {
                 // do nothing.
@@ -1043,7 +1614,7 @@ cMyLoRaWAN::GetOtaaProvisioningInfo(
 void
 cMyLoRaWAN::NetJoin(
     void) {
-    log_v("-");
+    logm_v(LORAWAN, "-");
     sleepTimeout = os_getTime() + sec2osticks(SLEEP_TIMEOUT_JOINED);
     if (rtcSyncReq) {
         // Allow additional time for completing Network Time Request
@@ -1054,53 +1625,55 @@ cMyLoRaWAN::NetJoin(
 // This method is called after transmission has been completed.
 void
 cMyLoRaWAN::NetTxComplete(void) {
-    log_v("-");
+    logm_v(LORAWAN, "-");
 }
 
 // Print session info for debugging
 void 
 cMyLoRaWAN::printSessionInfo(const SessionInfo &Info)
 {
-    log_v("Tag:\t\t%d", Info.V1.Tag);
-    log_v("Size:\t\t%d", Info.V1.Size);
-    log_v("Rsv2:\t\t%d", Info.V1.Rsv2);
-    log_v("Rsv3:\t\t%d", Info.V1.Rsv3);
-    log_v("NetID:\t\t0x%08X", Info.V1.NetID);
-    log_v("DevAddr:\t\t0x%08X", Info.V1.DevAddr);
-    if (CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_DEBUG) {
+    logm_v(LORAWAN, "Tag:\t\t%d", Info.V1.Tag);
+    logm_v(LORAWAN, "Size:\t\t%d", Info.V1.Size);
+    logm_v(LORAWAN, "Rsv2:\t\t%d", Info.V1.Rsv2);
+    logm_v(LORAWAN, "Rsv3:\t\t%d", Info.V1.Rsv3);
+    logm_v(LORAWAN, "NetID:\t\t0x%08X", Info.V1.NetID);
+    logm_v(LORAWAN, "DevAddr:\t\t0x%08X", Info.V1.DevAddr);
+    #if LOG_ENABLED(LORAWAN, ARDUHAL_LOG_LEVEL_VERBOSE)
+    {
         char buf[64];
         *buf = '\0';
         for (int i=0; i<15;i++) {
-            sprintf(&buf[strlen(buf)], "%02X ", Info.V1.NwkSKey[i]);
+            sprintf(&buf[3 * i], "%02X ", Info.V1.NwkSKey[i]);
         }
         log_v("NwkSKey:\t\t%s", buf);
     }
-    if (CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_DEBUG) {
+    {
         char buf[64];
         *buf = '\0';
         for (int i=0; i<15;i++) {
-            sprintf(&buf[strlen(buf)], "%02X ", Info.V1.AppSKey[i]);  
+            sprintf(&buf[3 * i], "%02X ", Info.V1.AppSKey[i]);  
         }
         log_v("AppSKey:\t\t%s", buf);
-    }    
+    }
+    #endif
 }
 
 // Print session state for debugging
 void
 cMyLoRaWAN::printSessionState(const SessionState &State)
 {
-    log_v("Tag:\t\t%d", State.V1.Tag);
-    log_v("Size:\t\t%d", State.V1.Size);
-    log_v("Region:\t\t%d", State.V1.Region);
-    log_v("LinkDR:\t\t%d", State.V1.LinkDR);
-    log_v("FCntUp:\t\t%d", State.V1.FCntUp);
-    log_v("FCntDown:\t\t%d", State.V1.FCntDown);
-    log_v("gpsTime:\t\t%d", State.V1.gpsTime);
-    log_v("globalAvail:\t%d", State.V1.globalAvail);
-    log_v("Rx2Frequency:\t%d", State.V1.Rx2Frequency);
-    log_v("PingFrequency:\t%d", State.V1.PingFrequency);
-    log_v("Country:\t\t%d", State.V1.Country);
-    log_v("LinkIntegrity:\t%d", State.V1.LinkIntegrity);
+    logm_v(LORAWAN, "Tag:\t\t%d", State.V1.Tag);
+    logm_v(LORAWAN, "Size:\t\t%d", State.V1.Size);
+    logm_v(LORAWAN, "Region:\t\t%d", State.V1.Region);
+    logm_v(LORAWAN, "LinkDR:\t\t%d", State.V1.LinkDR);
+    logm_v(LORAWAN, "FCntUp:\t\t%d", State.V1.FCntUp);
+    logm_v(LORAWAN, "FCntDown:\t\t%d", State.V1.FCntDown);
+    logm_v(LORAWAN, "gpsTime:\t\t%d", State.V1.gpsTime);
+    logm_v(LORAWAN, "globalAvail:\t%d", State.V1.globalAvail);
+    logm_v(LORAWAN, "Rx2Frequency:\t%d", State.V1.Rx2Frequency);
+    logm_v(LORAWAN, "PingFrequency:\t%d", State.V1.PingFrequency);
+    logm_v(LORAWAN, "Country:\t\t%d", State.V1.Country);
+    logm_v(LORAWAN, "LinkIntegrity:\t%d", State.V1.LinkIntegrity);
     // There is more in it...
 }
 
@@ -1121,7 +1694,20 @@ cMyLoRaWAN::printSessionState(const SessionState &State)
         rtcSavedNExtraInfo = nExtraInfo;
         memcpy(rtcSavedExtraInfo, pExtraInfo, nExtraInfo);
         magicFlag2 = MAGIC2;
-        log_v("-");
+        logm_v(PERSIST, "-");
+        printSessionInfo(Info);
+    }
+#elif defined(PERSIST_BLOB_EN)
+    void
+    cMyLoRaWAN::NetSaveSessionInfo(
+        const SessionInfo &Info,
+        const uint8_t *pExtraInfo,
+        size_t nExtraInfo
+    ) {
+        (void)pExtraInfo;
+        (void)nExtraInfo;
+        persistSession.save("info", &Info, sizeof(Info), PERSIST_VERSION_SESSION);
+        logm_v(PERSIST, "-");
         printSessionInfo(Info);
     }
 #else
@@ -1143,7 +1729,7 @@ cMyLoRaWAN::printSessionState(const SessionState &State)
         (void)nExtraInfo;
         // TODO: Save ExtraInfo?
         preferences.end();
-        log_v("-");
+        logm_v(PERSIST, "-");
         printSessionInfo(Info);
     }
 #endif
@@ -1157,9 +1743,34 @@ cMyLoRaWAN::printSessionState(const SessionState &State)
     cMyLoRaWAN::NetSaveSessionState(const SessionState &State) {
         rtcSavedSessionState = State;
         magicFlag1 = MAGIC1;
-        log_v("-");
+        logm_v(PERSIST, "-");
         printSessionState(State);
     }
+#elif defined(PERSIST_BLOB_EN)
+    void
+    cMyLoRaWAN::NetSaveSessionState(const SessionState &State) {
+        // Compare to shadow without frame counters
+        SessionState cmp = State;
+        bool valid = (sessionShadow.magic == SESSION_SHADOW_MAGIC);
+        if (valid) {
+            cmp.V1.FCntUp   = sessionShadow.state.V1.FCntUp;
+            cmp.V1.FCntDown = sessionShadow.state.V1.FCntDown;
+        }
+
+        // Write to flash only if any other member changed or every SESSION_FCNT_INTERVAL uplinks
+        if (!valid || (memcmp(&cmp, &sessionShadow.state, sizeof(cmp)) != 0) ||
+            (State.V1.FCntUp - sessionShadow.fcnt_saved >= SESSION_FCNT_INTERVAL)) {
+            persistSession.save("state", &State, sizeof(State), PERSIST_VERSION_SESSION);
+            sessionShadow.fcnt_saved = State.V1.FCntUp;
+        } else {
+            logm_v(PERSIST, "FCntUp: %u (saved: %u)", (unsigned)State.V1.FCntUp, (unsigned)sessionShadow.fcnt_saved);
+        }
+        sessionShadow.state = State;
+        sessionShadow.magic = SESSION_SHADOW_MAGIC;
+        #if defined(ARDUINO_ARCH_RP2040)
+            watchdog_hw->scratch[SESSION_FCNT_SCRATCH] = SESSION_FCNT_TAG | ((State.V1.FCntUp - sessionShadow.fcnt_saved) & 0xFFFF);
+        #endif
+    }
 #else
     void
     cMyLoRaWAN::NetSaveSessionState(const SessionState &State) {
@@ -1203,20 +1814,51 @@ cMyLoRaWAN::printSessionState(const SessionState &State)
     cMyLoRaWAN::NetGetSessionState(SessionState &State) {
         if (magicFlag1 == MAGIC1) {
             State = rtcSavedSessionState;
-            log_d("o.k.");
+            logm_d(PERSIST, "o.k.");
             printSessionState(State);
             return true;
         } else {
-            log_d("failed");
+            logm_d(PERSIST, "failed");
             return false;
         }
     }
+#elif defined(PERSIST_BLOB_EN)
+    bool
+    cMyLoRaWAN::NetGetSessionState(SessionState &State) {
+        if (sessionShadow.magic == SESSION_SHADOW_MAGIC) {
+            // Exact frame counters from retained RAM
+            State = sessionShadow.state;
+            printSessionState(State);
+            return true;
+        }
+        if (!persistSession.load("state", &State, sizeof(State), PERSIST_VERSION_SESSION)) {
+            logm_d(PERSIST, "failed");
+            return false;
+        }
+        // The frame counter in flash may be behind by less than SESSION_FCNT_INTERVAL uplinks
+        sessionShadow.fcnt_saved = State.V1.FCntUp;
+        #if defined(ARDUINO_ARCH_RP2040)
+            uint32_t fcnt_scratch = watchdog_hw->scratch[SESSION_FCNT_SCRATCH];
+            if (((fcnt_scratch & 0xFFFF0000) == SESSION_FCNT_TAG) && ((fcnt_scratch & 0xFFFF) < SESSION_FCNT_INTERVAL)) {
+                // Exact frame counter - uplinks since last flash write
+                State.V1.FCntUp += fcnt_scratch & 0xFFFF;
+            } else {
+                State.V1.FCntUp += SESSION_FCNT_INTERVAL;
+            }
+        #else
+            State.V1.FCntUp += SESSION_FCNT_INTERVAL;
+        #endif
+        sessionShadow.state = State;
+        sessionShadow.magic = SESSION_SHADOW_MAGIC;
+        printSessionState(State);
+        return true;
+    }
 #else
     bool
     cMyLoRaWAN::NetGetSessionState(SessionState &State) {
         
         if (false == preferences.begin("BWS-TTN-S")) {
-            log_d("failed");
+            logm_d(PERSIST, "failed");
             return false;
         }
         // All members are saved separately, because most of them will not change frequently
@@ -1278,6 +1920,27 @@ cMyLoRaWAN::GetAbpProvisioningInfo(AbpProvisioningInfo *pAbpInfo) {
         pAbpInfo->NetID   = rtcSavedSessionInfo.V2.NetID;
         memcpy(pAbpInfo->NwkSKey, rtcSavedSessionInfo.V2.NwkSKey, 16);
         memcpy(pAbpInfo->AppSKey, rtcSavedSessionInfo.V2.AppSKey, 16);
+    #elif defined(PERSIST_BLOB_EN)
+        SessionInfo info;
+
+        #if defined(ARDUINO_ARCH_RP2040)
+            if (!watchdog_caused_reboot()) {
+                // Last reset was not caused by the watchdog - see below
+                logm_d(PERSIST, "HW reset detected, deleting session info.");
+                persistSession.clear();
+                sessionShadow.magic = 0;
+                watchdog_hw->scratch[SESSION_FCNT_SCRATCH] = 0;
+            }
+        #endif
+        if (!persistSession.load("info", &info, sizeof(info), PERSIST_VERSION_SESSION)) {
+            logm_d(PERSIST, "failed");
+            return false;
+        }
+        logm_v(PERSIST, "-");
+        pAbpInfo->DevAddr = info.V2.DevAddr;
+        pAbpInfo->NetID   = info.V2.NetID;
+        memcpy(pAbpInfo->NwkSKey, info.V2.NwkSKey, 16);
+        memcpy(pAbpInfo->AppSKey, info.V2.AppSKey, 16);
     #else
         if (false == preferences.begin("BWS-TTN-S")) {
             log_d("failed");
@@ -1306,27 +1969,30 @@ cMyLoRaWAN::GetAbpProvisioningInfo(AbpProvisioningInfo *pAbpInfo) {
     pAbpInfo->FCntUp   = state.V1.FCntUp;
     pAbpInfo->FCntDown = state.V1.FCntDown;
 
-    if (CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_DEBUG) {
+    #if LOG_ENABLED(LORAWAN, ARDUHAL_LOG_LEVEL_VERBOSE)
+    {
         char buf[64];
         
         *buf = '\0';
         for (int i=0; i<15;i++) {
-          sprintf(&buf[strlen(buf)], "%02X ", pAbpInfo->NwkSKey[i]);  
+          sprintf(&buf[3 * i], "%02X ", pAbpInfo->NwkSKey[i]);  
         }
         log_v("NwkSKey:\t%s", buf);
         
         *buf = '\0';
         for (int i=0; i<15;i++) {
-          sprintf(&buf[strlen(buf)], "%02X ", pAbpInfo->AppSKey[i]);  
+          sprintf(&buf[3 * i], "%02X ", pAbpInfo->AppSKey[i]);  
         }
         log_v("AppSKey:\t%s", buf);
         log_v("FCntUp:\t%d", state.V1.FCntUp);
     }
+    #endif
     return true;
 }
 
 /// Print date and time (i.e. local time)
 void printDateTime(void) {
+    #if LOG_ENABLED(RTC, ARDUHAL_LOG_LEVEL_INFO)
         struct tm timeinfo;
         char tbuf[25];
         
@@ -1334,17 +2000,28 @@ void printDateTime(void) {
         localtime_r(&tnow, &timeinfo);
         strftime(tbuf, 25, "%Y-%m-%d %H:%M:%S", &timeinfo);
         log_i("%s", tbuf);
+    #endif
+}
+
+/// Get time in milliseconds since the epoch
+int64_t epochMs(void) {
+    return (int64_t)rtc.getLocalEpoch() * 1000 + rtc.getMillis();
 }
 
 /// Determine sleep duration and enter Deep Sleep Mode
 void prepareSleep(void) {
-    // FIXME 
-    // Workaround for
-    // https://github.com/matthias-bs/BresserWeatherSensorTTN/issues/81
-    //uint32_t sleep_interval = (uint32_t)prefs.sleep_interval;
-    preferences.begin("BWS-TTN", false);
-    uint32_t sleep_interval = preferences.getUShort("sleep_int", SLEEP_INTERVAL);
-    preferences.end();
+    #ifdef PERSIST_BLOB_EN
+        // The preferences blob is updated together with prefs (see ReceiveCb())
+        uint32_t sleep_interval = (uint32_t)prefs.sleep_interval;
+    #else
+        // FIXME 
+        // Workaround for
+        // https://github.com/matthias-bs/BresserWeatherSensorTTN/issues/81
+        //uint32_t sleep_interval = (uint32_t)prefs.sleep_interval;
+        preferences.begin("BWS-TTN", false);
+        uint32_t sleep_interval = preferences.getUShort("sleep_int", SLEEP_INTERVAL);
+        preferences.end();
+    #endif
     longSleep = false;
     #ifdef ADC_EN
         // Long sleep interval if battery is weak
@@ -1353,6 +2030,14 @@ void prepareSleep(void) {
             longSleep = true;
         }
     #endif
+    #ifdef TICKLESS_IDLE_EN
+        log_d("Tickless idle: %u ms", (unsigned)ticklessIdle.idleMs());
+    #endif
+    #ifdef TX_POLICY_EN
+        // Extend sleep interval while uplinks are not acknowledged (poor link)
+        txPolicy.print();
+        sleep_interval *= txPolicy.sleepFactor();
+    #endif
 
     // If the real time is available, align the wake-up time to the
     // to next non-fractional multiple of sleep_interval past the hour
@@ -1364,11 +2049,46 @@ void prepareSleep(void) {
         sleep_interval = sleep_interval - ((timeinfo.tm_min * 60) % sleep_interval + timeinfo.tm_sec);  
     }
     
+    #ifdef ARRIVAL_PREDICTION_EN
+        // Wake up shortly before the expected weather sensor transmission
+        // closest to the aligned wake-up time
+        if (arrivalPredictor.periodValid()) {
+            int64_t t_now_ms  = epochMs();
+            int64_t target_ms = t_now_ms - (t_now_ms % 1000) + (int64_t)sleep_interval * 1000;
+            int64_t sleep_ms  = arrivalPredictor.wakeTime(target_ms, ARRIVAL_GUARD_MS) - t_now_ms;
+            if (sleep_ms > 0) {
+                log_i("Shutdown() - sleeping for %u ms (predicted)", (unsigned)sleep_ms);
+                #if defined(ESP32)
+                    #ifdef ENERGY_MODEL_EN
+                        energyModel.finish(sleep_ms);
+                    #endif
+                    #ifdef TELEMETRY_EN
+                        telemetry.endCycle(millis());
+                    #endif
+                    // No extra sleep time required - the wake-up delay is learned by arrivalPredictor
+                    ESP.deepSleep(sleep_ms * 1000LL);
+                #else
+                    sleep_interval = sleep_ms / 1000;
+                #endif
+            }
+        }
+    #endif
+
     log_i("Shutdown() - sleeping for %u s", (unsigned int)sleep_interval);
+    #ifdef TELEMETRY_EN
+        telemetry.endCycle(millis());
+    #endif
+    #ifdef ENERGY_MODEL_EN
+        energyModel.finish(sleep_interval * 1000);
+    #endif
     #if defined(ESP32)
         sleep_interval += 20; // Added extra 20-secs of sleep to allow for slow ESP32 RTC timers
         ESP.deepSleep(sleep_interval * 1000000LL);
     #else
+        #if defined(RAINDATA_EN) && defined(RAIN_HISTORY_EN)
+            // Skipped if unchanged
+            persistRain.save("rain_hist", &rainHistory, sizeof(rainHistory), PERSIST_VERSION_RAIN);
+        #endif
         time_t t_now = rtc.getLocalEpoch();
         datetime_t dt;
         epoch_to_datetime(&t_now, &dt);
@@ -1423,7 +2143,7 @@ void UserRequestNetworkTimeCb(void *pVoidUserUTCTime, int flagSuccess) {
 
     if (flagSuccess != 1) {
         // Most likely the service is not provided by the gateway. No sense in trying again...
-        log_i("Request network time didn't succeed");
+        logm_i(RTC, "Request network time didn't succeed");
         rtcSyncReq = false;
         return;
     }
@@ -1431,7 +2151,7 @@ void UserRequestNetworkTimeCb(void *pVoidUserUTCTime, int flagSuccess) {
     // Populate "lmic_time_reference"
     flagSuccess = LMIC_getNetworkTimeReference(&lmicTimeReference);
     if (flagSuccess != 1) {
-        log_i("LMIC_getNetworkTimeReference didn't succeed");
+        logm_i(RTC, "LMIC_getNetworkTimeReference didn't succeed");
         return;
     }
 
@@ -1455,7 +2175,7 @@ void UserRequestNetworkTimeCb(void *pVoidUserUTCTime, int flagSuccess) {
     // Save clock sync timestamp and clear flag 
     rtcLastClockSync = rtc.getLocalEpoch();
     rtcSyncReq = false;
-    log_d("RTC sync completed");
+    logm_d(RTC, "RTC sync completed");
     printDateTime();
 }
 
@@ -1469,20 +2189,24 @@ void
 cMyLoRaWAN::doCfgUplink(void) {
     // if busy uplinking, just skip
     if (this->m_fBusy || mySensor.isBusy()) {
-        //log_d("busy");
+        //logm_d(LORAWAN, "busy");
         return;
     }
     // if LMIC is busy, just skip
     //if (LMIC.opmode & (OP_POLL | OP_TXDATA | OP_TXRXPEND)) {
-    //    log_v("LMIC.opmode: 0x%02X", LMIC.opmode);
+    //    logm_v(LORAWAN, "LMIC.opmode: 0x%02X", LMIC.opmode);
     //    return;
     //}
     if (!GetTxReady())
         return;
 
-    log_d("--- Uplink Configuration/Status ---");
+    logm_d(LORAWAN, "--- Uplink Configuration/Status ---");
     
-    uint8_t uplink_payload[5];
+    #ifdef ENERGY_MODEL_EN
+        uint8_t uplink_payload[5 + ENERGY_SUMMARY_SIZE];
+    #else
+        uint8_t uplink_payload[5];
+    #endif
     uint8_t port;
 
     //
@@ -1491,7 +2215,7 @@ cMyLoRaWAN::doCfgUplink(void) {
     LoraEncoder encoder(uplink_payload);
 
     if (uplinkReq == CMD_GET_DATETIME) {
-        log_d("Date/Time");
+        logm_d(LORAWAN, "Date/Time");
         port = 2;
         time_t t_now = rtc.getLocalEpoch();
         encoder.writeUint8((t_now >> 24) & 0xff);
@@ -1512,26 +2236,39 @@ cMyLoRaWAN::doCfgUplink(void) {
         // TODO add flags for succesful LORA time sync/manual sync
         encoder.writeUint8((rtcSyncReq) ? 0x03 : 0x02);
     } else if (uplinkReq) {
-        log_d("Config");
+        logm_d(LORAWAN, "Config");
         port = 3;
         encoder.writeUint8(prefs.ws_timeout);
         encoder.writeUint8(prefs.sleep_interval >> 8);
         encoder.writeUint8(prefs.sleep_interval & 0xFF);
         encoder.writeUint8(prefs.sleep_interval_long >> 8);
         encoder.writeUint8(prefs.sleep_interval_long & 0xFF);
+        #ifdef ENERGY_MODEL_EN
+            // Energy summary of last cycle(s)
+            uint8_t summary[ENERGY_SUMMARY_SIZE];
+            energyModel.encode(summary);
+            for (int i=0; i < ENERGY_SUMMARY_SIZE; i++) {
+                encoder.writeUint8(summary[i]);
+            }
+        #endif
     } else {
-      log_v("");
+      logm_v(LORAWAN, "");
         return;
     }
 
     this->m_fBusy = true;
-    log_v("Trying SendBuffer: port=%d, size=%d", port, encoder.getLength());
+    logm_v(LORAWAN, "Trying SendBuffer: port=%d, size=%d", port, encoder.getLength());
+
+    #if LOG_ENABLED(LORAWAN, ARDUHAL_LOG_LEVEL_DEBUG)
+        char buf[3 * sizeof(uplink_payload) + 1];
+        size_t len = 0;
+        *buf = '\0';
+        for (int i = 0; (i < encoder.getLength()) && (len + 4 <= sizeof(buf)); i++) {
+            len += snprintf(&buf[len], sizeof(buf) - len, "%02X ", uplink_payload[i]);
+        }
+        logm_d(LORAWAN, "Data: %s", buf);
+    #endif
 
-    for (int i=0; i<encoder.getLength(); i++) {
-      Serial.printf("%02X ", uplink_payload[i]);
-    }
-    Serial.println();
-    
     // Schedule transmission
     if (! this->SendBuffer(
         uplink_payload,
@@ -1542,7 +2279,7 @@ cMyLoRaWAN::doCfgUplink(void) {
             auto const pThis = (cMyLoRaWAN *)pClientData;
             pThis->m_fBusy = false;
             uplinkReq = 0;
-            log_v("Sending successful");
+            logm_v(LORAWAN, "Sending successful");
         },
         (void *)this,
         /* confirmed */ true,
@@ -1552,7 +2289,7 @@ cMyLoRaWAN::doCfgUplink(void) {
         // be called. Reset busy flag.
         this->m_fBusy = false;
         uplinkReq = 0;
-        log_v("Sending failed");
+        logm_v(LORAWAN, "Sending failed");
     }
 }
 
@@ -1590,30 +2327,126 @@ cSensor::setup(std::uint32_t uplinkPeriodMs) {
         #endif
         
         if (getVoltage() <= BATTERY_LOW) {
-          log_i("Battery low!");
+          logm_i(SENSOR, "Battery low!");
           prepareSleep();
         }
     #endif
     
-    #if defined(MITHERMOMETER_EN) || defined(THEENGSDECODER_EN)
+    #if defined(THEENGSDECODER_EN) && defined(BLE_SCAN_ADAPTIVE_EN)
+        bleSensors.begin(&bleScanState, BLE_SCAN_PASSIVE);
+    #elif defined(THEENGSDECODER_EN) && defined(BLE_SCAN_PASSIVE_EN)
+        bleSensors.begin(nullptr, true);
+    #elif defined(MITHERMOMETER_EN) || defined(THEENGSDECODER_EN)
         bleSensors.begin();
     #endif
+    #if defined(FAST_BOOT_EN) && defined(THEENGSDECODER_EN)
+        // Run BLE scan concurrently with weather sensor data reception
+        bleSensors.resetData();
+        ENERGY_START(ENERGY_BLE_SCAN);
+        bleSensors.startScan(BLE_SCAN_TIME);
+    #endif
     
+    #ifdef WEATHERSENSOR_DATA_REQUIRED
+        if (!getSensorData()) {
+            prepareSleep();
+        }
+    #else
+        getSensorData();
+    #endif
+}
+
+
+#if defined(ARRIVAL_PREDICTION_EN)
+/// Time of first weather sensor message in current reception [ms since epoch] (0: none)
+static int64_t wsArrivalMs;
+
+/// Receive loop callback - timestamps the weather sensor message when it is decoded
+static void wsArrivalCb(void) {
+    if ((wsArrivalMs == 0) && ((weatherSensor.findType(SENSOR_TYPE_WEATHER0) > -1) ||
+                               (weatherSensor.findType(SENSOR_TYPE_WEATHER1) > -1))) {
+        wsArrivalMs = epochMs();
+    }
+}
+    #define WS_ARRIVAL_CB wsArrivalCb
+#else
+    #define WS_ARRIVAL_CB NULL
+#endif
+
+bool
+cSensor::getSensorData(void) {
+    #ifdef ARRIVAL_PREDICTION_EN
+        arrivalPredictor.rxStart(epochMs());
+        wsArrivalMs = 0;
+    #endif
+
+    PHASE_START(PHASE_SENSOR_RX);
+    ENERGY_START(ENERGY_SENSOR_RX);
+    #ifdef TELEMETRY_EN
+        uint32_t t_rx = millis();
+    #endif
     #ifndef LORAWAN_DEBUG
         weatherSensor.begin();
         weatherSensor.clearSlots();
-        //bool decode_ok = weatherSensor.getData(prefs.ws_timeout * 1000, DATA_TYPE | DATA_COMPLETE, SENSOR_TYPE_WEATHER1);
-        bool decode_ok = weatherSensor.getData(prefs.ws_timeout * 1000, DATA_ALL_SLOTS);
+        #ifdef RX_POLICY_EN
+            // Stop as soon as the required sensors have been received
+            uint8_t rx_status = rxPolicy.receive(RX_REQUIRED, prefs.ws_timeout * 1000, WS_ARRIVAL_CB);
+            bool decode_ok = (rx_status & (RX_REQUIRED)) == (RX_REQUIRED);
+            logm_d(SENSOR, "Receive status: 0x%02X", rx_status);
+        #else
+            //bool decode_ok = weatherSensor.getData(prefs.ws_timeout * 1000, DATA_TYPE | DATA_COMPLETE, SENSOR_TYPE_WEATHER1);
+            bool decode_ok = weatherSensor.getData(prefs.ws_timeout * 1000, DATA_ALL_SLOTS, 0, WS_ARRIVAL_CB);
+        #endif
     #else
         bool decode_ok = weatherSensor.genMessage(0 /* slot */, 0x01234567 /* ID */, 1 /* type */, 0 /* channel */);
     #endif
+    ENERGY_STOP(ENERGY_SENSOR_RX);
+    PHASE_STOP(PHASE_SENSOR_RX);
+    #ifdef TELEMETRY_EN
+        telemetry.sample(TLM_SENSOR_RX, millis() - t_rx);
+    #endif
+
+    // All following lookups refer to this snapshot of the sensor data slots
+    sensorIndex.build();
+
+    #if defined(ARRIVAL_PREDICTION_EN) && !defined(LORAWAN_DEBUG)
+    {
+        if (wsArrivalMs != 0) {
+            // Time of weather sensor message - reception may have continued for other sensors
+            arrivalPredictor.arrival(wsArrivalMs);
+
+            if (arrivalPredictor.measure()) {
+                // Measure transmission period between two consecutive weather sensor messages
+                // (up to 2 x ARRIVAL_PERIOD_MAX of extra reception) - the message above is not
+                // necessarily the latest one; then restore the data received before
+                auto sensorData = weatherSensor.sensor;
+                uint32_t t_start = millis();
+                int received = 0;
+                arrivalPredictor.restart();
+                weatherSensor.clearSlots();
+                while ((millis() - t_start) < ARRIVAL_PERIOD_MAX) {
+                    if (weatherSensor.getMessage() == DECODE_OK) {
+                        sensorIndex.build();
+                        int ws = sensorIndex.weather();
+                        if ((ws > -1) && weatherSensor.sensor[ws].valid) {
+                            arrivalPredictor.arrival(epochMs());
+                            if (++received == 2) {
+                                break;
+                            }
+                            weatherSensor.clearSlots();
+                            t_start = millis();
+                        }
+                    }
+                }
+                weatherSensor.sensor = sensorData;
+                sensorIndex.build();
+            }
+        }
+    }
+    #endif
     if (decode_ok) {
-        log_i("Receiving Weather Sensor Data o.k.");
+        logm_i(SENSOR, "Receiving Weather Sensor Data o.k.");
     } else {
-        log_i("Receiving Weather Sensor Data failed.");
-        #ifdef WEATHERSENSOR_DATA_REQUIRED
-            prepareSleep();
-        #endif
+        logm_i(SENSOR, "Receiving Weather Sensor Data failed.");
     }
     
     #ifdef RAINDATA_EN
@@ -1626,13 +2459,13 @@ cSensor::setup(std::uint32_t uplinkPeriodMs) {
 
             // Find weather sensor and determine rain gauge overflow limit
             // Try to find SENSOR_TYPE_WEATHER0
-            int ws = weatherSensor.findType(SENSOR_TYPE_WEATHER0);
+            int ws = sensorIndex.find(SENSOR_TYPE_WEATHER0);
             if (ws > -1) {
                 rainGauge.set_max(1000);
             }
             else {
                 // Try to find SENSOR_TYPE_WEATHER1
-                ws = weatherSensor.findType(SENSOR_TYPE_WEATHER1);
+                ws = sensorIndex.find(SENSOR_TYPE_WEATHER1);
                 rainGauge.set_max(100000);
             }
 
@@ -1650,14 +2483,41 @@ cSensor::setup(std::uint32_t uplinkPeriodMs) {
             time_t tnow = rtc.getLocalEpoch();
 
             // Find lightning sensor
-            int ls = weatherSensor.findType(SENSOR_TYPE_LIGHTNING);
+            int ls = sensorIndex.find(SENSOR_TYPE_LIGHTNING);
 
             // If lightning sensor has be found and data is valid, run post-processing
             if ((ls > -1) && weatherSensor.sensor[ls].valid) {
                 lightningProc.update(tnow, weatherSensor.sensor[ls].lgt.strike_count, weatherSensor.sensor[ls].lgt.distance_km, weatherSensor.sensor[ls].startup);
+                #ifdef LIGHTNING_HISTORY_EN
+                    lightningHistory.update(tnow, weatherSensor.sensor[ls].lgt.strike_count, weatherSensor.sensor[ls].lgt.distance_km, weatherSensor.sensor[ls].startup);
+                #endif
             }         
         }
     #endif
+
+    #ifdef BATCH_EN
+    {
+        // Store weather sensor sample
+        int ws = sensorIndex.weather();
+        if (ws > -1) {
+            sampleBatch.add(
+                rtc.getLocalEpoch(),
+                weatherSensor.sensor[ws].valid,
+                weatherSensor.sensor[ws].battery_ok,
+                weatherSensor.sensor[ws].w.temp_c,
+                weatherSensor.sensor[ws].w.humidity,
+                weatherSensor.sensor[ws].w.wind_gust_meter_sec_fp1,
+                weatherSensor.sensor[ws].w.wind_avg_meter_sec_fp1,
+                weatherSensor.sensor[ws].w.wind_direction_deg_fp1,
+                weatherSensor.sensor[ws].w.rain_ok ? weatherSensor.sensor[ws].w.rain_mm : -1
+            );
+        } else {
+            sampleBatch.add(rtc.getLocalEpoch(), false, false, 0, 0, 0, 0, 0, -1);
+        }
+    }
+    #endif
+
+    return decode_ok;
 }
 
 
@@ -1667,6 +2527,17 @@ cSensor::loop(void) {
     auto const deltaT = tNow - this->m_tReference;
 
     if (deltaT >= this->m_uplinkPeriodMs) {
+        #ifdef CONTINUOUS_RX_EN
+            // Receive new sensor data - the radio may only be used if the LMIC is idle
+            if (!this->m_fBusy && RadioCtx::lmicIdle()) {
+                radioCtx.save();
+                getSensorData();
+                radioCtx.restore();
+            } else {
+                logm_d(SENSOR, "LMIC busy - sensor data reception skipped");
+            }
+        #endif
+
         // request an uplink
         this->m_fUplinkRequest = true;
 
@@ -1680,6 +2551,26 @@ cSensor::loop(void) {
         this->m_fUplinkRequest = false;
         this->doUplink();
     }
+    #ifdef MULTI_SENSOR_EN
+        // send remaining multi-sensor frames - a requested config/status uplink
+        // goes first, the completion of another frame would cancel the request
+        else if (multiSensor.pending() && (uplinkReq == 0)) {
+            this->doMultiUplink();
+        }
+    #endif
+    #ifdef TELEMETRY_EN
+        // send diagnostic frame after the sensor data and a requested config/status uplink
+        else if (telemetry.pending() && (uplinkReq == 0)) {
+            this->doTelemetryUplink();
+        }
+    #endif
+    #ifdef LIGHTNING_HISTORY_EN
+        // send lightning events (only if there has been lightning activity)
+        // after a requested config/status uplink
+        else if (lightningHistory.pending() && (uplinkReq == 0)) {
+            this->doLightningUplink();
+        }
+    #endif
 }
 
 #ifdef ADC_EN
@@ -1699,7 +2590,7 @@ cSensor::loop(void) {
         }
         uint16_t voltage = int(voltage_raw / samples / divider);
         
-        log_d("Voltage = %dmV", voltage);
+        logm_d(SENSOR, "Voltage = %dmV", voltage);
 
         return voltage;
     }
@@ -1723,9 +2614,9 @@ cSensor::getTemperature(void)
     
     // Check if reading was successful
     if (tempC != DEVICE_DISCONNECTED_C) {
-        log_d("Temperature = %.2f°C", tempC);
+        logm_d(SENSOR, "Temperature = %.2f°C", tempC);
     } else {
-        log_d("Error: Could not read temperature data");
+        logm_d(SENSOR, "Error: Could not read temperature data");
     }
     
     return tempC;
@@ -1736,30 +2627,25 @@ cSensor::getTemperature(void)
 // Prepare uplink data for transmission
 //
 // Note:
-// Currently Weather Sensor Data can only be received during initialization if the radio transceiver
+// By default, Weather Sensor Data is only received during initialization, because the radio transceiver
 // is shared between BresserWeatherSensorReceiver and LoRaWAN library.
 // Therefore the node must perform a restart (from deep-sleep) after each succesful uplink.
 //
-// The required procedure to update the Weather Sensor Data (if radio receiver shared with LoRaWAN)
-// without deep sleep mode and restart would be:
-// 1. Save radio registers modified by LoRaWAN
+// With CONTINUOUS_RX_EN, the Weather Sensor Data is updated in cSensor::loop() without restart:
+// 1. Save radio registers modified by LoRaWAN (RadioCtx::save())
 // 2. Re-initialize radio for sensor data reception (FSK mode)
 // 3. Receive data
-// 4. Restore radio registers modified by LoRaWAN
-//
-// ToDo:
-// Which registers are actually shared between FSK and LoRaWAN mode?
-// Is there any additional state to be preserved?
+// 4. Restore radio registers modified by LoRaWAN (RadioCtx::restore())
 void
 cSensor::doUplink(void) {
     // if busy uplinking, just skip
     if (this->m_fBusy || myLoRaWAN.isBusy()) {
-        log_d("busy");
+        logm_d(SENSOR, "busy");
         return;
     }
     // if LMIC is busy, just skip
     if (LMIC.opmode & (OP_POLL | OP_TXDATA | OP_TXRXPEND)) {
-        log_d("other operation in progress");    
+        logm_d(SENSOR, "other operation in progress");    
         return;
     }
 
@@ -1773,10 +2659,13 @@ cSensor::doUplink(void) {
     // Read auxiliary sensor data
     //
     #ifdef ONEWIRE_EN
+        ENERGY_START(ENERGY_ONEWIRE);
         float     water_temp_c        = getTemperature();
+        ENERGY_STOP(ENERGY_ONEWIRE);
     #endif
     #ifdef DISTANCESENSOR_EN
         // Sensor power on
+        ENERGY_START(ENERGY_DISTANCE);
         digitalWrite(DISTANCESENSOR_PWR, HIGH);
         delay(500);
         
@@ -1786,7 +2675,7 @@ cSensor::doUplink(void) {
             dstStatus = distanceSensor.meassure();
 
             if (dstStatus != DistanceSensor_A02YYUW_MEASSUREMENT_STATUS_OK) {
-                log_e("Distance Sensor Error: %d", dstStatus);
+                logm_e(SENSOR, "Distance Sensor Error: %d", dstStatus);
             }
         } while (
             (dstStatus != DistanceSensor_A02YYUW_MEASSUREMENT_STATUS_OK) &&
@@ -1802,6 +2691,7 @@ cSensor::doUplink(void) {
         
         // Sensor power off
         digitalWrite(DISTANCESENSOR_PWR, LOW);
+        ENERGY_STOP(ENERGY_DISTANCE);
     #endif
     #ifdef ADC_EN
         uint16_t  supply_voltage      = getVoltage();
@@ -1814,120 +2704,135 @@ cSensor::doUplink(void) {
         float     indoor_temp_c;
         float     indoor_humidity;
     
-        // Set sensor data invalid
-        bleSensors.resetData();
-        
-        // Get sensor data - run BLE scan for <bleScanTime>
-        bleSensors.getData(BLE_SCAN_TIME);
+        PHASE_START(PHASE_BLE_SCAN);
+        ENERGY_START(ENERGY_BLE_SCAN);
+        #ifdef TELEMETRY_EN
+            uint32_t t_ble = millis();
+        #endif
+        #if defined(FAST_BOOT_EN) && defined(THEENGSDECODER_EN)
+            // Wait for completion of BLE scan started in cSensor::setup() - 
+            // otherwise run BLE scan now
+            if (!bleSensors.waitScan())
+        #endif
+        {
+            // Set sensor data invalid
+            bleSensors.resetData();
+            
+            // Get sensor data - run BLE scan for <bleScanTime>
+            bleSensors.getData(BLE_SCAN_TIME);
+        }
+        ENERGY_STOP(ENERGY_BLE_SCAN);
+        PHASE_STOP(PHASE_BLE_SCAN);
+        #ifdef TELEMETRY_EN
+            telemetry.sample(TLM_BLE_SCAN, millis() - t_ble);
+        #endif
     #endif
     #ifdef LIGHTNINGSENSOR_EN
-        time_t  lightn_ts;
-        int     lightn_events;
-        uint8_t lightn_distance;
+        time_t  lightn_ts       = 0;
+        int     lightn_events   = 0;
+        uint8_t lightn_distance = 0;
     #endif
     
     //
     // Find Bresser sensor data in array 
     //
+    PHASE_START(PHASE_SENSOR_LOOKUP);
     
-    // Try to find SENSOR_TYPE_WEATHER0
-    int ws = weatherSensor.findType(SENSOR_TYPE_WEATHER0);
-    if (ws < 0) {
-      // Try to find SENSOR_TYPE_WEATHER1
-      ws = weatherSensor.findType(SENSOR_TYPE_WEATHER1);
-    }
+    // Try to find SENSOR_TYPE_WEATHER0, then SENSOR_TYPE_WEATHER1
+    int ws = sensorIndex.weather();
 
     int s1 = -1;
     #ifdef SOILSENSOR_EN
       // Try to find SENSOR_TYPE_SOIL
-      s1 = weatherSensor.findType(SENSOR_TYPE_SOIL, 1);
+      s1 = sensorIndex.find(SENSOR_TYPE_SOIL, 1);
     #endif
 
     int ls = -1;
     #ifdef LIGHTNINGSENSOR_EN
       // Try to find SENSOR_TYPE_LIGHTNING
-      ls = weatherSensor.findType(SENSOR_TYPE_LIGHTNING);
+      ls = sensorIndex.find(SENSOR_TYPE_LIGHTNING);
     #endif
+    PHASE_STOP(PHASE_SENSOR_LOOKUP);
     
-    log_i("--- Uplink Data ---");
+    blog_i("--- Uplink Data ---");
     
     // Debug output for weather sensor data
     if (ws > -1) {
       if (weatherSensor.sensor[ws].w.temp_ok) {
-        log_i("Air Temperature:    %3.1f °C",   weatherSensor.sensor[ws].w.temp_c);
+        blog_i("Air Temperature:    %3.1f °C",   weatherSensor.sensor[ws].w.temp_c);
       } else {
-        log_i("Air Temperature:     --.- °C");
+        blog_i("Air Temperature:     --.- °C");
       }
       if (weatherSensor.sensor[ws].w.humidity_ok) {
-        log_i("Humidity:            %2d   %%",   weatherSensor.sensor[ws].w.humidity);
+        blog_i("Humidity:            %2d   %%",   weatherSensor.sensor[ws].w.humidity);
       } else {
-        log_i("Humidity:            --   %%");
+        blog_i("Humidity:            --   %%");
       }
       if (weatherSensor.sensor[ws].w.rain_ok) {
-        log_i("Rain Gauge:       %7.1f mm",      weatherSensor.sensor[ws].w.rain_mm);
+        blog_i("Rain Gauge:       %7.1f mm",      weatherSensor.sensor[ws].w.rain_mm);
       } else {
-        log_i("Rain Gauge:       ---.- mm");
+        blog_i("Rain Gauge:       ---.- mm");
       }
-      log_i("Wind Speed (avg.):    %3.1f m/s", weatherSensor.sensor[ws].w.wind_avg_meter_sec_fp1/10.0);
-      log_i("Wind Speed (max.):    %3.1f m/s", weatherSensor.sensor[ws].w.wind_gust_meter_sec_fp1/10.0);
-      log_i("Wind Direction:     %4.1f °",     weatherSensor.sensor[ws].w.wind_direction_deg_fp1/10.0);
+      blog_i("Wind Speed (avg.):    %3.1f m/s", weatherSensor.sensor[ws].w.wind_avg_meter_sec_fp1/10.0);
+      blog_i("Wind Speed (max.):    %3.1f m/s", weatherSensor.sensor[ws].w.wind_gust_meter_sec_fp1/10.0);
+      blog_i("Wind Direction:     %4.1f °",     weatherSensor.sensor[ws].w.wind_direction_deg_fp1/10.0);
     } else {
-      log_i("-- Weather Sensor Failure");
+      blog_i("-- Weather Sensor Failure");
     }
 
     // Debug output for soil sensor data
     #ifdef SOILSENSOR_EN
       if (s1 > -1) {
-        log_i("Soil Temperature 1: %3.1f °C",  weatherSensor.sensor[s1].soil.temp_c);
-        log_i("Soil Moisture 1:     %2d   %%",  weatherSensor.sensor[s1].soil.moisture);      
+        blog_i("Soil Temperature 1: %3.1f °C",  weatherSensor.sensor[s1].soil.temp_c);
+        blog_i("Soil Moisture 1:     %2d   %%",  weatherSensor.sensor[s1].soil.moisture);      
       } else {
-        log_i("-- Soil Sensor 1 Failure");
+        blog_i("-- Soil Sensor 1 Failure");
       }
     #endif
 
     // Debug output for lightning sensor data
     #ifdef LIGHTNINGSENSOR_EN
       if (ls > -1) {
-        log_i("Lightning counter: %4d",  weatherSensor.sensor[ls].lgt.strike_count);
-        log_i("Lightning distance:  %2d   km",  weatherSensor.sensor[ls].lgt.distance_km);    
+        blog_i("Lightning counter: %4d",  weatherSensor.sensor[ls].lgt.strike_count);
+        blog_i("Lightning distance:  %2d   km",  weatherSensor.sensor[ls].lgt.distance_km);    
       } else {
-        log_i("-- Lightning Sensor Failure");
+        blog_i("-- Lightning Sensor Failure");
       }
       if (lightningProc.lastEvent(lightn_ts, lightn_events, lightn_distance)) {
-            #if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_INFO
+            #if LOG_ENABLED(SENSOR, ARDUHAL_LOG_LEVEL_INFO)
                 struct tm timeinfo;
                 char tbuf[25];
 
                 localtime_r(&lightn_ts, &timeinfo);
                 strftime(tbuf, 25, "%Y-%m-%d %H:%M:%S", &timeinfo);
+                log_i("Last lightning event @%s: %d events, %d km", tbuf, lightn_events, lightn_distance);
             #endif
-            log_i("Last lightning event @%s: %d events, %d km", tbuf, lightn_events, lightn_distance);
       } else {
-        log_i("-- No Lightning Event Data Available");
+        blog_i("-- No Lightning Event Data Available");
       }
     #endif
     
     #ifdef ONEWIRE_EN
         // Debug output for auxiliary sensors/voltages
         if (water_temp_c != DEVICE_DISCONNECTED_C) {
-            log_i("Water Temperature:  % 2.1f °C",  water_temp_c);
+            blog_i("Water Temperature:  % 2.1f °C",  water_temp_c);
         } else {
-            log_i("Water Temperature:   --.- °C");
+            blog_i("Water Temperature:   --.- °C");
             water_temp_c = -30.0;
         }
     #endif
     #ifdef DISTANCESENSOR_EN
         if (distance_mm > 0) {
-            log_i("Distance:          %4d mm", distance_mm);
+            blog_i("Distance:          %4d mm", distance_mm);
         } else {
-            log_i("Distance:         ---- mm");
+            blog_i("Distance:         ---- mm");
         }
     #endif
     #ifdef ADC_EN
-        log_i("Supply  Voltage:   %4d   mV",       supply_voltage);
+        blog_i("Supply  Voltage:   %4d   mV",       supply_voltage);
     #endif
     #if defined(ADC_EN) && defined(PIN_ADC3_IN)
-        log_i("Battery Voltage:   %4d   mV",       battery_voltage);
+        blog_i("Battery Voltage:   %4d   mV",       battery_voltage);
     #endif
     
     #if defined(MITHERMOMETER_EN)
@@ -1935,186 +2840,430 @@ cSensor::doUplink(void) {
     #elif defined(THEENGSDECODER_EN)
         float div = 1.0;
     #endif
+    #if defined(THEENGSDECODER_EN)
+        // Use first sensor found (in order of KNOWN_BLE_ADDRESSES)
+        int ble_idx = bleSensors.getValid();
+        for (size_t i = 0; i < bleSensors.data.size(); i++) {
+            if (bleSensors.data[i].valid) {
+                blog_d("BLE Sensor #%u:      % 3.1f °C, %3.1f %%, %d dBm", (unsigned)i,
+                    bleSensors.data[i].temperature, bleSensors.data[i].humidity, bleSensors.data[i].rssi);
+            }
+        }
+    #elif defined(MITHERMOMETER_EN)
+        int ble_idx = bleSensors.data[0].valid ? 0 : -1;
+    #endif
     #if defined(MITHERMOMETER_EN) || defined(THEENGSDECODER_EN)
-        if (bleSensors.data[0].valid) {
+        if (ble_idx >= 0) {
             mithermometer_valid = true;
-            indoor_temp_c   = bleSensors.data[0].temperature/div;
-            indoor_humidity = bleSensors.data[0].humidity/div;
-            log_i("Indoor Air Temp.:   % 3.1f °C", bleSensors.data[0].temperature/div);
-            log_i("Indoor Humidity:     %3.1f %%", bleSensors.data[0].humidity/div);
+            indoor_temp_c   = bleSensors.data[ble_idx].temperature/div;
+            indoor_humidity = bleSensors.data[ble_idx].humidity/div;
+            blog_i("Indoor Air Temp.:   % 3.1f °C", bleSensors.data[ble_idx].temperature/div);
+            blog_i("Indoor Humidity:     %3.1f %%", bleSensors.data[ble_idx].humidity/div);
         } else {
-            log_i("Indoor Air Temp.:    --.- °C");
-            log_i("Indoor Humidity:     --   %%");
+            blog_i("Indoor Air Temp.:    --.- °C");
+            blog_i("Indoor Humidity:     --   %%");
             indoor_temp_c   = -30;
             indoor_humidity = 0;
         }
     #endif
-    log_v("-");
+    logm_v(SENSOR, "-");
 
     //
     // Encode sensor data as byte array for LoRaWAN transmission
+    // (see src/Payload/PayloadSchema.h for the payload layout)
     //
-    LoraEncoder encoder(loraData);
-    #ifdef SENSORID_EN
-        if (ws > -1) {
-          encoder.writeUint32(weatherSensor.sensor[ws].sensor_id);
-        } else {
-          encoder.writeUint32(0);
-        }
-    #endif
+    PHASE_START(PHASE_ENCODE);
+    PayloadValueU pl[PF_NUM];
+    memset(pl, 0, sizeof(pl));
+
+    pl[PF_id].u32 = (ws > -1) ? weatherSensor.sensor[ws].sensor_id : 0;
 
     // TTN node status flags
-    encoder.writeBitmap(0,
-                        0,
-                        0,
-                        0,
-                        0,
-                        longSleep,
-                        rtcSyncReq, 
-                        runtimeExpired);
+    pl[PF_status_node].u8 = payloadBitmap(0,
+                                          0,
+                                          0,
+                                          0,
+                                          0,
+                                          longSleep,
+                                          rtcSyncReq, 
+                                          runtimeExpired);
 
     // Sensor status flags
-    encoder.writeBitmap(0,
-                        mithermometer_valid,
-                        (ls > -1) ? weatherSensor.sensor[ls].valid : false,
-                        (ls > -1) ? weatherSensor.sensor[ls].battery_ok : false,
-                        (s1 > -1) ? weatherSensor.sensor[s1].valid : false,
-                        (s1 > -1) ? weatherSensor.sensor[s1].battery_ok : false,
-                        (ws > -1) ? weatherSensor.sensor[ws].valid : false,
-                        (ws > -1) ? weatherSensor.sensor[ws].battery_ok : false);
+    pl[PF_status].u8 = payloadBitmap(0,
+                                     mithermometer_valid,
+                                     (ls > -1) ? weatherSensor.sensor[ls].valid : false,
+                                     (ls > -1) ? weatherSensor.sensor[ls].battery_ok : false,
+                                     (s1 > -1) ? weatherSensor.sensor[s1].valid : false,
+                                     (s1 > -1) ? weatherSensor.sensor[s1].battery_ok : false,
+                                     (ws > -1) ? weatherSensor.sensor[ws].valid : false,
+                                     (ws > -1) ? weatherSensor.sensor[ws].battery_ok : false);
     
     // Weather sensor data
     if (ws > -1) {
         // weather sensor data available
-        if (weatherSensor.sensor[ws].w.temp_ok) {
-            encoder.writeTemperature(weatherSensor.sensor[ws].w.temp_c);
-        } else {
-            encoder.writeTemperature(-30);
-        }
-        if (weatherSensor.sensor[ws].w.humidity_ok) {
-            encoder.writeUint8(weatherSensor.sensor[ws].w.humidity);
-        } else {
-            encoder.writeUint8(0);
-        }
+        pl[PF_air_temp_c].f = (weatherSensor.sensor[ws].w.temp_ok) ? weatherSensor.sensor[ws].w.temp_c : -30;
+        pl[PF_humidity].u8  = (weatherSensor.sensor[ws].w.humidity_ok) ? weatherSensor.sensor[ws].w.humidity : 0;
         #ifdef ENCODE_AS_FLOAT
-            encoder.writeRawFloat(weatherSensor.sensor[ws].w.wind_gust_meter_sec);
-            encoder.writeRawFloat(weatherSensor.sensor[ws].w.wind_avg_meter_sec);
-            encoder.writeRawFloat(weatherSensor.sensor[ws].w.wind_direction_deg);
+            pl[PF_wind_gust_meter_sec].f  = weatherSensor.sensor[ws].w.wind_gust_meter_sec;
+            pl[PF_wind_avg_meter_sec].f   = weatherSensor.sensor[ws].w.wind_avg_meter_sec;
+            pl[PF_wind_direction_deg].f   = weatherSensor.sensor[ws].w.wind_direction_deg;
         #else
-            encoder.writeUint16(weatherSensor.sensor[ws].w.wind_gust_meter_sec_fp1);
-            encoder.writeUint16(weatherSensor.sensor[ws].w.wind_avg_meter_sec_fp1);
-            encoder.writeUint16(weatherSensor.sensor[ws].w.wind_direction_deg_fp1);
+            pl[PF_wind_gust_meter_sec].u16 = weatherSensor.sensor[ws].w.wind_gust_meter_sec_fp1;
+            pl[PF_wind_avg_meter_sec].u16  = weatherSensor.sensor[ws].w.wind_avg_meter_sec_fp1;
+            pl[PF_wind_direction_deg].u16  = weatherSensor.sensor[ws].w.wind_direction_deg_fp1;
         #endif
-        if (weatherSensor.sensor[ws].w.rain_ok) {
-            encoder.writeRawFloat(weatherSensor.sensor[ws].w.rain_mm);
-        } else {
-            encoder.writeRawFloat(0);
-        }
+        pl[PF_rain_mm].f = (weatherSensor.sensor[ws].w.rain_ok) ? weatherSensor.sensor[ws].w.rain_mm : 0;
     } else {
         // fill with suspicious dummy values
-        encoder.writeTemperature(-30);
-        encoder.writeUint8(0);
-        #ifdef ENCODE_AS_FLOAT
-            encoder.writeRawFloat(0);
-            encoder.writeRawFloat(0);
-            encoder.writeRawFloat(0);
-        #else
-            encoder.writeUint16(0);
-            encoder.writeUint16(0);
-            encoder.writeUint16(0);
-        #endif
-        encoder.writeRawFloat(0);
+        pl[PF_air_temp_c].f = -30;
     }
 
     // Voltages / auxiliary sensor data
     #ifdef ADC_EN
-        encoder.writeUint16(supply_voltage);
+        pl[PF_supply_v].u16 = supply_voltage;
     #endif
     #if defined(ADC_EN) && defined(PIN_ADC3_IN)
-        encoder.writeUint16(battery_voltage);
+        pl[PF_battery_v].u16 = battery_voltage;
     #endif
     #ifdef ONEWIRE_EN
-        encoder.writeTemperature(water_temp_c);
+        pl[PF_water_temp_c].f = water_temp_c;
     #endif
     #if defined(MITHERMOMETER_EN) || defined(THEENGSDECODER_EN)
-        encoder.writeTemperature(indoor_temp_c);
-        encoder.writeUint8((uint8_t)(indoor_humidity+0.5));
+        pl[PF_indoor_temp_c].f    = indoor_temp_c;
+        pl[PF_indoor_humidity].u8 = (uint8_t)(indoor_humidity+0.5);
 
         // BLE Tempoerature/Humidity Sensor: delete results fromBLEScan buffer to release memory
         bleSensors.clearScanResults();
     #endif    
 
     // Soil sensor data
-    #ifdef SOILSENSOR_EN
-        if (s1 > -1) {
-            // soil sensor data available
-            encoder.writeTemperature(weatherSensor.sensor[s1].soil.temp_c);
-            encoder.writeUint8(weatherSensor.sensor[s1].soil.moisture);
-        } else {
-            // fill with suspicious dummy values
-            encoder.writeTemperature(-30);
-            encoder.writeUint8(0);
-        }
-    #endif
+    if (s1 > -1) {
+        // soil sensor data available
+        pl[PF_soil_temp_c].f    = weatherSensor.sensor[s1].soil.temp_c;
+        pl[PF_soil_moisture].u8 = weatherSensor.sensor[s1].soil.moisture;
+    } else {
+        // fill with suspicious dummy values
+        pl[PF_soil_temp_c].f    = -30;
+    }
 
     // Rain data statistics
     #ifdef RAINDATA_EN
         if ((ws > -1) && weatherSensor.sensor[ws].valid && weatherSensor.sensor[ws].w.rain_ok) {
-            log_i("Rain past 60min:  %7.1f mm", rainGauge.pastHour());
-            log_i("Rain curr. day:   %7.1f mm", rainGauge.currentDay());
-            log_i("Rain curr. week:  %7.1f mm", rainGauge.currentWeek());
-            log_i("Rain curr. month: %7.1f mm", rainGauge.currentMonth());
-            encoder.writeRawFloat(rainGauge.pastHour());
-            encoder.writeRawFloat(rainGauge.currentDay());
-            encoder.writeRawFloat(rainGauge.currentWeek());
-            encoder.writeRawFloat(rainGauge.currentMonth());
+            blog_i("Rain past 60min:  %7.1f mm", rainGauge.pastHour());
+            blog_i("Rain curr. day:   %7.1f mm", rainGauge.currentDay());
+            blog_i("Rain curr. week:  %7.1f mm", rainGauge.currentWeek());
+            blog_i("Rain curr. month: %7.1f mm", rainGauge.currentMonth());
+            pl[PF_rain_hr].f   = rainGauge.pastHour();
+            pl[PF_rain_day].f  = rainGauge.currentDay();
+            pl[PF_rain_week].f = rainGauge.currentWeek();
+            pl[PF_rain_mon].f  = rainGauge.currentMonth();
         } else {
-            log_i("Current rain gauge statistics not valid.");
-            encoder.writeRawFloat(-1);
-            encoder.writeRawFloat(-1);
-            encoder.writeRawFloat(-1);
-            encoder.writeRawFloat(-1);            
+            blog_i("Current rain gauge statistics not valid.");
+            pl[PF_rain_hr].f   = -1;
+            pl[PF_rain_day].f  = -1;
+            pl[PF_rain_week].f = -1;
+            pl[PF_rain_mon].f  = -1;
         }
     #endif
 
     // Distance sensor data
     #ifdef DISTANCESENSOR_EN
-        encoder.writeUint16(distance_mm);
+        pl[PF_distance_mm].u16 = distance_mm;
     #endif
 
     // Lightning sensor data
     #ifdef LIGHTNINGSENSOR_EN
         if (ls > -1) {
             // Lightning sensor data available
-            encoder.writeUnixtime(lightn_ts);
-            encoder.writeUint16(lightn_events);
-            encoder.writeUint8(lightn_distance);
-        } else {
-            // Fill with suspicious dummy values
-            encoder.writeUnixtime(0);
-            encoder.writeUint16(0);
-            encoder.writeUint8(0);
+            pl[PF_lightning_time].u32        = lightn_ts;
+            pl[PF_lightning_count].u16       = lightn_events;
+            pl[PF_lightning_distance_km].u8  = lightn_distance;
         }
     #endif
     //encoder.writeRawFloat(radio.getRSSI()); // NOTE: int8_t would be more efficient
 
+    // Max. payload size at the current data rate
+    const uint8_t maxLen = maxUplinkLen();
+
+    #if defined(BATCH_EN)
+        // All samples collected since last acknowledged batch uplink
+        uint8_t payloadLen  = sampleBatch.encode(loraData, maxLen);
+        uint8_t payloadPort = 5;
+        if (payloadLen == 0) {
+            // Not even a single sample fits at the current data rate -
+            // samples are kept for the next wake-up
+            logm_i(LORAWAN, "Batch: frame does not fit (DR%u) - skipping uplink", LMIC.datarate);
+            PHASE_STOP(PHASE_ENCODE);
+            sleepReq = true;
+            return;
+        }
+    #elif defined(PAYLOAD_COMPRESSED_EN)
+        // Keyframe or delta frame against last acknowledged frame
+        uint8_t payloadLen  = payloadCompressor.encode(pl, loraData, PAYLOAD_SIZE);
+        uint8_t payloadPort = 4;
+    #else
+        LoraEncoder encoder(loraData);
+        encodePayload(encoder, pl);
+        uint8_t payloadLen  = encoder.getLength();
+        uint8_t payloadPort = 1;
+    #endif
+
+    #if !defined(BATCH_EN)
+        if (payloadLen > maxLen) {
+            // Frame does not fit at the current data rate - send the payload
+            // truncated after the last complete field which fits on FPort 8
+            #if defined(PAYLOAD_COMPRESSED_EN)
+                payloadCompressor.confirm(false);
+                LoraEncoder encoder(loraData);
+                encodePayload(encoder, pl);
+            #endif
+            payloadLen  = payloadPrefixSize(maxLen);
+            payloadPort = 8;
+            logm_i(LORAWAN, "Payload truncated to %u bytes (DR%u)", payloadLen, LMIC.datarate);
+        }
+    #endif
+
+    #if defined(TX_POLICY_EN) && defined(BATCH_EN)
+        // Batch samples are only removed if acknowledged - an unconfirmed
+        // batch frame would be resent until the next confirmed uplink
+        bool confirmed = txPolicy.confirm(true);
+    #elif defined(TX_POLICY_EN)
+        bool confirmed = txPolicy.confirm();
+    #else
+        bool confirmed = true;
+    #endif
+
+    #ifdef MULTI_SENSOR_EN
+        // Records of all valid sensors - sent on FPort 6 after this uplink
+        multiSensor.build(weatherSensor);
+        #if defined(MITHERMOMETER_EN) || defined(THEENGSDECODER_EN)
+            for (size_t i = 0; i < bleSensors.data.size(); i++) {
+                if (bleSensors.data[i].valid) {
+                    multiSensor.addBle(i, bleSensors.data[i].temperature/div, bleSensors.data[i].humidity/div,
+                        bleSensors.data[i].batt_level);
+                }
+            }
+        #endif
+    #endif
+    PHASE_STOP(PHASE_ENCODE);
+
     this->m_fBusy = true;
 
     // Schedule transmission
+    PHASE_START(PHASE_SCHEDULE);
     if (! myLoRaWAN.SendBuffer(
-        loraData, encoder.getLength(),
+        loraData, payloadLen,
         // this is the completion function:
         [](void *pClientData, bool fSuccess) -> void {
-            (void)fSuccess;
+            #ifdef TX_POLICY_EN
+                // Unconfirmed uplinks are not known to be received
+                bool ack = txPolicy.complete(fSuccess, LMIC.snr / 4);
+            #else
+                bool ack = fSuccess;
+            #endif
+            #if defined(BATCH_EN)
+                // Samples are removed only if the frame has been acknowledged
+                sampleBatch.confirm(ack);
+            #elif defined(PAYLOAD_COMPRESSED_EN)
+                // Frame becomes the new reference only if it has been acknowledged
+                payloadCompressor.confirm(ack);
+            #else
+                (void)ack;
+            #endif
+            #ifdef TELEMETRY_EN
+                if (!fSuccess) {
+                    telemetry.txFailure();
+                }
+            #endif
             auto const pThis = (cSensor *)pClientData;
             pThis->m_fBusy = false;
         },
         (void *)this,
-        /* confirmed */ true,
-        /* port */ 1
+        /* confirmed */ confirmed,
+        /* port */ payloadPort
         )) {
         // sending failed; callback has not been called and will not
         // be called. Reset busy flag.
+        #if defined(BATCH_EN)
+            sampleBatch.confirm(false);
+        #elif defined(PAYLOAD_COMPRESSED_EN)
+            payloadCompressor.confirm(false);
+        #endif
         this->m_fBusy = false;
     }
+    PHASE_STOP(PHASE_SCHEDULE);
+
+    #ifdef PHASE_TIMER_EN
+        phaseTimer.print();
+    #endif
 }
+
+#ifdef MULTI_SENSOR_EN
+void
+cSensor::doMultiUplink(void) {
+    // if busy uplinking, just skip
+    if (this->m_fBusy || myLoRaWAN.isBusy()) {
+        return;
+    }
+    // if LMIC is busy, just skip
+    if (LMIC.opmode & (OP_POLL | OP_TXDATA | OP_TXRXPEND)) {
+        return;
+    }
+
+    // The records are split into frames which fit at the current data rate
+    uint8_t payloadLen = multiSensor.encode(loraData, maxUplinkLen());
+    if (payloadLen == 0) {
+        return;
+    }
+
+    #ifdef TX_POLICY_EN
+        bool confirmed = txPolicy.confirm();
+    #else
+        bool confirmed = true;
+    #endif
+
+    this->m_fBusy = true;
+
+    if (! myLoRaWAN.SendBuffer(
+        loraData, payloadLen,
+        // this is the completion function:
+        [](void *pClientData, bool fSuccess) -> void {
+            #ifdef TX_POLICY_EN
+                txPolicy.complete(fSuccess, LMIC.snr / 4);
+            #endif
+            #ifdef TELEMETRY_EN
+                if (!fSuccess) {
+                    telemetry.txFailure();
+                }
+            #endif
+            multiSensor.sent();
+            auto const pThis = (cSensor *)pClientData;
+            pThis->m_fBusy = false;
+        },
+        (void *)this,
+        /* confirmed */ confirmed,
+        /* port */ 6
+        )) {
+        // sending failed; callback has not been called and will not
+        // be called. Reset busy flag - the frame will be retried.
+        this->m_fBusy = false;
+    }
+}
+#endif
+
+#ifdef TELEMETRY_EN
+void
+cSensor::doTelemetryUplink(void) {
+    // if busy uplinking, just skip
+    if (this->m_fBusy || myLoRaWAN.isBusy()) {
+        return;
+    }
+    // if LMIC is busy, just skip
+    if (LMIC.opmode & (OP_POLL | OP_TXDATA | OP_TXRXPEND)) {
+        return;
+    }
+
+    // Note: The frame is sent only once per wake cycle
+    uint8_t payloadLen = telemetry.encode(loraData, maxUplinkLen());
+    if (payloadLen == 0) {
+        telemetry.sent(false);
+        return;
+    }
+
+    #ifdef TX_POLICY_EN
+        bool confirmed = txPolicy.confirm();
+    #else
+        bool confirmed = true;
+    #endif
+
+    this->m_fBusy = true;
+
+    if (! myLoRaWAN.SendBuffer(
+        loraData, payloadLen,
+        // this is the completion function:
+        [](void *pClientData, bool fSuccess) -> void {
+            if (!fSuccess) {
+                telemetry.txFailure();
+            }
+            #ifdef TX_POLICY_EN
+                // An unconfirmed frame counts as delivered once it has been sent
+                bool ack = txPolicy.complete(fSuccess, LMIC.snr / 4) ||
+                           (!txPolicy.confirmed() && fSuccess);
+            #else
+                bool ack = fSuccess;
+            #endif
+            // Histograms are cleared only if the frame has been delivered
+            telemetry.sent(ack);
+            auto const pThis = (cSensor *)pClientData;
+            pThis->m_fBusy = false;
+        },
+        (void *)this,
+        /* confirmed */ confirmed,
+        /* port */ 7
+        )) {
+        // sending failed; callback has not been called and will not
+        // be called. Reset busy flag - the frame will be retried in the next cycle.
+        this->m_fBusy = false;
+    }
+}
+#endif
+
+#ifdef LIGHTNING_HISTORY_EN
+void
+cSensor::doLightningUplink(void) {
+    // if busy uplinking, just skip
+    if (this->m_fBusy || myLoRaWAN.isBusy()) {
+        return;
+    }
+    // if LMIC is busy, just skip
+    if (LMIC.opmode & (OP_POLL | OP_TXDATA | OP_TXRXPEND)) {
+        return;
+    }
+
+    // Note: The frame is sent only once per wake cycle; events which did not fit
+    // are sent in the next cycle
+    uint8_t payloadLen = lightningHistory.encode(loraData, maxUplinkLen());
+    if (payloadLen == 0) {
+        lightningHistory.sent(false);
+        return;
+    }
+
+    #ifdef TX_POLICY_EN
+        bool confirmed = txPolicy.confirm();
+    #else
+        bool confirmed = true;
+    #endif
+
+    this->m_fBusy = true;
+
+    if (! myLoRaWAN.SendBuffer(
+        loraData, payloadLen,
+        // this is the completion function:
+        [](void *pClientData, bool fSuccess) -> void {
+            #ifdef TELEMETRY_EN
+                if (!fSuccess) {
+                    telemetry.txFailure();
+                }
+            #endif
+            #ifdef TX_POLICY_EN
+                // An unconfirmed frame counts as delivered once it has been sent
+                bool ack = txPolicy.complete(fSuccess, LMIC.snr / 4) ||
+                           (!txPolicy.confirmed() && fSuccess);
+            #else
+                bool ack = fSuccess;
+            #endif
+            // Events are removed only if the frame has been delivered
+            lightningHistory.sent(ack);
+            auto const pThis = (cSensor *)pClientData;
+            pThis->m_fBusy = false;
+        },
+        (void *)this,
+        /* confirmed */ confirmed,
+        /* port */ 9
+        )) {
+        // sending failed; callback has not been called and will not
+        // be called. Reset busy flag - the frame will be retried in the next cycle.
+        this->m_fBusy = false;
+    }
+}
+#endif
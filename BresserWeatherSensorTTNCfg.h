@@ -72,6 +72,27 @@
 //          (Now available in arduino-esp32 v3.0.X)
 //          Updated board configurations after changes in 
 //          Arduino ESP32 package v3.0.X
+// 20261017 Added PHASE_TIMER_EN
+//          Disabled THEENGSDECODER_EN in host build (HOST_BUILD)
+//          Added PAYLOAD_COMPRESSED_EN and PAYLOAD_KEYFRAME_INTERVAL
+//          Added BATCH_EN and BATCH_SIZE
+//          Added CONTINUOUS_RX_EN
+//          Added FAST_BOOT_EN and FAST_BOOT_SERIAL_TIMEOUT
+//          Added RX_POLICY_EN and RX_REQUIRED
+//          Added ARRIVAL_PREDICTION_EN, ARRIVAL_PERIOD_MAX and ARRIVAL_GUARD_MS
+//          Added BLE_SCAN_PASSIVE_EN and BLE_SCAN_ADAPTIVE_EN
+//          Added MULTI_SENSOR_EN
+//          Added RAIN_HISTORY_EN
+//          Added PERSIST_BLOB_EN
+//          Added SESSION_FCNT_INTERVAL
+//          Added ENERGY_MODEL_EN
+//          Added TELEMETRY_EN and TELEMETRY_CYCLES
+//          Added BINLOG_EN, BINLOG_WORDS and BINLOG_DUMP_CMD
+//          Added LOG_LEVEL_LORAWAN/SENSOR/BLE/RTC/PERSIST
+//          Added TX_POLICY_EN, TX_CONFIRM_EVERY and TX_BACKOFF_MAX
+//          Added TICKLESS_IDLE_EN, TICKLESS_MIN_MS, TICKLESS_MAX_MS and TICKLESS_GUARD_MS
+//          Added LIGHTNING_HISTORY_EN
+//          Added ARRIVAL_LEARN_INTERVAL
 //
 // Note:
 // Depending on board package file date, either
@@ -91,6 +112,15 @@
 // Arduino IDE: Tools->Core Debug Level: "Debug|Verbose"
 // For other architectures than ESP32, see logging.h
 
+// Per-subsystem log levels (ARDUHAL_LOG_LEVEL_*) - can only lower the core debug level;
+// disabled messages and their arguments are removed at compile time (see logging.h).
+// For the files in src/, set these as build flags (e.g. -DLOG_LEVEL_BLE=1).
+// #define LOG_LEVEL_LORAWAN   ARDUHAL_LOG_LEVEL_INFO
+// #define LOG_LEVEL_SENSOR    ARDUHAL_LOG_LEVEL_INFO
+// #define LOG_LEVEL_BLE       ARDUHAL_LOG_LEVEL_WARN
+// #define LOG_LEVEL_RTC       ARDUHAL_LOG_LEVEL_WARN
+// #define LOG_LEVEL_PERSIST   ARDUHAL_LOG_LEVEL_WARN
+
 // Enable logging for https://github.com/vshymanskyy/Preferences (used for RP2040)
 // #define NVS_LOG
 
@@ -115,11 +145,80 @@
 // Enable LORAWAN debug mode - this generates dummy weather data and skips weather sensor reception
 // #define LORAWAN_DEBUG
 
+// Enable execution time measurement of boot and uplink phases (serial init, sensor reception, BLE scan,
+// LoRaWAN init, sensor lookup, encoding, send scheduling)
+// Statistics are printed with log level INFO after each uplink; on ESP32, they are retained in RTC RAM
+// #define PHASE_TIMER_EN
+
+// Enable energy accounting - the durations of the wake cycle phases (sensor reception, BLE scan,
+// OneWire/distance sensor, join, TX/RX windows) and of sleep mode are multiplied with the board's
+// supply currents; the charge per cycle and the projected battery life are printed before entering
+// sleep mode and appended to the CMD_GET_CONFIG response (FPort 3).
+// Currents: ENERGY_I_<phase>_UA, battery capacity: ENERGY_BATTERY_MAH (see src/EnergyModel/EnergyModel.h)
+// #define ENERGY_MODEL_EN
+
+// Enable diagnostic uplink on FPort 7 - histograms of awake time, weather sensor reception time,
+// BLE scan duration and join attempts as well as TX failure and sleep timeout counters are
+// accumulated in RAM retained during sleep and sent every TELEMETRY_CYCLES wake cycles (max. 255)
+// #define TELEMETRY_EN
+#define TELEMETRY_CYCLES 96
+
+// Enable deferred binary logging - blog_*() calls (e.g. the uplink data printout) store a format
+// string ID and the raw arguments in a RAM ring buffer of BINLOG_WORDS 32-bit words (retained
+// during sleep) instead of formatting the message. The buffer is dumped as hex words if the
+// character BINLOG_DUMP_CMD is received on the serial port; decode with scripts/binlog_decode.py.
+// #define BINLOG_EN
+#define BINLOG_WORDS 256
+#define BINLOG_DUMP_CMD 'L'
+
+// Enable fast boot - reduces the time from wake-up to uplink:
+// - The fixed delays (3.5 s) after serial port initialization are skipped; with USB CDC
+//   (RP2040, ESP32-S2/S3 with "USB CDC On Boot"), the serial port is awaited for
+//   max. FAST_BOOT_SERIAL_TIMEOUT milliseconds since reset
+// - With THEENGSDECODER_EN, the BLE scan is run concurrently with weather sensor data reception
+// #define FAST_BOOT_EN
+
+// Max. time since reset to wait for USB CDC serial port in fast boot mode [ms]
+#define FAST_BOOT_SERIAL_TIMEOUT 1000
+
+// Enable delta/varint compressed uplink payload on FPort 4 instead of FPort 1
+// Only fields which changed since the last acknowledged frame are sent;
+// this requires a stateful decoder (see scripts/uplink_compressed_decoder.js)
+// #define PAYLOAD_COMPRESSED_EN
+
+// Max. number of delta frames between keyframes (full payload) in compressed mode
+#define PAYLOAD_KEYFRAME_INTERVAL 12
+
+// Enable batched uplinks - weather sensor samples are stored in RAM retained during deep sleep
+// and BATCH_SIZE samples are sent in a single uplink on FPort 5 (instead of FPort 1/4);
+// LoRaWAN is only started at every BATCH_SIZE-th wake-up. Requires SLEEP_EN.
+// Note: Only the weather sensor data is sent, the data of other sensors is not transmitted.
+// #define BATCH_EN
+
+// Number of samples per batched uplink (1...4)
+#define BATCH_SIZE 4
+
+// Enable multi-sensor uplink - the data of all valid weather/soil/lightning sensors
+// (and BLE sensors) is sent in self-describing records on FPort 6 after the regular uplink,
+// split into several frames if required (see src/MultiSensor/MultiSensor.h)
+// #define MULTI_SENSOR_EN
+
 // LoRaWAN session info is stored in RTC RAM on ESP32 and in Preferences (flash) on RP2040
 #if defined(ARDUINO_ADAFRUIT_FEATHER_RP2040)
 #define SESSION_IN_PREFERENCES
 #endif
 
+// Store preferences and LoRaWAN session info/state (SESSION_IN_PREFERENCES) as single
+// versioned, CRC-checked blobs instead of separate keys; unchanged data is not written
+// Note: Stored session data in the old format is not converted, i.e. a new join is required.
+// #define PERSIST_BLOB_EN
+
+// PERSIST_BLOB_EN/SESSION_IN_PREFERENCES: If only the frame counters changed, the session state
+// is written to flash only every SESSION_FCNT_INTERVAL uplinks (the current state is kept in
+// RAM retained during sleep; RP2040: the number of uplinks since the last flash write is kept
+// in a watchdog scratch register). If this is lost, FCntUp is advanced by this value.
+#define SESSION_FCNT_INTERVAL 16
+
 // Battery voltage thresholds for energy saving
 
 // If SLEEP_EN is defined and battery voltage <= BATTERY_WEAK [mV], MCU will sleep for SLEEP_INTERVAL_LONG
@@ -152,6 +251,13 @@
 #endif
 
 
+// Enable continuous receive mode - for mains powered nodes:
+// The node does not sleep/restart after each uplink; instead, weather sensor data is received
+// and sent every SLEEP_INTERVAL seconds. The radio transceiver is switched between LoRaWAN
+// and sensor data reception by saving/restoring the LoRa mode registers.
+// Requires SLEEP_EN, FORCE_SLEEP and BATCH_EN to be disabled!
+// #define CONTINUOUS_RX_EN
+
 // Enable sleep mode - sleep after successful transmission to TTN (recommended!)
 #define SLEEP_EN
 
@@ -179,9 +285,55 @@
 // Additional timeout to be applied after joining if Network Time Request pending
 #define SLEEP_TIMEOUT_EXTRA 300
 
+// Enable transmit policy - only every TX_CONFIRM_EVERY-th data uplink is sent as confirmed
+// uplink (less often after failures), the payload is truncated (FPort 8) if it exceeds the
+// max. size at the current data rate and the sleep interval is extended (max. factor
+// TX_BACKOFF_MAX) while uplinks are not acknowledged (see src/TxPolicy/TxPolicy.h)
+// With BATCH_EN, batch frames are always confirmed (samples are removed only if acknowledged).
+// #define TX_POLICY_EN
+
+// Send every n-th data uplink as confirmed uplink (TX_POLICY_EN)
+#define TX_CONFIRM_EVERY 4
+
+// Max. sleep interval factor after unacknowledged uplinks (TX_POLICY_EN)
+#define TX_BACKOFF_MAX 4
+
+// Enable tickless idle - while waiting for the LMIC (TX, receive windows, join accept),
+// the MCU enters light sleep (ESP32) or waits for an event (RP2040) until the next LMIC job
+// or a radio DIO interrupt instead of polling in loop() (see src/TicklessIdle/TicklessIdle.h)
+// #define TICKLESS_IDLE_EN
+
+// Min./max. idle duration and wake-up time before the next LMIC job [ms] (TICKLESS_IDLE_EN)
+#define TICKLESS_MIN_MS 5
+#define TICKLESS_MAX_MS 1000
+#define TICKLESS_GUARD_MS 3
+
 // Timeout for weather sensor data reception (seconds)
 #define WEATHERSENSOR_TIMEOUT 180
 
+// Enable receive policy - weather sensor data reception is stopped as soon as the sensors
+// defined in RX_REQUIRED have been received, or with partial data after an adaptive deadline
+// learned from the recent arrival times (max. WEATHERSENSOR_TIMEOUT)
+// #define RX_POLICY_EN
+
+// Required sensors (RX_POLICY_EN): RX_REQ_WEATHER | RX_REQ_SOIL | RX_REQ_LIGHTNING
+#define RX_REQUIRED (RX_REQ_WEATHER)
+
+// Enable wake-up scheduling by sensor arrival prediction - the weather sensor's transmission
+// period and phase are learned and the node wakes up ARRIVAL_GUARD_MS before the expected
+// transmission closest to the regular wake-up time (recommended with RX_POLICY_EN)
+// #define ARRIVAL_PREDICTION_EN
+
+// Max. weather sensor transmission period [ms]
+#define ARRIVAL_PERIOD_MAX 20000
+
+// Guard time before the expected weather sensor transmission [ms]
+#define ARRIVAL_GUARD_MS 1000
+
+// Wake cycles between transmission period measurements while the period is unknown
+// (each measurement extends reception by up to 2 x ARRIVAL_PERIOD_MAX)
+#define ARRIVAL_LEARN_INTERVAL 8
+
 // If enabled, enter deep sleep mode if receiving weather sensor data was not successful
 // #define WEATHERSENSOR_DATA_REQUIRED
 
@@ -191,6 +343,11 @@
 // Enable rain data statistics
 #define RAINDATA_EN
 
+// Keep rain data statistics in RAM retained during deep sleep instead of using the
+// RainGauge library class (constant-time queries; see src/RainHistory/RainHistory.h).
+// On RP2040, the statistics are additionally saved to flash before sleep.
+// #define RAIN_HISTORY_EN
+
 #if !defined(ARDUINO_M5STACK_Core2) && !defined(ARDUINO_M5STACK_CORE2)
 // Enable battery / supply voltage measurement
 // Note: For M5Stack Core2 use 'float batVoltage = M5.Axp.GetBatVoltage();'
@@ -204,17 +361,33 @@
 // Notes:
 // * BLE requires a lot of program memory!
 // * ESP32-S2 does not provide BLE!
-#if !defined(ARDUINO_ADAFRUIT_FEATHER_ESP32S2) && !defined(ARDUINO_ARCH_RP2040)
+// * Not available in the host build (extras/host)
+#if !defined(ARDUINO_ADAFRUIT_FEATHER_ESP32S2) && !defined(ARDUINO_ARCH_RP2040) && !defined(HOST_BUILD)
 // #define MITHERMOMETER_EN
 #define THEENGSDECODER_EN
 #endif
 
+// BLE scan options (THEENGSDECODER_EN)
+// * BLE_SCAN_PASSIVE_EN:  passive scan - no scan requests are sent; sufficient
+//                         for sensors providing all data in the advertisement
+//                         (e.g. ATC1441/pvvx custom firmware)
+// * BLE_SCAN_ADAPTIVE_EN: scan duration (max. BLE_SCAN_TIME) and scan window are
+//                         adapted to the time needed to find the known sensors
+//                         in previous scans
+// #define BLE_SCAN_PASSIVE_EN
+// #define BLE_SCAN_ADAPTIVE_EN
+
 // Enable Bresser Soil Temperature/Moisture Sensor
 #define SOILSENSOR_EN
 
 // Enable Bresser Lightning Sensor
 #define LIGHTNINGSENSOR_EN
 
+// Enable lightning event history - strike events (time, strikes, distance) are kept in RAM
+// retained during deep sleep and sent on FPort 9 after lightning activity; events which do
+// not fit into the list are counted only (see src/LightningHistory/LightningHistory.h)
+// #define LIGHTNING_HISTORY_EN
+
 // Enter your time zone (https://remotemonitoringsystems.ca/time-zone-abbreviations.php)
 const char *TZ_INFO = "CET-1CEST-2,M3.5.0/02:00:00,M10.5.0/03:00:00";
 
@@ -320,6 +493,8 @@ const uint8_t UBATT_SAMPLES = 10;
 #define BLE_SCAN_TIME 31
 
 // List of known sensors' BLE addresses
+// (THEENGSDECODER_EN: max. BLE_SENSORS_MAX (32) sensors, see src/BleSensors/BleSensors.h;
+// the first valid sensor in this list provides the indoor temperature/humidity)
 #define KNOWN_BLE_ADDRESSES \
     {                       \
         "a4:c1:38:b8:1f:7f" \
@@ -0,0 +1,179 @@
+///////////////////////////////////////////////////////////////////////////////
+// HostNet.cpp
+//
+// Host (Linux) build - built-in network server
+//
+// Built-in: ideal network - every frame is received; join requests are accepted
+// in RX1, confirmed uplinks and DeviceTimeReq are answered in RX1. Unconfirmed
+// uplinks without MAC commands end after the RX2 window. No duty cycle
+// limitation, no ADR and no application downlinks.
+//
+// Simulation mode (--sim): each frame is written to stdout and the result of the
+// transmission (incl. duty cycle delay, ACK, ADR and downlinks) is read from stdin
+// - the network server is simulated by scripts/lorawan_sim.py.
+//
+// Node -> network (one line per frame):
+//   UP t=<ms> join=<0|1> dr=<DR> fcnt=<n> confirmed=<0|1> port=<n> len=<n>
+//      data=<hex> time_req=<0|1> attempt=<n>
+// Network -> node:
+//   TX start=<ms> done=<ms> ok=<0|1> snr=<dB> dr=<DR|-1> port=<n> data=<hex>
+//      time=<ms|0>
+// (all times are simulation times in ms since the epoch)
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//          Added network simulation mode (--sim, see scripts/lorawan_sim.py)
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "host.h"
+#include <arduino_lmic.h>
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define NET_SNR             8       //!< SNR of downlinks [dB]
+#define NET_RX2_DR          3       //!< RX2 data rate (TTN EU868)
+#define NET_RX_SYMS         8       //!< receive window timeout [symbols]
+#define NET_LINE_MAX        1024    //!< max. line length (simulation mode)
+
+/// Time-on-air in ms
+static int64_t airtimeMs(rps_t rps, uint8_t plen)
+{
+    return osticks2ms(calcAirTime(rps, plen));
+}
+
+/// Read line from stdin - unbuffered, i.e. nothing is lost when the process terminates
+static bool readLine(char *buf, size_t size)
+{
+    size_t n = 0;
+
+    while (n + 1 < size) {
+        if (read(STDIN_FILENO, &buf[n], 1) != 1) {
+            return false;
+        }
+        if (buf[n] == '\n') {
+            break;
+        }
+        n++;
+    }
+    buf[n] = '\0';
+    return true;
+}
+
+/// Get value of key=<value> in line
+static const char *getValue(const char *line, const char *key)
+{
+    size_t len = strlen(key);
+
+    for (const char *p = line; (p = strstr(p, key)) != NULL; p += len) {
+        if (((p == line) || (p[-1] == ' ')) && (p[len] == '=')) {
+            return &p[len + 1];
+        }
+    }
+    return NULL;
+}
+
+/// Pass frame to external network server
+static void simTransmit(const HostTxS &tx, HostRxS &rx)
+{
+    char line[NET_LINE_MAX];
+    const char *val;
+
+    printf("UP t=%lld join=%d dr=%u fcnt=%u confirmed=%d port=%u len=%u data=",
+           (long long)tx.t_ms, tx.join, tx.dr, tx.fcnt, tx.confirmed, tx.port, tx.len);
+    for (int i = 0; i < tx.len; i++) {
+        printf("%02X", tx.data[i]);
+    }
+    printf(" time_req=%d attempt=%u\n", tx.time_req, tx.attempt);
+    fflush(stdout);
+
+    if (!readLine(line, sizeof(line)) || (strncmp(line, "TX ", 3) != 0)) {
+        fprintf(stderr, "host: no response from network server\n");
+        _exit(4);
+    }
+    rx = HostRxS();
+    rx.start_ms = ((val = getValue(line, "start"))) ? strtoll(val, NULL, 10) : tx.t_ms;
+    rx.done_ms  = ((val = getValue(line, "done")))  ? strtoll(val, NULL, 10) : rx.start_ms;
+    rx.ok       = ((val = getValue(line, "ok")))    ? (atoi(val) != 0) : false;
+    rx.snr      = ((val = getValue(line, "snr")))   ? atoi(val) : 0;
+    rx.dr       = ((val = getValue(line, "dr")))    ? atoi(val) : -1;
+    rx.port     = ((val = getValue(line, "port")))  ? atoi(val) : 0;
+    rx.time_ms  = ((val = getValue(line, "time")))  ? strtoll(val, NULL, 10) : 0;
+    if ((val = getValue(line, "data"))) {
+        while ((rx.len < sizeof(rx.data)) && isxdigit(val[0]) && isxdigit(val[1])) {
+            char hex[3] = {val[0], val[1], '\0'};
+            rx.data[rx.len++] = (uint8_t)strtoul(hex, NULL, 16);
+            val += 2;
+        }
+    }
+    if (rx.port == 0) {
+        rx.len = 0;
+    }
+}
+
+void hostNetTransmit(const HostTxS &tx, HostRxS &rx)
+{
+    if (host->sim) {
+        simTransmit(tx, rx);
+        return;
+    }
+
+    uint8_t plen = tx.join ? 23 : (13 + tx.len + (tx.time_req ? 1 : 0));
+    int64_t end  = tx.t_ms + airtimeMs(updr2rps(tx.dr), plen);
+    int64_t rx1  = end + (tx.join ? 5000 : 1000);
+
+    rx = HostRxS();
+    rx.start_ms = tx.t_ms;
+    rx.snr      = NET_SNR;
+    rx.dr       = -1;
+
+    if (tx.join) {
+        // join accept
+        rx.ok      = true;
+        rx.done_ms = rx1 + airtimeMs(dndr2rps(tx.dr), 17);
+    } else if (tx.confirmed || tx.time_req) {
+        // ACK and/or DeviceTimeAns (6 bytes) in RX1
+        rx.ok      = tx.confirmed;
+        rx.done_ms = rx1 + airtimeMs(dndr2rps(tx.dr), 13 + (tx.time_req ? 6 : 0));
+        if (tx.time_req) {
+            rx.time_ms = end;
+        }
+    } else {
+        // nothing received in RX1/RX2
+        rx.done_ms = rx1 + 1000 + osticks2ms(us2osticks((int64_t)NET_RX_SYMS << (getSf(dndr2rps(NET_RX2_DR)) + 6 + 3)));
+    }
+}
@@ -0,0 +1,152 @@
+///////////////////////////////////////////////////////////////////////////////
+// host.cpp
+//
+// Host (Linux) build - virtual time and deep sleep
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "host.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define HOST_IDLE_STEP_US   10000   //!< time skipped per loop() if no LMIC job is pending [us]
+
+// Section "rtc_data" (RTC_DATA_ATTR) - provided by the linker
+extern "C" {
+    extern uint8_t __start_rtc_data[];
+    extern uint8_t __stop_rtc_data[];
+}
+
+struct HostSharedS *host;
+
+static struct timespec bootTime;    //!< real time at wake-up
+static uint64_t        skipped;     //!< time skipped since wake-up [us]
+static uint32_t        rng;         //!< random number generator state
+
+void hostBoot(void)
+{
+    clock_gettime(CLOCK_MONOTONIC, &bootTime);
+    skipped = 0;
+    rng = (host->seed ^ (host->cycle * 0x9E3779B9UL)) | 1;
+}
+
+uint64_t hostMicros(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    int64_t real_us = (int64_t)(now.tv_sec - bootTime.tv_sec) * 1000000 + (now.tv_nsec - bootTime.tv_nsec) / 1000;
+    return (uint64_t)real_us + skipped;
+}
+
+void hostSkip(uint64_t us)
+{
+    skipped += us;
+}
+
+int64_t hostNowMs(void)
+{
+    return host->boot_ms + (int64_t)(hostMicros() / 1000);
+}
+
+void hostSkipTo(int64_t t_ms)
+{
+    int64_t now = hostNowMs();
+
+    if (t_ms > now) {
+        hostSkip((uint64_t)(t_ms - now) * 1000);
+    }
+}
+
+int64_t hostRtcMs(void)
+{
+    return hostNowMs() + host->rtc_offset_ms;
+}
+
+void hostRtcSet(int64_t t_ms)
+{
+    host->rtc_offset_ms = t_ms - hostNowMs();
+}
+
+uint32_t hostRandom(void)
+{
+    // xorshift32
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+void hostDeepSleep(uint64_t us)
+{
+    size_t len = __stop_rtc_data - __start_rtc_data;
+
+    if (len > HOST_RTC_MEM_MAX) {
+        fprintf(stderr, "host: section rtc_data (%zu bytes) exceeds HOST_RTC_MEM_MAX\n", len);
+        _exit(2);
+    }
+    host->awake_us = hostMicros();
+    host->sleep_us = us;
+    host->rtc_len  = len;
+    memcpy(host->rtc_mem, __start_rtc_data, len);
+    fflush(stdout);
+    fflush(stderr);
+    _exit(0);
+}
+
+void hostRestore(void)
+{
+    if (host->rtc_len == (size_t)(__stop_rtc_data - __start_rtc_data)) {
+        memcpy(__start_rtc_data, host->rtc_mem, host->rtc_len);
+    }
+}
+
+void hostIdle(void)
+{
+    uint64_t next;
+    uint64_t now = hostMicros();
+
+    if (hostLmicNextJob(&next)) {
+        if (next > now) {
+            hostSkip(next - now);
+        }
+    } else {
+        hostSkip(HOST_IDLE_STEP_US);
+    }
+}
@@ -0,0 +1,222 @@
+///////////////////////////////////////////////////////////////////////////////
+// host.h
+//
+// Host (Linux) build - virtual time, deep sleep and simulated network
+//
+// The sketch is run in a child process per wake cycle (setup() and loop()
+// until ESP.deepSleep()). Variables with RTC_DATA_ATTR are placed in the
+// section "rtc_data" which is handed over to the next cycle like the ESP32's
+// RTC RAM; flash memory (Preferences) and the RTC (system time) are kept in
+// shared memory.
+//
+// Time:
+// - Simulation time is the "true" time in ms since the epoch
+// - millis()/micros() are the real execution time since boot plus the time
+//   skipped by delay(), light sleep, sensor reception and waiting for the LMIC
+// - The node's RTC is simulation time plus an offset (the ESP32's RTC
+//   starts at 0 after power-on)
+//
+// Network (see HostNet.cpp):
+// - built-in: every frame is received and acknowledged, network time is provided
+// - simulation mode (--sim): frames are passed to an external network server
+//   via stdout/stdin, e.g. scripts/lorawan_sim.py
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//          Added network simulation mode (--sim, see scripts/lorawan_sim.py)
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(HOST_H)
+#define HOST_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define HOST_RTC_MEM_MAX    8192    //!< max. size of section "rtc_data" [bytes]
+#define HOST_NVS_ENTRIES    64      //!< max. number of Preferences keys
+#define HOST_NVS_SIZE_MAX   320     //!< max. size of a Preferences value [bytes]
+#define HOST_FRAME_MAX      255     //!< max. LoRaWAN payload size [bytes]
+
+/// Preferences entry (flash memory)
+struct HostNvsS {
+    char     ns[16];                        //!< namespace (empty: free entry)
+    char     key[16];                       //!< key
+    uint16_t len;                           //!< value size
+    uint8_t  data[HOST_NVS_SIZE_MAX];       //!< value
+};
+
+/// State shared between wake cycles (child processes) and the driver
+struct HostSharedS {
+    // Configuration
+    int64_t  start_ms;                      //!< simulation time at power-on
+    uint16_t battery_mv;                    //!< battery voltage
+    float    sensor_loss;                   //!< probability of a lost sensor message
+    uint8_t  datarate;                      //!< initial data rate
+    uint32_t seed;                          //!< random seed
+    bool     sim;                           //!< network simulation mode (external network server)
+
+    // Current cycle
+    uint32_t cycle;                         //!< wake cycle number
+    int64_t  boot_ms;                       //!< simulation time at wake-up
+
+    // Retained across wake cycles
+    int64_t  rtc_offset_ms;                 //!< node RTC - simulation time
+    struct HostNvsS nvs[HOST_NVS_ENTRIES];  //!< flash memory
+
+    // Result of cycle (set by hostDeepSleep())
+    uint64_t awake_us;                      //!< time since wake-up
+    uint64_t sleep_us;                      //!< deep sleep duration
+    uint32_t rtc_len;                       //!< size of retained data
+    uint8_t  rtc_mem[HOST_RTC_MEM_MAX];     //!< retained data
+
+    // Statistics (accumulated)
+    uint32_t nvs_writes;                    //!< Preferences write/erase operations
+    uint32_t joins;                         //!< successful joins
+    uint32_t uplinks;                       //!< completed uplinks
+    uint32_t tx_count;                      //!< transmissions (incl. join requests and retries)
+    uint32_t acks;                          //!< acknowledged confirmed uplinks
+    uint64_t tx_us;                         //!< time-on-air
+    uint64_t sensor_us;                     //!< weather sensor data reception
+};
+
+/// Frame to be transmitted
+struct HostTxS {
+    int64_t  t_ms;                          //!< requested start of transmission (simulation time)
+    bool     join;                          //!< join request
+    uint8_t  dr;                            //!< data rate
+    uint8_t  attempt;                       //!< transmission attempt (1...)
+    uint32_t fcnt;                          //!< uplink frame counter
+    bool     confirmed;                     //!< confirmed uplink
+    uint8_t  port;                          //!< FPort
+    uint8_t  len;                           //!< payload size
+    const uint8_t *data;                    //!< payload
+    bool     time_req;                      //!< DeviceTimeReq MAC command
+};
+
+/// Result of transmission and receive windows
+struct HostRxS {
+    int64_t  start_ms;                      //!< actual start of transmission (duty cycle)
+    int64_t  done_ms;                       //!< end of receive windows
+    bool     ok;                            //!< join accept / acknowledgement received
+    int8_t   snr;                           //!< SNR of downlink [dB]
+    int      dr;                            //!< new data rate (LinkADRReq) or -1
+    uint8_t  port;                          //!< FPort of downlink (0: none)
+    uint8_t  len;                           //!< downlink payload size
+    uint8_t  data[HOST_FRAME_MAX];          //!< downlink payload
+    int64_t  time_ms;                       //!< network time at end of uplink (DeviceTimeAns) or 0
+};
+
+extern struct HostSharedS *host;            //!< shared state
+
+/*!
+ * \brief Initialize time base after wake-up (child process).
+ */
+void hostBoot(void);
+
+/*!
+ * \brief Time since wake-up in us (execution time + skipped time).
+ */
+uint64_t hostMicros(void);
+
+/*!
+ * \brief Skip time (e.g. delay(), light sleep, waiting for a radio message).
+ *
+ * \param us    duration in us
+ */
+void hostSkip(uint64_t us);
+
+/*!
+ * \brief Simulation time in ms since the epoch.
+ */
+int64_t hostNowMs(void);
+
+/*!
+ * \brief Skip time until simulation time is reached.
+ *
+ * \param t_ms  simulation time in ms since the epoch
+ */
+void hostSkipTo(int64_t t_ms);
+
+/*!
+ * \brief Node RTC in ms since the epoch.
+ */
+int64_t hostRtcMs(void);
+
+/*!
+ * \brief Set node RTC.
+ *
+ * \param t_ms  time in ms since the epoch
+ */
+void hostRtcSet(int64_t t_ms);
+
+/*!
+ * \brief Random number (seeded per wake cycle).
+ */
+uint32_t hostRandom(void);
+
+/*!
+ * \brief End of wake cycle - save retained data and terminate child process.
+ *
+ * \param us    deep sleep duration
+ */
+void hostDeepSleep(uint64_t us) __attribute__((noreturn));
+
+/*!
+ * \brief Restore retained data saved by hostDeepSleep() (driver process).
+ */
+void hostRestore(void);
+
+/*!
+ * \brief Idle - skip time until the next LMIC job is due.
+ */
+void hostIdle(void);
+
+/*!
+ * \brief Get time of next LMIC job (see arduino_lmic.cpp).
+ *
+ * \param t_us  time since wake-up in us
+ *
+ * \returns true if a job is pending
+ */
+bool hostLmicNextJob(uint64_t *t_us);
+
+/*!
+ * \brief Send frame and get result of receive windows (see HostNet.cpp).
+ *
+ * \param tx    frame
+ * \param rx    result
+ */
+void hostNetTransmit(const struct HostTxS &tx, struct HostRxS &rx);
+
+#endif // HOST_H
@@ -0,0 +1,350 @@
+///////////////////////////////////////////////////////////////////////////////
+// host_main.cpp
+//
+// Host (Linux) build - benchmark driver
+//
+// Runs the sketch for a number of simulated wake cycles. Each wake cycle is
+// executed in a child process (fork()), i.e. all variables are initialized as
+// after a reset - except the section "rtc_data" (RTC_DATA_ATTR), which is
+// handed over from the previous cycle, and the flash memory (Preferences).
+// Waiting times (sensor messages, delay(), LMIC jobs, deep sleep) are skipped,
+// execution times are measured in real time.
+//
+// Usage:
+//   bws_host [--cycles <n>] [--days <n>] [--dr <0..5>] [--seed <n>] [--battery <mV>]
+//            [--sensor-loss <0..1>] [--start <unix time>] [--sim]
+//            [--bench <n>]
+//
+//   --days: run until the simulated time has elapsed (instead of 1000 cycles)
+//   --sim:  network simulation mode - frames are passed to an external network
+//           server via stdout/stdin (see HostNet.cpp), the start and end of each
+//           wake cycle are reported as
+//           BOOT t=<ms> cycle=<n>
+//           SLEEP t=<ms> awake=<us> duration=<us> sensor=<us>
+//           (sketch log output is written to stderr)
+//
+// Output:
+//   Cycle summary, LoRaWAN/flash statistics and - with PHASE_TIMER_EN -
+//   the execution times of the wake cycle phases (see src/PhaseTimer)
+//
+//   Sensor lookup and payload encoding take less than the resolution of
+//   micros(); they are timed as a block of <n> iterations instead
+//   (default: 100000, 0: disabled).
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//          Added --days and network simulation mode (--sim)
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "host.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <WeatherSensor.h>
+#include <LoraMessage.h>
+
+#ifdef PHASE_TIMER_EN
+#include "../../src/PhaseTimer/PhaseTimer.h"
+
+extern phase_stats_t phaseStats[PHASE_NUM];
+#endif
+
+#define DEFAULT_CYCLES      1000
+#define DEFAULT_START       1792195200  //!< 2026-10-17 00:00:00 UTC
+#define DEFAULT_BATTERY_MV  4000
+#define AWAKE_MAX_S         3600        //!< max. awake time per cycle [s]
+#define DEFAULT_BENCH       100000      //!< iterations of block timing
+
+extern WeatherSensor weatherSensor;
+
+void setup(void);
+void loop(void);
+
+/// Execute wake cycle (child process)
+static void runCycle(void)
+{
+    hostBoot();
+    setup();
+    while (hostMicros() < (uint64_t)AWAKE_MAX_S * 1000000) {
+        loop();
+        hostIdle();
+    }
+    fprintf(stderr, "cycle %u: no deep sleep within %d s\n", host->cycle, AWAKE_MAX_S);
+    fflush(stderr);
+    _exit(3);
+}
+
+/// Monotonic clock in ns
+static uint64_t nowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/// Sensor lookup as in cSensor::doUplink()
+__attribute__((noinline)) static void benchLookup(int &ws, int &s1, int &ls)
+{
+    ws = weatherSensor.findType(SENSOR_TYPE_WEATHER0);
+    if (ws < 0) {
+        ws = weatherSensor.findType(SENSOR_TYPE_WEATHER1);
+    }
+    s1 = weatherSensor.findType(SENSOR_TYPE_SOIL, 1);
+    ls = weatherSensor.findType(SENSOR_TYPE_LIGHTNING);
+}
+
+/// Payload encoding of weather, soil and lightning sensor data as in cSensor::doUplink()
+__attribute__((noinline)) static int benchEncode(uint8_t *buf, int ws, int s1, int ls)
+{
+    LoraEncoder encoder(buf);
+    const Sensor &w = weatherSensor.sensor[ws];
+    const Sensor &s = weatherSensor.sensor[s1];
+    const Sensor &l = weatherSensor.sensor[ls];
+
+    encoder.writeBitmap(0, 0, 0, 0, 0, 0, 0, 0);
+    encoder.writeBitmap(0, 0, l.valid, l.battery_ok, s.valid, s.battery_ok, w.valid, w.battery_ok);
+    encoder.writeTemperature(w.w.temp_ok ? w.w.temp_c : -30);
+    encoder.writeUint8(w.w.humidity_ok ? w.w.humidity : 0);
+    encoder.writeUint16(w.w.wind_gust_meter_sec_fp1);
+    encoder.writeUint16(w.w.wind_avg_meter_sec_fp1);
+    encoder.writeUint16(w.w.wind_direction_deg_fp1);
+    encoder.writeRawFloat(w.w.rain_ok ? w.w.rain_mm : 0);
+    encoder.writeUint16(4000);
+    encoder.writeTemperature(s.soil.temp_c);
+    encoder.writeUint8(s.soil.moisture);
+    encoder.writeRawFloat(0);
+    encoder.writeRawFloat(0);
+    encoder.writeRawFloat(0);
+    encoder.writeRawFloat(0);
+    encoder.writeUnixtime(1792195200);
+    encoder.writeUint16(l.lgt.strike_count);
+    encoder.writeUint8(l.lgt.distance_km);
+    return encoder.getLength();
+}
+
+/*!
+ * \brief Time sensor lookup and payload encoding as blocks of n iterations.
+ *
+ * \param n            number of iterations
+ * \param lookup_ns    average sensor lookup time [ns]
+ * \param encode_ns    average payload encoding time [ns]
+ */
+static void runBench(uint32_t n, double &lookup_ns, double &encode_ns)
+{
+    static uint8_t buf[HOST_FRAME_MAX];
+    volatile int sink = 0;
+    int ws, s1, ls;
+
+    weatherSensor.genMessage(0, 0x01326577, SENSOR_TYPE_SOIL, 1);
+    weatherSensor.genMessage(1, 0x00004711, SENSOR_TYPE_LIGHTNING);
+    weatherSensor.genMessage(2, 0x39582376, SENSOR_TYPE_WEATHER1);
+
+    uint64_t t0 = nowNs();
+    for (uint32_t i = 0; i < n; i++) {
+        benchLookup(ws, s1, ls);
+        // Prevent the compiler from hoisting the lookup out of the loop
+        asm volatile("" ::: "memory");
+    }
+    uint64_t t1 = nowNs();
+    sink = ws + s1 + ls;
+
+    for (uint32_t i = 0; i < n; i++) {
+        sink = benchEncode(buf, ws, s1, ls);
+        asm volatile("" ::: "memory");
+    }
+    uint64_t t2 = nowNs();
+    (void)sink;
+
+    lookup_ns = (double)(t1 - t0) / n;
+    encode_ns = (double)(t2 - t1) / n;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "Usage: %s [--cycles <n>] [--days <n>] [--dr <0..5>] [--seed <n>] [--battery <mV>]\n"
+                    "          [--sensor-loss <0..1>] [--start <unix time>] [--sim]\n"
+                    "          [--bench <n>]\n", prog);
+    exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t cycles = 0;
+    double   days   = 0;
+    uint32_t bench  = DEFAULT_BENCH;
+    int64_t  start  = DEFAULT_START;
+
+    host = (HostSharedS *)mmap(NULL, sizeof(HostSharedS), PROT_READ | PROT_WRITE,
+                               MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (host == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+    memset(host, 0, sizeof(HostSharedS));
+    host->battery_mv = DEFAULT_BATTERY_MV;
+    host->datarate   = 5;
+    host->seed       = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--sim") == 0) {
+            host->sim = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+        }
+        const char *arg = argv[i];
+        const char *val = argv[++i];
+        if (strcmp(arg, "--cycles") == 0) {
+            cycles = strtoul(val, NULL, 0);
+        } else if (strcmp(arg, "--days") == 0) {
+            days = strtod(val, NULL);
+        } else if (strcmp(arg, "--dr") == 0) {
+            host->datarate = (uint8_t)strtoul(val, NULL, 0);
+        } else if (strcmp(arg, "--seed") == 0) {
+            host->seed = strtoul(val, NULL, 0);
+        } else if (strcmp(arg, "--battery") == 0) {
+            host->battery_mv = (uint16_t)strtoul(val, NULL, 0);
+        } else if (strcmp(arg, "--sensor-loss") == 0) {
+            host->sensor_loss = strtof(val, NULL);
+        } else if (strcmp(arg, "--start") == 0) {
+            start = strtoll(val, NULL, 0);
+        } else if (strcmp(arg, "--bench") == 0) {
+            bench = strtoul(val, NULL, 0);
+        } else {
+            usage(argv[0]);
+        }
+    }
+    if (host->datarate > 5) {
+        usage(argv[0]);
+    }
+    if (cycles == 0) {
+        cycles = (days > 0) ? UINT32_MAX : DEFAULT_CYCLES;
+    }
+    int64_t end_ms = start * 1000 + (int64_t)(days * 86400000.0);
+
+    // The RTC starts at the epoch after power-on
+    host->start_ms      = start * 1000;
+    host->boot_ms       = host->start_ms;
+    host->rtc_offset_ms = -host->start_ms;
+
+    uint64_t awake_sum = 0;
+    uint64_t awake_min = UINT64_MAX;
+    uint64_t awake_max = 0;
+    uint64_t sensor_us = 0;
+    uint32_t c;
+
+    for (c = 0; (c < cycles) && ((days <= 0) || (host->boot_ms < end_ms)); c++) {
+        int status;
+
+        host->cycle = c;
+        if (host->sim) {
+            printf("BOOT t=%lld cycle=%u\n", (long long)host->boot_ms, c);
+        }
+        fflush(stdout);
+        fflush(stderr);
+        pid_t pid = fork();
+        if (pid < 0) {
+            perror("fork");
+            return 1;
+        }
+        if (pid == 0) {
+            runCycle();
+        }
+        if ((waitpid(pid, &status, 0) < 0) || !WIFEXITED(status) || (WEXITSTATUS(status) != 0)) {
+            fprintf(stderr, "cycle %u failed (status 0x%x)\n", c, status);
+            return 1;
+        }
+        hostRestore();
+        if (host->sim) {
+            printf("SLEEP t=%lld awake=%llu duration=%llu sensor=%llu\n",
+                   (long long)(host->boot_ms + (int64_t)(host->awake_us / 1000)),
+                   (unsigned long long)host->awake_us, (unsigned long long)host->sleep_us,
+                   (unsigned long long)(host->sensor_us - sensor_us));
+            sensor_us = host->sensor_us;
+        }
+
+        awake_sum += host->awake_us;
+        awake_min  = (host->awake_us < awake_min) ? host->awake_us : awake_min;
+        awake_max  = (host->awake_us > awake_max) ? host->awake_us : awake_max;
+        host->boot_ms += (int64_t)((host->awake_us + host->sleep_us) / 1000);
+    }
+    cycles = c;
+    if (cycles == 0) {
+        return 0;
+    }
+
+    days = (host->boot_ms - host->start_ms) / 86400000.0;
+    printf("Wake cycles:       %u (%.2f days simulated)\n", cycles, days);
+    printf("Awake time [ms]:   avg %.1f min %.1f max %.1f\n",
+           awake_sum / 1000.0 / cycles, awake_min / 1000.0, awake_max / 1000.0);
+    printf("Sensor rx [ms]:    avg %.1f\n", host->sensor_us / 1000.0 / cycles);
+    printf("Joins:             %u\n", host->joins);
+    printf("Uplinks:           %u (%u transmissions, %u ACKs)\n", host->uplinks, host->tx_count, host->acks);
+    printf("Time-on-air [ms]:  %.1f per uplink\n", host->uplinks ? host->tx_us / 1000.0 / host->uplinks : 0.0);
+    printf("Flash writes:      %u (%.1f per day)\n", host->nvs_writes, (days > 0) ? host->nvs_writes / days : 0.0);
+
+    #ifdef PHASE_TIMER_EN
+        printf("\n%-16s %8s %10s %10s %10s\n", "Phase", "Count", "Min [us]", "Avg [us]", "Max [us]");
+        for (int p = 0; p < PHASE_NUM; p++) {
+            const phase_stats_t *s = &phaseStats[p];
+            if (s->count == 0) {
+                continue;
+            }
+            if (bench && ((p == PHASE_SENSOR_LOOKUP) || (p == PHASE_ENCODE))) {
+                // Below timer resolution - see block timing
+                continue;
+            }
+            printf("%-16s %8u %10u %10.1f %10u\n", PhaseTimer::name((phase_t)p), s->count,
+                   s->min_us, (double)s->sum_us / s->count, s->max_us);
+        }
+    #endif
+
+    if (bench) {
+        double lookup_ns, encode_ns;
+
+        runBench(bench, lookup_ns, encode_ns);
+        printf("\nBlock timing (%u iterations):\n", bench);
+        printf("%-16s %10.1f ns\n", "sensor lookup", lookup_ns);
+        printf("%-16s %10.1f ns\n", "encode", encode_ns);
+    }
+    return 0;
+}
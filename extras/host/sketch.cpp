@@ -0,0 +1,53 @@
+///////////////////////////////////////////////////////////////////////////////
+// sketch.cpp
+//
+// Host (Linux) build - sketch wrapper
+//
+// The Arduino builder generates prototypes for all functions of the sketch
+// before compiling it as C++ - this is done manually here.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <Arduino.h>
+
+void prepareSleep(void);
+void printDateTime(void);
+int64_t epochMs(void);
+bool uplinkPending(void);
+void ReceiveCb(void *pCtx, uint8_t uPort, const uint8_t *pBuffer, size_t nBuffer);
+void UserRequestNetworkTimeCb(void *pVoidUserUTCTime, int flagSuccess);
+
+#include "../../BresserWeatherSensorTTN.ino"
@@ -0,0 +1,135 @@
+///////////////////////////////////////////////////////////////////////////////
+// Arduino.cpp
+//
+// Host (Linux) build - Arduino core stub (ESP32 flavour)
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <Arduino.h>
+#include "../host.h"
+
+HardwareSerial Serial;
+EspClass ESP;
+
+void hostLog(char level, const char *file, int line, const char *func, const char *fmt, ...)
+{
+    va_list args;
+    const char *base = strrchr(file, '/');
+
+    fprintf(stderr, "[%6u][%c][%s:%d] %s(): ", millis(), level, base ? base + 1 : file, line, func);
+    va_start(args, fmt);
+    vfprintf(stderr, fmt, args);
+    va_end(args);
+    fputc('\n', stderr);
+}
+
+size_t Print::printf(const char *fmt, ...)
+{
+    char buf[256];
+    va_list args;
+
+    va_start(args, fmt);
+    int len = vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    if (len < 0) {
+        return 0;
+    }
+    return write((const uint8_t *)buf, ((size_t)len < sizeof(buf)) ? (size_t)len : sizeof(buf) - 1);
+}
+
+uint32_t millis(void)
+{
+    return (uint32_t)(hostMicros() / 1000);
+}
+
+uint32_t micros(void)
+{
+    return (uint32_t)hostMicros();
+}
+
+void delay(uint32_t ms)
+{
+    hostSkip((uint64_t)ms * 1000);
+}
+
+void delayMicroseconds(uint32_t us)
+{
+    hostSkip(us);
+}
+
+void yield(void)
+{
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    (void)pin;
+    (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+    (void)pin;
+    (void)val;
+}
+
+int digitalRead(uint8_t pin)
+{
+    (void)pin;
+    return LOW;
+}
+
+uint16_t analogRead(uint8_t pin)
+{
+    return (uint16_t)(analogReadMilliVolts(pin) * 4095 / 3300);
+}
+
+uint32_t analogReadMilliVolts(uint8_t pin)
+{
+    (void)pin;
+    // Battery voltage via 1:2 voltage divider (see UBATT_DIV in BresserWeatherSensorTTNCfg.h)
+    return host->battery_mv / 2;
+}
+
+void EspClass::deepSleep(uint64_t time_us)
+{
+    hostDeepSleep(time_us);
+}
+
+void EspClass::restart(void)
+{
+    hostDeepSleep(0);
+}
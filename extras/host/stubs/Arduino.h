@@ -0,0 +1,187 @@
+///////////////////////////////////////////////////////////////////////////////
+// Arduino.h
+//
+// Host (Linux) build - Arduino core stub (ESP32 flavour)
+//
+// Time functions use the virtual time base of the host build (see ../host.h),
+// log_*() messages are written to stderr with the format of the ESP32 core,
+// RTC_DATA_ATTR places variables in the section which is retained across
+// wake cycles and ESP.deepSleep() terminates the current wake cycle.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(ARDUINO_H)
+#define ARDUINO_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+typedef uint8_t byte;
+
+#define HIGH    1
+#define LOW     0
+#define INPUT   0x01
+#define OUTPUT  0x03
+
+/// Variables retained across wake cycles (ESP32: RTC RAM)
+#define RTC_DATA_ATTR   __attribute__((section("rtc_data")))
+
+// Log levels and messages (see esp32-hal-log.h)
+#define ARDUHAL_LOG_LEVEL_NONE      0
+#define ARDUHAL_LOG_LEVEL_ERROR     1
+#define ARDUHAL_LOG_LEVEL_WARN      2
+#define ARDUHAL_LOG_LEVEL_INFO      3
+#define ARDUHAL_LOG_LEVEL_DEBUG     4
+#define ARDUHAL_LOG_LEVEL_VERBOSE   5
+
+#if !defined(CORE_DEBUG_LEVEL)
+    #define CORE_DEBUG_LEVEL ARDUHAL_LOG_LEVEL_NONE
+#endif
+
+void hostLog(char level, const char *file, int line, const char *func, const char *fmt, ...)
+    __attribute__((format(printf, 5, 6)));
+
+#if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_ERROR
+    #define log_e(format, ...) hostLog('E', __FILE__, __LINE__, __FUNCTION__, format, ##__VA_ARGS__)
+#else
+    #define log_e(format, ...) do {} while (0)
+#endif
+#if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_WARN
+    #define log_w(format, ...) hostLog('W', __FILE__, __LINE__, __FUNCTION__, format, ##__VA_ARGS__)
+#else
+    #define log_w(format, ...) do {} while (0)
+#endif
+#if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_INFO
+    #define log_i(format, ...) hostLog('I', __FILE__, __LINE__, __FUNCTION__, format, ##__VA_ARGS__)
+#else
+    #define log_i(format, ...) do {} while (0)
+#endif
+#if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_DEBUG
+    #define log_d(format, ...) hostLog('D', __FILE__, __LINE__, __FUNCTION__, format, ##__VA_ARGS__)
+#else
+    #define log_d(format, ...) do {} while (0)
+#endif
+#if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_VERBOSE
+    #define log_v(format, ...) hostLog('V', __FILE__, __LINE__, __FUNCTION__, format, ##__VA_ARGS__)
+#else
+    #define log_v(format, ...) do {} while (0)
+#endif
+
+// Time (32 bit - same overflow behaviour as on the target)
+uint32_t millis(void);
+uint32_t micros(void);
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield(void);
+
+// GPIO/ADC - no hardware
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+uint16_t analogRead(uint8_t pin);
+uint32_t analogReadMilliVolts(uint8_t pin);
+
+/// Character output
+class Print {
+    public:
+        virtual ~Print() {};
+        virtual size_t write(const uint8_t *buf, size_t size) = 0;
+        size_t print(const char *s) {
+            return write((const uint8_t *)s, strlen(s));
+        };
+        size_t println(const char *s = "") {
+            return print(s) + print("\n");
+        };
+        size_t printf(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+};
+
+/// Serial port - output to stderr, no input
+class HardwareSerial : public Print {
+    public:
+        void begin(unsigned long baud) {
+            (void)baud;
+        };
+        void end(void) {};
+        void flush(void) {
+            fflush(stderr);
+        };
+        int available(void) {
+            return 0;
+        };
+        int read(void) {
+            return -1;
+        };
+        void setDebugOutput(bool enable) {
+            (void)enable;
+        };
+        operator bool() const {
+            return true;
+        };
+        size_t write(const uint8_t *buf, size_t size) override {
+            return fwrite(buf, 1, size, stderr);
+        };
+};
+
+extern HardwareSerial Serial;
+
+/// Chip specific functions
+class EspClass {
+    public:
+        /*!
+         * \brief Enter deep sleep - terminates the wake cycle.
+         *
+         * \param time_us   sleep duration
+         */
+        void deepSleep(uint64_t time_us) __attribute__((noreturn));
+
+        /*!
+         * \brief Restart - terminates the wake cycle without sleeping.
+         */
+        void restart(void) __attribute__((noreturn));
+};
+
+extern EspClass ESP;
+
+#endif // ARDUINO_H
@@ -0,0 +1,417 @@
+///////////////////////////////////////////////////////////////////////////////
+// Arduino_LoRaWAN.cpp
+//
+// Host (Linux) build - MCCI Arduino LoRaWAN library stub
+//
+// LoRaWAN protocol sequence on top of the LMIC job queue:
+// - join: EV_JOINING, join request(s) (EV_TXSTART with OP_JOINING),
+//   EV_JOINED, NetJoin(), NetSaveSessionInfo(), NetSaveSessionState()
+// - uplink: EV_TXSTART, EV_RXSTART (RX1, RX2 if nothing was received in RX1),
+//   NetTxComplete(), NetSaveSessionState(), receive callback, send done callback
+// - confirmed uplinks are retried up to TXCONF_ATTEMPTS times, the data rate is
+//   lowered before the 3rd, 5th and 7th attempt (as in the LMIC)
+// - join requests are retried, the data rate is lowered every 2nd attempt
+//
+// The receive callback is invoked on every uplink completion (with port 0 if no
+// downlink was received); the sketch relies on it to request sleep.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <Arduino_LoRaWAN.h>
+#include <Arduino_LoRaWAN_EventLog.h>
+#include "../host.h"
+
+#include <string.h>
+
+#define TXCONF_ATTEMPTS     8       //!< max. number of confirmed uplink transmissions
+#define RETRY_DELAY_MS      2000    //!< max. random delay before retransmission [ms]
+#define RX_DELAY_S          1       //!< RX1 delay (data frames) [s]
+#define JOIN_ACCEPT_DELAY_S 5       //!< RX1 delay (join accept) [s]
+#define RX2_DR              3       //!< RX2 data rate (TTN EU868)
+#define RX_SYMS             8       //!< receive window timeout [symbols]
+#define DEFAULT_NETID       0x13    //!< network ID assigned by join
+
+/// Data rate adjustment after n-th unacknowledged transmission (see LMIC)
+static const uint8_t DRADJUST[2 + TXCONF_ATTEMPTS] = {0, 0, 1, 0, 1, 0, 1, 0, 0};
+
+struct ArduinoLoRaWANHost {
+    static void txStart(osjob_t *job);
+    static void txBegin(osjob_t *job);
+    static void rxStart(osjob_t *job);
+    static void txDone(osjob_t *job);
+};
+
+static Arduino_LoRaWAN *pLoRaWAN;   //!< LoRaWAN instance
+static osjob_t  txJob;              //!< protocol sequence job
+static bool     joined;             //!< session established
+static uint8_t  attempt;            //!< transmission attempt
+static uint8_t  rxWindow;           //!< receive window (1/2)
+static ostime_t txEnd;              //!< end of transmission
+static HostTxS  tx;                 //!< frame to be transmitted
+static HostRxS  rx;                 //!< result of transmission
+
+/// Pending uplink
+static struct {
+    uint8_t  data[HOST_FRAME_MAX];
+    uint8_t  len;
+    uint8_t  port;
+    bool     confirmed;
+    Arduino_LoRaWAN::SendBufferCbFn *pDoneFn;
+    void    *pDoneCtx;
+} frame;
+
+/// Convert simulation time to local time
+static ostime_t localTime(int64_t t_ms)
+{
+    return ms2osticks(t_ms - host->boot_ms);
+}
+
+/// Lower data rate (DR0 is the lowest)
+static void lowerDR(void)
+{
+    if (LMIC.datarate > 0) {
+        LMIC.datarate--;
+    }
+}
+
+bool Arduino_LoRaWAN::begin(const lmic_pinmap &pinmap)
+{
+    AbpProvisioningInfo abp;
+    SessionState state;
+
+    (void)pinmap;
+    pLoRaWAN = this;
+    memset(&LMIC, 0, sizeof(LMIC));
+    LMIC.datarate = host->datarate;
+    joined = false;
+
+    if (GetAbpProvisioningInfo(&abp)) {
+        joined        = true;
+        LMIC.devaddr  = abp.DevAddr;
+        LMIC.netid    = abp.NetID;
+        LMIC.seqnoUp  = abp.FCntUp;
+        LMIC.seqnoDn  = abp.FCntDown;
+        if (NetGetSessionState(state) && (state.V1.Tag == kSessionStateTag_V1)) {
+            LMIC.datarate = state.V1.LinkDR;
+        }
+    }
+    return true;
+}
+
+void Arduino_LoRaWAN::loop(void)
+{
+    os_runloop_once();
+}
+
+bool Arduino_LoRaWAN::GetTxReady(void)
+{
+    return (LMIC.opmode & (OP_JOINING | OP_TXDATA | OP_TXRXPEND | OP_SHUTDOWN)) == 0;
+}
+
+bool Arduino_LoRaWAN::SendBuffer(
+    const uint8_t *pBuffer,
+    size_t nBuffer,
+    SendBufferCbFn *pDoneFn,
+    void *pDoneCtx,
+    bool fConfirmed,
+    uint8_t port)
+{
+    if (!GetTxReady() || (nBuffer > sizeof(frame.data))) {
+        return false;
+    }
+    if (!joined) {
+        OtaaProvisioningInfo otaa;
+
+        if (!GetOtaaProvisioningInfo(&otaa)) {
+            return false;
+        }
+    }
+    memcpy(frame.data, pBuffer, nBuffer);
+    frame.len       = (uint8_t)nBuffer;
+    frame.port      = port;
+    frame.confirmed = fConfirmed;
+    frame.pDoneFn   = pDoneFn;
+    frame.pDoneCtx  = pDoneCtx;
+    attempt = 0;
+
+    LMIC.opmode |= OP_TXDATA;
+    if (!joined) {
+        LMIC.opmode |= OP_JOINING;
+        DispatchEvent(EV_JOINING);
+    }
+    os_setCallback(&txJob, ArduinoLoRaWANHost::txStart);
+    return true;
+}
+
+bool Arduino_LoRaWAN::RegisterListener(ARDUINO_LORAWAN_EVENT_FN *pEventFn, void *pContext)
+{
+    if (m_nListeners >= ARDUINO_LORAWAN_MAX_LISTENERS) {
+        return false;
+    }
+    m_Listeners[m_nListeners].pEventFn = pEventFn;
+    m_Listeners[m_nListeners].pContext = pContext;
+    m_nListeners++;
+    return true;
+}
+
+void Arduino_LoRaWAN::Shutdown(void)
+{
+    LMIC_shutdown();
+}
+
+void Arduino_LoRaWAN::DispatchEvent(uint32_t event)
+{
+    for (unsigned i = 0; i < m_nListeners; i++) {
+        m_Listeners[i].pEventFn(m_Listeners[i].pContext, event);
+    }
+}
+
+void Arduino_LoRaWAN::BuildSessionState(SessionState &State)
+{
+    memset(&State, 0, sizeof(State));
+    State.V1.Tag                    = kSessionStateTag_V1;
+    State.V1.Size                   = sizeof(State.V1);
+    State.V1.Region                 = 1; // EU868
+    State.V1.LinkDR                 = LMIC.datarate;
+    State.V1.FCntUp                 = LMIC.seqnoUp;
+    State.V1.FCntDown               = LMIC.seqnoDn;
+    State.V1.Rx2Frequency           = 869525000;
+    State.V1.Rx2DataRate            = RX2_DR;
+    State.V1.RxDelay                = RX_DELAY_S;
+    State.V1.DutyCycle              = 0;
+    State.V1.Channels.Tag           = 1;
+    State.V1.Channels.Size          = sizeof(State.V1.Channels);
+    State.V1.Channels.ChannelMap    = 0x0007;
+    State.V1.Channels.UplinkFreq[0] = 868100000;
+    State.V1.Channels.UplinkFreq[1] = 868300000;
+    State.V1.Channels.UplinkFreq[2] = 868500000;
+}
+
+// Pass frame to the network and wait for the start of transmission
+void ArduinoLoRaWANHost::txStart(osjob_t *job)
+{
+    memset(&tx, 0, sizeof(tx));
+    tx.t_ms      = hostNowMs();
+    tx.join      = !joined;
+    tx.dr        = LMIC.datarate;
+    tx.attempt   = ++attempt;
+    tx.fcnt      = LMIC.seqnoUp;
+    tx.confirmed = frame.confirmed;
+    tx.port      = frame.port;
+    tx.len       = frame.len;
+    tx.data      = frame.data;
+    tx.time_req  = joined && hostLmicTimeRequested();
+
+    hostNetTransmit(tx, rx);
+    os_setTimedCallback(job, localTime(rx.start_ms), txBegin);
+}
+
+// Start of transmission
+void ArduinoLoRaWANHost::txBegin(osjob_t *job)
+{
+    LMIC.opmode  |= OP_TXRXPEND;
+    LMIC.rps      = updr2rps(tx.dr);
+    LMIC.dataLen  = tx.join ? 23 : (13 + tx.len + (tx.time_req ? 1 : 0));
+    LMIC.txChnl   = hostRandom() % 3;
+
+    ostime_t airtime = calcAirTime(LMIC.rps, LMIC.dataLen);
+    host->tx_count++;
+    host->tx_us += osticks2us(airtime);
+    pLoRaWAN->DispatchEvent(EV_TXSTART);
+
+    txEnd    = os_getTime() + airtime;
+    rxWindow = 1;
+    os_setTimedCallback(job, txEnd + sec2osticks(tx.join ? JOIN_ACCEPT_DELAY_S : RX_DELAY_S), rxStart);
+}
+
+// Start of receive window
+void ArduinoLoRaWANHost::rxStart(osjob_t *job)
+{
+    ostime_t rx2   = txEnd + sec2osticks((tx.join ? JOIN_ACCEPT_DELAY_S : RX_DELAY_S) + 1);
+    ostime_t done  = localTime(rx.done_ms);
+
+    LMIC.rps    = dndr2rps((rxWindow == 1) ? tx.dr : RX2_DR);
+    LMIC.rxsyms = RX_SYMS;
+    pLoRaWAN->DispatchEvent(EV_RXSTART);
+
+    if ((rxWindow == 1) && (done - rx2 >= 0)) {
+        rxWindow = 2;
+        os_setTimedCallback(job, rx2, rxStart);
+    } else {
+        os_setTimedCallback(job, done, txDone);
+    }
+}
+
+// End of receive windows
+void ArduinoLoRaWANHost::txDone(osjob_t *job)
+{
+    Arduino_LoRaWAN::SessionState state;
+
+    LMIC.opmode &= ~OP_TXRXPEND;
+
+    if (tx.join) {
+        if (!rx.ok) {
+            if ((attempt % 2) == 0) {
+                lowerDR();
+            }
+            os_setTimedCallback(job, os_getTime() + ms2osticks(hostRandom() % RETRY_DELAY_MS), txStart);
+            return;
+        }
+        Arduino_LoRaWAN::SessionInfo info;
+
+        joined       = true;
+        attempt      = 0;
+        LMIC.devaddr = 0x260B0000 | (hostRandom() & 0xFFFF);
+        LMIC.netid   = DEFAULT_NETID;
+        LMIC.seqnoUp = 0;
+        LMIC.seqnoDn = 0;
+        LMIC.snr     = rx.snr * 4;
+        LMIC.opmode &= ~OP_JOINING;
+        host->joins++;
+
+        memset(&info, 0, sizeof(info));
+        info.V2.Tag     = Arduino_LoRaWAN::kSessionInfoTag_V2;
+        info.V2.Size    = sizeof(info.V2);
+        info.V2.NetID   = LMIC.netid;
+        info.V2.DevAddr = LMIC.devaddr;
+        for (int i = 0; i < 16; i++) {
+            info.V2.NwkSKey[i] = hostRandom() & 0xFF;
+            info.V2.AppSKey[i] = hostRandom() & 0xFF;
+        }
+        pLoRaWAN->DispatchEvent(EV_JOINED);
+        pLoRaWAN->NetJoin();
+        pLoRaWAN->NetSaveSessionInfo(info, nullptr, 0);
+        pLoRaWAN->BuildSessionState(state);
+        pLoRaWAN->NetSaveSessionState(state);
+
+        // send pending uplink
+        os_setCallback(job, txStart);
+        return;
+    }
+
+    LMIC.seqnoUp++;
+    if (tx.confirmed && !rx.ok && (attempt < TXCONF_ATTEMPTS)) {
+        // retransmission uses the same frame counter
+        LMIC.seqnoUp--;
+        if (DRADJUST[attempt]) {
+            lowerDR();
+        }
+        os_setTimedCallback(job, os_getTime() + ms2osticks(hostRandom() % RETRY_DELAY_MS), txStart);
+        return;
+    }
+
+    if (rx.ok || (rx.port > 0)) {
+        LMIC.seqnoDn++;
+        LMIC.snr = rx.snr * 4;
+    }
+    if (rx.dr >= 0) {
+        LMIC.datarate = (dr_t)rx.dr;
+    }
+    host->uplinks++;
+    if (tx.confirmed && rx.ok) {
+        host->acks++;
+    }
+    LMIC.opmode &= ~OP_TXDATA;
+
+    if (tx.time_req) {
+        hostLmicTimeResult(txEnd, rx.time_ms);
+    }
+    pLoRaWAN->NetTxComplete();
+    pLoRaWAN->BuildSessionState(state);
+    pLoRaWAN->NetSaveSessionState(state);
+    if (pLoRaWAN->m_pReceiveBufferFn) {
+        pLoRaWAN->m_pReceiveBufferFn(pLoRaWAN->m_pReceiveBufferCtx, rx.port, rx.data, rx.len);
+    }
+    if (frame.pDoneFn) {
+        frame.pDoneFn(frame.pDoneCtx, tx.confirmed ? rx.ok : true);
+    }
+}
+
+void Arduino_LoRaWAN::cEventLog::loop(void)
+{
+    while (m_tail != m_head) {
+        EventNode_t const *pEvent = &m_queue[m_tail];
+
+        m_tail = (m_tail + 1) % kQueueDepth;
+        pEvent->pPrintFn(pEvent);
+    }
+}
+
+bool Arduino_LoRaWAN::cEventLog::logEvent(
+    void *pClientInfo,
+    uint32_t data0,
+    uint32_t data1,
+    uint32_t data2,
+    EventNode_t::PrintFn_t pPrintFn)
+{
+    unsigned next = (m_head + 1) % kQueueDepth;
+
+    if (next == m_tail) {
+        return false;
+    }
+    EventNode_t &node = m_queue[m_head];
+    node.time        = os_getTime();
+    node.pClientInfo = pClientInfo;
+    node.data[0]     = data0;
+    node.data[1]     = data1;
+    node.data[2]     = data2;
+    node.pPrintFn    = pPrintFn;
+    m_head = next;
+    return true;
+}
+
+const char *Arduino_LoRaWAN::cEventLog::getSfName(rps_t rps) const
+{
+    static const char * const names[] = {"FSK", "SF7", "SF8", "SF9", "SF10", "SF11", "SF12", "SFrfu"};
+    return names[getSf(rps)];
+}
+
+const char *Arduino_LoRaWAN::cEventLog::getBwName(rps_t rps) const
+{
+    static const char * const names[] = {"BW125", "BW250", "BW500", "BWrfu"};
+    return names[getBw(rps)];
+}
+
+const char *Arduino_LoRaWAN::cEventLog::getCrName(rps_t rps) const
+{
+    static const char * const names[] = {"CR 4/5", "CR 4/6", "CR 4/7", "CR 4/8"};
+    return names[getCr(rps)];
+}
+
+const char *Arduino_LoRaWAN::cEventLog::getCrcName(rps_t rps) const
+{
+    return getNocrc(rps) ? "NoCrc" : "CRC";
+}
@@ -0,0 +1,257 @@
+///////////////////////////////////////////////////////////////////////////////
+// Arduino_LoRaWAN.h
+//
+// Host (Linux) build - MCCI Arduino LoRaWAN library stub
+//
+// Subset of class Arduino_LoRaWAN used by the sketch - provisioning and session
+// save/restore hooks, event listeners, SendBuffer() and downlink callback.
+// The protocol sequence (join, transmission, receive windows, confirmed uplink
+// retries) is implemented in Arduino_LoRaWAN.cpp on top of the LMIC job queue;
+// the network side is provided by hostNetTransmit().
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(ARDUINO_LORAWAN_H)
+#define ARDUINO_LORAWAN_H
+
+#include <arduino_lmic.h>
+
+#define ARDUINO_LORAWAN_MAX_LISTENERS   4   //!< max. number of event listeners
+
+class Arduino_LoRaWAN {
+public:
+    /// Pin map
+    struct lmic_pinmap {
+        uint8_t     nss;
+        uint8_t     rxtx;
+        uint8_t     rst;
+        uint8_t     dio[3];
+        uint8_t     rxtx_rx_active;
+        int8_t      rssi_cal;
+        uint32_t    spi_freq;
+        const void *pConfig;
+
+        static constexpr uint8_t LMIC_UNUSED_PIN = 0xff;
+    };
+
+    /// Session info tags
+    enum SessionInfoTag : uint8_t {
+        kSessionInfoTag_Null = 0x00,
+        kSessionInfoTag_V1   = 0x01,
+        kSessionInfoTag_V2   = 0x02
+    };
+
+    /// Session info header
+    struct SessionInfoHeader {
+        SessionInfoTag  Tag;
+        uint8_t         Size;
+    };
+
+    /// Session info V1
+    struct SessionInfoV1 {
+        SessionInfoTag  Tag;
+        uint8_t         Size;
+        uint8_t         Rsv2;
+        uint8_t         Rsv3;
+        uint32_t        NetID;
+        uint32_t        DevAddr;
+        uint8_t         NwkSKey[16];
+        uint8_t         AppSKey[16];
+        uint32_t        FCntUp;
+        uint32_t        FCntDown;
+    };
+
+    /// Session info V2 (frame counters are part of SessionState)
+    struct SessionInfoV2 {
+        SessionInfoTag  Tag;
+        uint8_t         Size;
+        uint8_t         Rsv2;
+        uint8_t         Rsv3;
+        uint32_t        NetID;
+        uint32_t        DevAddr;
+        uint8_t         NwkSKey[16];
+        uint8_t         AppSKey[16];
+    };
+
+    /// Session info
+    union SessionInfo {
+        SessionInfoHeader   Header;
+        SessionInfoV1       V1;
+        SessionInfoV2       V2;
+    };
+
+    /// Session state tags
+    enum SessionStateTag : uint8_t {
+        kSessionStateTag_V1 = 0x01
+    };
+
+    /// Channel mask (EU-like regions)
+    struct SessionChannelMask {
+        uint8_t     Tag;
+        uint8_t     Size;
+        uint16_t    ChannelMap;
+        uint32_t    UplinkFreq[16];
+    };
+
+    /// Session state header
+    struct SessionStateHeader {
+        SessionStateTag Tag;
+        uint8_t         Size;
+    };
+
+    /// Session state V1
+    struct SessionStateV1 {
+        SessionStateTag     Tag;
+        uint8_t             Size;
+        uint8_t             Region;
+        uint8_t             LinkDR;
+        uint32_t            FCntUp;
+        uint32_t            FCntDown;
+        uint32_t            gpsTime;
+        uint32_t            globalAvail;
+        uint32_t            Rx2Frequency;
+        uint32_t            PingFrequency;
+        uint16_t            Country;
+        int16_t             LinkIntegrity;
+        uint8_t             TxPower;
+        uint8_t             Redundancy;
+        uint8_t             DutyCycle;
+        uint8_t             Rx1DRoffset;
+        uint8_t             Rx2DataRate;
+        uint8_t             RxDelay;
+        uint8_t             TxParam;
+        uint8_t             BeaconChannel;
+        uint8_t             PingDr;
+        uint8_t             MacRxParamAns;
+        uint8_t             MacDlChannelAns;
+        uint8_t             MacRxTimingSetupAns;
+        SessionChannelMask  Channels;
+    };
+
+    /// Session state
+    union SessionState {
+        SessionStateHeader  Header;
+        SessionStateV1      V1;
+    };
+
+    /// OTAA provisioning info
+    struct OtaaProvisioningInfo {
+        uint8_t     AppKey[16];
+        uint8_t     DevEUI[8];
+        uint8_t     AppEUI[8];
+    };
+
+    /// ABP provisioning info (also used to restore an OTAA session)
+    struct AbpProvisioningInfo {
+        uint8_t     NwkSKey[16];
+        uint8_t     AppSKey[16];
+        uint32_t    DevAddr;
+        uint32_t    NetID;
+        uint32_t    FCntUp;
+        uint32_t    FCntDown;
+    };
+
+    class cEventLog;
+
+    typedef void SendBufferCbFn(void *pCtx, bool fSuccess);
+    typedef void ReceivePortBufferCbFn(void *pCtx, uint8_t uPort, const uint8_t *pBuffer, size_t nBuffer);
+    typedef void ARDUINO_LORAWAN_EVENT_FN(void *pCtx, uint32_t event);
+
+    Arduino_LoRaWAN() {};
+
+    bool begin(const lmic_pinmap &pinmap);
+    void loop(void);
+
+    bool SendBuffer(
+        const uint8_t *pBuffer,
+        size_t nBuffer,
+        SendBufferCbFn *pDoneFn = nullptr,
+        void *pDoneCtx = nullptr,
+        bool fConfirmed = false,
+        uint8_t port = 1
+    );
+
+    void SetReceiveBufferBufferCb(ReceivePortBufferCbFn *pReceiveBufferFn, void *pCtx = nullptr) {
+        m_pReceiveBufferFn = pReceiveBufferFn;
+        m_pReceiveBufferCtx = pCtx;
+    };
+
+    bool RegisterListener(ARDUINO_LORAWAN_EVENT_FN *pEventFn, void *pContext);
+
+    void Shutdown(void);
+
+    bool GetTxReady(void);
+
+protected:
+    virtual bool GetOtaaProvisioningInfo(OtaaProvisioningInfo *pProvisioningInfo) = 0;
+    virtual bool GetAbpProvisioningInfo(AbpProvisioningInfo *pProvisioningInfo) {
+        (void)pProvisioningInfo;
+        return false;
+    };
+    virtual void NetJoin(void) {};
+    virtual void NetTxComplete(void) {};
+    virtual void NetSaveSessionInfo(const SessionInfo &Info, const uint8_t *pExtraInfo, size_t nExtraInfo) {
+        (void)Info;
+        (void)pExtraInfo;
+        (void)nExtraInfo;
+    };
+    virtual void NetSaveSessionState(const SessionState &State) {
+        (void)State;
+    };
+    virtual bool NetGetSessionState(SessionState &State) {
+        (void)State;
+        return false;
+    };
+
+private:
+    friend struct ArduinoLoRaWANHost;
+
+    /// Event listener
+    struct Listener {
+        ARDUINO_LORAWAN_EVENT_FN *pEventFn;
+        void                     *pContext;
+    };
+
+    ReceivePortBufferCbFn *m_pReceiveBufferFn = nullptr;
+    void                  *m_pReceiveBufferCtx = nullptr;
+    Listener               m_Listeners[ARDUINO_LORAWAN_MAX_LISTENERS];
+    unsigned               m_nListeners = 0;
+
+    void DispatchEvent(uint32_t event);
+    void BuildSessionState(SessionState &State);
+};
+
+#endif // ARDUINO_LORAWAN_H
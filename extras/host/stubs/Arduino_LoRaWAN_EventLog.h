@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////////////////////
+// Arduino_LoRaWAN_EventLog.h
+//
+// Host (Linux) build - MCCI Arduino LoRaWAN library stub (event log)
+//
+// Events are logged with a print-out function which is called from loop().
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(ARDUINO_LORAWAN_EVENTLOG_H)
+#define ARDUINO_LORAWAN_EVENTLOG_H
+
+#include <Arduino_LoRaWAN.h>
+
+class Arduino_LoRaWAN::cEventLog {
+public:
+    cEventLog() {};
+
+    /// Logged event
+    class EventNode_t {
+    public:
+        typedef void (*PrintFn_t)(EventNode_t const *pEvent);
+
+        uint32_t getData(unsigned i) const {
+            return (i < 3) ? data[i] : 0;
+        };
+        ostime_t getTime() const {
+            return time;
+        };
+
+        ostime_t    time;
+        void       *pClientInfo;
+        uint32_t    data[3];
+        PrintFn_t   pPrintFn;
+    };
+
+    void setup(void) {};
+    void loop(void);
+
+    bool logEvent(void *pClientInfo, uint32_t data0, uint32_t data1, uint32_t data2, EventNode_t::PrintFn_t pPrintFn);
+
+    const char *getSfName(rps_t rps) const;
+    const char *getBwName(rps_t rps) const;
+    const char *getCrName(rps_t rps) const;
+    const char *getCrcName(rps_t rps) const;
+
+private:
+    static constexpr unsigned kQueueDepth = 8;  //!< max. number of pending events
+
+    EventNode_t m_queue[kQueueDepth];
+    unsigned    m_head = 0;
+    unsigned    m_tail = 0;
+};
+
+#endif // ARDUINO_LORAWAN_EVENTLOG_H
@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////////////
+// ESP32Time.h
+//
+// Host (Linux) build - ESP32Time stub
+//
+// The RTC of the node is simulation time plus an offset which is retained
+// across wake cycles (see hostRtcMs()).
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(ESP32TIME_H)
+#define ESP32TIME_H
+
+#include <Arduino.h>
+#include "../host.h"
+
+/*!
+  \class ESP32Time
+
+  \brief Real time clock
+*/
+class ESP32Time {
+    public:
+        ESP32Time(unsigned long offset = 0) {
+            _offset = offset;
+        };
+        void setTime(unsigned long epoch = 1609459200, int ms = 0) {
+            hostRtcSet((int64_t)epoch * 1000 + ms);
+        };
+        unsigned long getEpoch(void) {
+            return (unsigned long)(hostRtcMs() / 1000);
+        };
+        unsigned long getLocalEpoch(void) {
+            return getEpoch() + _offset;
+        };
+        unsigned long getMillis(void) {
+            return (unsigned long)(hostRtcMs() % 1000);
+        };
+        unsigned long getMicros(void) {
+            return getMillis() * 1000;
+        };
+
+    protected:
+        unsigned long _offset;  //!< time zone offset [s]
+};
+
+#endif // ESP32TIME_H
@@ -0,0 +1,96 @@
+///////////////////////////////////////////////////////////////////////////////
+// Lightning.h
+//
+// Host (Linux) build - Lightning stub
+//
+// Post-processing of lightning sensor data (BresserWeatherSensorReceiver):
+// the last event (strike counter increment) is retained across wake cycles.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(LIGHTNING_H)
+#define LIGHTNING_H
+
+#include <Arduino.h>
+
+/// Lightning post-processing state
+struct HostLightningS {
+    bool     valid;     //!< previous counter value valid
+    int16_t  count;     //!< previous counter value
+    bool     event;     //!< event available
+    time_t   ts;        //!< time of last event
+    int      events;    //!< strikes of last event
+    uint8_t  distance;  //!< distance of last event [km]
+};
+
+extern struct HostLightningS hostLightningState;    //!< retained state (WeatherSensor.cpp)
+
+/*!
+  \class Lightning
+
+  \brief Lightning sensor post-processing
+*/
+class Lightning {
+    public:
+        void reset(void) {
+            memset(&hostLightningState, 0, sizeof(hostLightningState));
+        };
+        void update(time_t timestamp, int16_t count, uint8_t distance, bool startup = false) {
+            struct HostLightningS &s = hostLightningState;
+
+            if (s.valid && !startup && (count != s.count)) {
+                s.event    = true;
+                s.ts       = timestamp;
+                s.events   = (count > s.count) ? count - s.count : count;
+                s.distance = distance;
+            }
+            s.count = count;
+            s.valid = true;
+        };
+        bool lastEvent(time_t &timestamp, int &events, uint8_t &distance) {
+            const struct HostLightningS &s = hostLightningState;
+
+            if (!s.event) {
+                return false;
+            }
+            timestamp = s.ts;
+            events    = s.events;
+            distance  = s.distance;
+            return true;
+        };
+};
+
+#endif // LIGHTNING_H
@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////////////////////////
+// LoraMessage.h
+//
+// Host (Linux) build - lora-serialization stub
+//
+// LoraEncoder with the same encoding as
+// https://github.com/thesolarnomad/lora-serialization
+// (integers little-endian, temperature big-endian).
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(LORA_MESSAGE_H)
+#define LORA_MESSAGE_H
+
+#include <Arduino.h>
+
+/*!
+  \class LoraEncoder
+
+  \brief Encoding of values into a byte buffer
+*/
+class LoraEncoder {
+    public:
+        LoraEncoder(byte *buffer) {
+            _buffer = buffer;
+            _length = 0;
+        };
+        void writeUnixtime(uint32_t unixtime) {
+            intToBytes(unixtime, 4);
+        };
+        void writeLatLng(double latitude, double longitude) {
+            intToBytes((int32_t)(latitude * 1e6), 4);
+            intToBytes((int32_t)(longitude * 1e6), 4);
+        };
+        void writeUint32(uint32_t i) {
+            intToBytes(i, 4);
+        };
+        void writeUint16(uint16_t i) {
+            intToBytes(i, 2);
+        };
+        void writeUint8(uint8_t i) {
+            intToBytes(i, 1);
+        };
+        void writeHumidity(float humidity) {
+            intToBytes((uint16_t)(humidity * 100), 2);
+        };
+        void writeTemperature(float temperature) {
+            int16_t t = (int16_t)(temperature * 100);
+            _buffer[_length++] = (byte)((t >> 8) & 0xFF);
+            _buffer[_length++] = (byte)(t & 0xFF);
+        };
+        void writeRawFloat(float value) {
+            memcpy(&_buffer[_length], &value, 4);
+            _length += 4;
+        };
+        void writeBitmap(bool a, bool b, bool c, bool d, bool e, bool f, bool g, bool h) {
+            _buffer[_length++] = (a << 7) | (b << 6) | (c << 5) | (d << 4) |
+                                 (e << 3) | (f << 2) | (g << 1) | (h << 0);
+        };
+        int getLength(void) {
+            return _length;
+        };
+
+    protected:
+        byte *_buffer;  //!< output buffer
+        int  _length;   //!< number of bytes written
+
+        /// Write integer (little-endian)
+        void intToBytes(uint32_t i, int n) {
+            for (int k = 0; k < n; k++) {
+                _buffer[_length++] = (byte)((i >> (8 * k)) & 0xFF);
+            }
+        };
+};
+
+#endif // LORA_MESSAGE_H
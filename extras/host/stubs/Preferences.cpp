@@ -0,0 +1,173 @@
+///////////////////////////////////////////////////////////////////////////////
+// Preferences.cpp
+//
+// Host (Linux) build - Preferences (ESP32 NVS) stub
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <Preferences.h>
+#include "../host.h"
+
+bool Preferences::begin(const char *name, bool readOnly, const char *partition_label)
+{
+    (void)partition_label;
+
+    if (_started || (strlen(name) >= sizeof(_name))) {
+        return false;
+    }
+    strcpy(_name, name);
+
+    // Read-only access fails if the namespace does not exist (yet)
+    if (readOnly) {
+        bool found = false;
+        for (int i = 0; i < HOST_NVS_ENTRIES; i++) {
+            if (strcmp(host->nvs[i].ns, _name) == 0) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            return false;
+        }
+    }
+    _readOnly = readOnly;
+    _started = true;
+    return true;
+}
+
+void Preferences::end(void)
+{
+    _started = false;
+}
+
+bool Preferences::clear(void)
+{
+    if (!_started || _readOnly) {
+        return false;
+    }
+    for (int i = 0; i < HOST_NVS_ENTRIES; i++) {
+        if (strcmp(host->nvs[i].ns, _name) == 0) {
+            memset(&host->nvs[i], 0, sizeof(struct HostNvsS));
+            host->nvs_writes++;
+        }
+    }
+    return true;
+}
+
+bool Preferences::remove(const char *key)
+{
+    struct HostNvsS *entry = find(key);
+
+    if (_readOnly || (entry == nullptr)) {
+        return false;
+    }
+    memset(entry, 0, sizeof(struct HostNvsS));
+    host->nvs_writes++;
+    return true;
+}
+
+struct HostNvsS *Preferences::find(const char *key)
+{
+    if (!_started) {
+        return nullptr;
+    }
+    for (int i = 0; i < HOST_NVS_ENTRIES; i++) {
+        if ((strcmp(host->nvs[i].ns, _name) == 0) && (strcmp(host->nvs[i].key, key) == 0)) {
+            return &host->nvs[i];
+        }
+    }
+    return nullptr;
+}
+
+size_t Preferences::put(const char *key, const void *value, size_t len)
+{
+    if (!_started || _readOnly || (strlen(key) >= sizeof(host->nvs[0].key)) || (len > HOST_NVS_SIZE_MAX)) {
+        return 0;
+    }
+    struct HostNvsS *entry = find(key);
+
+    // Like NVS, unchanged values are not written again
+    if ((entry != nullptr) && (entry->len == len) && (memcmp(entry->data, value, len) == 0)) {
+        return len;
+    }
+    if (entry == nullptr) {
+        for (int i = 0; i < HOST_NVS_ENTRIES; i++) {
+            if (host->nvs[i].ns[0] == '\0') {
+                entry = &host->nvs[i];
+                break;
+            }
+        }
+        if (entry == nullptr) {
+            log_e("NVS full");
+            return 0;
+        }
+        strcpy(entry->ns, _name);
+        strcpy(entry->key, key);
+    }
+    entry->len = len;
+    memcpy(entry->data, value, len);
+    host->nvs_writes++;
+    return len;
+}
+
+bool Preferences::get(const char *key, void *value, size_t len)
+{
+    struct HostNvsS *entry = find(key);
+
+    if ((entry == nullptr) || (entry->len != len)) {
+        return false;
+    }
+    memcpy(value, entry->data, len);
+    return true;
+}
+
+size_t Preferences::getBytesLength(const char *key)
+{
+    struct HostNvsS *entry = find(key);
+
+    return (entry == nullptr) ? 0 : entry->len;
+}
+
+size_t Preferences::getBytes(const char *key, void *buf, size_t maxLen)
+{
+    struct HostNvsS *entry = find(key);
+
+    if ((entry == nullptr) || (entry->len > maxLen)) {
+        return 0;
+    }
+    memcpy(buf, entry->data, entry->len);
+    return entry->len;
+}
@@ -0,0 +1,112 @@
+///////////////////////////////////////////////////////////////////////////////
+// Preferences.h
+//
+// Host (Linux) build - Preferences (ESP32 NVS) stub
+//
+// The entries are kept in shared memory, i.e. they are retained across
+// wake cycles like flash memory. Write operations which change the stored
+// data are counted (flash wear).
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(PREFERENCES_H)
+#define PREFERENCES_H
+
+#include <Arduino.h>
+
+/*!
+  \class Preferences
+
+  \brief Key/value store in flash memory
+*/
+class Preferences {
+    public:
+        bool begin(const char *name, bool readOnly = false, const char *partition_label = NULL);
+        void end(void);
+        bool clear(void);
+        bool remove(const char *key);
+
+        size_t putUChar(const char *key, uint8_t value) {
+            return put(key, &value, sizeof(value));
+        };
+        size_t putShort(const char *key, int16_t value) {
+            return put(key, &value, sizeof(value));
+        };
+        size_t putUShort(const char *key, uint16_t value) {
+            return put(key, &value, sizeof(value));
+        };
+        size_t putUInt(const char *key, uint32_t value) {
+            return put(key, &value, sizeof(value));
+        };
+        size_t putBytes(const char *key, const void *value, size_t len) {
+            return put(key, value, len);
+        };
+
+        uint8_t getUChar(const char *key, uint8_t defaultValue = 0) {
+            get(key, &defaultValue, sizeof(defaultValue));
+            return defaultValue;
+        };
+        int16_t getShort(const char *key, int16_t defaultValue = 0) {
+            get(key, &defaultValue, sizeof(defaultValue));
+            return defaultValue;
+        };
+        uint16_t getUShort(const char *key, uint16_t defaultValue = 0) {
+            get(key, &defaultValue, sizeof(defaultValue));
+            return defaultValue;
+        };
+        uint32_t getUInt(const char *key, uint32_t defaultValue = 0) {
+            get(key, &defaultValue, sizeof(defaultValue));
+            return defaultValue;
+        };
+        size_t getBytesLength(const char *key);
+        size_t getBytes(const char *key, void *buf, size_t maxLen);
+
+    protected:
+        char _name[16] = "";    //!< namespace
+        bool _started = false;  //!< begin() has been called successfully
+        bool _readOnly = false; //!< read-only access
+
+        /// Find entry in namespace
+        struct HostNvsS *find(const char *key);
+
+        /// Write value (only if changed)
+        size_t put(const char *key, const void *value, size_t len);
+
+        /// Read value (only if size matches)
+        bool get(const char *key, void *value, size_t len);
+};
+
+#endif // PREFERENCES_H
@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////////////////////
+// RainGauge.h
+//
+// Host (Linux) build - RainGauge stub
+//
+// Simplified replacement of the library class RainGauge
+// (BresserWeatherSensorReceiver); the state is retained across wake cycles.
+// pastHour() returns the rain since the start of the current hour.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(RAINGAUGE_H)
+#define RAINGAUGE_H
+
+#include <Arduino.h>
+#include <time.h>
+
+#define RESET_RAIN_H            1       //!< reset past 60 minutes
+#define RESET_RAIN_D            2       //!< reset current day
+#define RESET_RAIN_W            4       //!< reset current week
+#define RESET_RAIN_M            8       //!< reset current month
+
+/// Rain gauge state
+struct HostRainGaugeS {
+    bool     valid;     //!< previous raw value valid
+    float    prev;      //!< previous raw value
+    float    max;       //!< raw value overflow
+    int      idx[4];    //!< hour/day/week/month index of accumulators
+    float    acc[4];    //!< rain in hour/day/week/month
+};
+
+extern struct HostRainGaugeS hostRainGaugeState;   //!< retained state (WeatherSensor.cpp)
+
+/*!
+  \class RainGauge
+
+  \brief Rain gauge statistics
+*/
+class RainGauge {
+    public:
+        RainGauge(float raingauge_max = 100000) : _max(raingauge_max) {};
+
+        void set_max(float raingauge_max) {
+            _max = raingauge_max;
+        };
+        void reset(uint8_t flags = RESET_RAIN_H | RESET_RAIN_D | RESET_RAIN_W | RESET_RAIN_M) {
+            struct HostRainGaugeS &s = hostRainGaugeState;
+
+            for (int i = 0; i < 4; i++) {
+                if (flags & (1 << i)) {
+                    s.acc[i] = 0;
+                }
+            }
+        };
+        void update(time_t timestamp, float rain, bool startup = false) {
+            struct HostRainGaugeS &s = hostRainGaugeState;
+            struct tm t;
+            int idx[4];
+
+            gmtime_r(&timestamp, &t);
+            idx[0] = timestamp / 3600;
+            idx[1] = t.tm_yday;
+            idx[2] = (timestamp / 86400 + 3) / 7;
+            idx[3] = t.tm_mon;
+
+            float delta = 0;
+            if (s.valid && !startup) {
+                delta = (rain >= s.prev) ? rain - s.prev : rain + _max - s.prev;
+            }
+            for (int i = 0; i < 4; i++) {
+                if (!s.valid || (idx[i] != s.idx[i])) {
+                    s.acc[i] = 0;
+                    s.idx[i] = idx[i];
+                }
+                s.acc[i] += delta;
+            }
+            s.prev  = rain;
+            s.valid = true;
+        };
+        float pastHour(void) const {
+            return hostRainGaugeState.acc[0];
+        };
+        float currentDay(void) const {
+            return hostRainGaugeState.acc[1];
+        };
+        float currentWeek(void) const {
+            return hostRainGaugeState.acc[2];
+        };
+        float currentMonth(void) const {
+            return hostRainGaugeState.acc[3];
+        };
+
+    private:
+        float _max; //!< raw value overflow
+};
+
+#endif // RAINGAUGE_H
@@ -0,0 +1,272 @@
+///////////////////////////////////////////////////////////////////////////////
+// WeatherSensor.cpp
+//
+// Host (Linux) build - BresserWeatherSensorReceiver stub
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "WeatherSensor.h"
+#include <RainGauge.h>
+#include <Lightning.h>
+#include "../host.h"
+
+#define SIM_SENSORS     3       //!< number of simulated sensors
+#define SIM_POLL_US     1000    //!< time skipped per getMessage() without message [us]
+
+/// Simulated sensors - transmission intervals are approximate
+static const struct {
+    uint32_t id;                //!< sensor ID
+    uint8_t  s_type;            //!< sensor type
+    uint8_t  chan;              //!< channel
+    int64_t  period_ms;         //!< transmission interval
+    int64_t  phase_ms;          //!< time of first transmission
+} simSensor[SIM_SENSORS] = {
+    {0x39582376, SENSOR_TYPE_WEATHER1,  0, 12000,  3100},
+    {0x01326577, SENSOR_TYPE_SOIL,      1, 16000,  7700},
+    {0x00004711, SENSOR_TYPE_LIGHTNING, 0, 15000, 11300}
+};
+
+// State of library classes RainGauge/Lightning (see RainGauge.h, Lightning.h)
+RTC_DATA_ATTR struct HostRainGaugeS hostRainGaugeState;
+RTC_DATA_ATTR struct HostLightningS hostLightningState;
+
+int16_t WeatherSensor::begin(void)
+{
+    // Messages sent before the receiver has been started are missed
+    int64_t now = hostNowMs();
+    for (int s = 0; s < SIM_SENSORS; s++) {
+        _seen[s] = now;
+    }
+    return 0;
+}
+
+void WeatherSensor::clearSlots(uint8_t type)
+{
+    for (size_t i = 0; i < sensor.size(); i++) {
+        if ((type == 0xFF) || (sensor[i].s_type == type)) {
+            memset(&sensor[i], 0, sizeof(Sensor));
+        }
+    }
+    _parts = 0;
+}
+
+int WeatherSensor::findSlot(uint32_t id)
+{
+    int free = -1;
+
+    for (size_t i = 0; i < sensor.size(); i++) {
+        if (sensor[i].valid && (sensor[i].sensor_id == id)) {
+            return i;
+        }
+        if (!sensor[i].valid && (free < 0)) {
+            free = i;
+        }
+    }
+    return free;
+}
+
+int WeatherSensor::findType(uint8_t type, uint8_t channel)
+{
+    for (size_t i = 0; i < sensor.size(); i++) {
+        if (sensor[i].valid && (sensor[i].s_type == type) &&
+            ((channel == 0xFF) || (sensor[i].chan == channel))) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool WeatherSensor::decode(int s, int64_t t_ms, int n)
+{
+    int slot = findSlot(simSensor[s].id);
+    if (slot < 0) {
+        return false;
+    }
+    Sensor &d = sensor[slot];
+    double t   = t_ms / 1000.0;
+    double day = 2 * M_PI * fmod(t, 86400) / 86400;
+    float  temp_c = 12 + 6 * sin(day - 2 * M_PI * 0.375);
+
+    d.sensor_id  = simSensor[s].id;
+    d.s_type     = simSensor[s].s_type;
+    d.chan       = simSensor[s].chan;
+    d.startup    = false;
+    d.battery_ok = true;
+    d.valid      = true;
+    d.rssi       = -80 - (int)(hostRandom() % 10);
+
+    if (d.s_type == SENSOR_TYPE_WEATHER1) {
+        // Messages alternate between temperature/humidity and rain data
+        if (n & 1) {
+            // Rain rate varies between 0 and 0.5 mm/h with a period of 2 days;
+            // the rain gauge overflows at 100000 mm
+            const double T = 2 * 86400;
+            double rain = 0.5 / 3600 / 2 * (t - T / (2 * M_PI) * cos(2 * M_PI * fmod(t, T) / T));
+            d.w.rain_ok = true;
+            d.w.rain_mm = fmod(floor(rain * 10) / 10, 100000);
+        } else {
+            d.w.temp_ok     = true;
+            d.w.temp_c      = roundf(temp_c * 10) / 10;
+            d.w.humidity_ok = true;
+            d.w.humidity    = (uint8_t)(70 - 20 * sin(day - 2 * M_PI * 0.375));
+        }
+        float wind = 2.0 + 1.5 * sin(2 * M_PI * fmod(t, 3 * 3600) / (3 * 3600));
+        d.w.wind_ok                 = true;
+        d.w.wind_avg_meter_sec      = roundf(wind * 10) / 10;
+        d.w.wind_gust_meter_sec     = roundf(wind * 16) / 10;
+        d.w.wind_direction_deg      = (float)((n * 7) % 360);
+        d.w.wind_avg_meter_sec_fp1  = (uint16_t)lroundf(d.w.wind_avg_meter_sec * 10);
+        d.w.wind_gust_meter_sec_fp1 = (uint16_t)lroundf(d.w.wind_gust_meter_sec * 10);
+        d.w.wind_direction_deg_fp1  = (uint16_t)lroundf(d.w.wind_direction_deg * 10);
+        _parts |= (n & 1) ? 2 : 1;
+        d.complete = (_parts == 3);
+    } else if (d.s_type == SENSOR_TYPE_SOIL) {
+        d.soil.temp_c   = roundf((temp_c - 3) * 10) / 10;
+        d.soil.moisture = (uint8_t)(35 + 10 * sin(day));
+        d.complete      = true;
+    } else {
+        // One strike every two hours
+        uint32_t strikes  = (uint32_t)(t / 7200);
+        d.lgt.strike_count = strikes % 1600;
+        d.lgt.distance_km  = 5 + strikes % 20;
+        d.complete         = true;
+    }
+    return true;
+}
+
+DecodeStatus WeatherSensor::getMessage(void)
+{
+    uint64_t start = hostMicros();
+    int64_t  now   = hostNowMs();
+    int      next  = -1;
+    int64_t  t_next = 0;
+    int64_t  n_next = 0;
+
+    // Next transmission of any sensor
+    for (int s = 0; s < SIM_SENSORS; s++) {
+        int64_t n = (_seen[s] - simSensor[s].phase_ms) / simSensor[s].period_ms + 1;
+        int64_t t = simSensor[s].phase_ms + n * simSensor[s].period_ms;
+        if ((next < 0) || (t < t_next)) {
+            next   = s;
+            t_next = t;
+            n_next = n;
+        }
+    }
+
+    DecodeStatus res = DECODE_INVALID;
+    if (t_next > now) {
+        hostSkip(SIM_POLL_US);
+    } else {
+        _seen[next] = t_next;
+        if (hostRandom() % 1000 < (uint32_t)(host->sensor_loss * 1000)) {
+            res = DECODE_CHK_ERR;
+        } else {
+            res = decode(next, t_next, n_next) ? DECODE_OK : DECODE_FULL;
+        }
+    }
+    host->sensor_us += hostMicros() - start;
+    return res;
+}
+
+bool WeatherSensor::getData(uint32_t timeout, uint8_t flags, uint8_t type, void (*func)())
+{
+    const uint32_t start = millis();
+
+    while ((millis() - start) < timeout) {
+        DecodeStatus res = getMessage();
+
+        if (func) {
+            func();
+        }
+        if (res != DECODE_OK) {
+            continue;
+        }
+        if (flags & DATA_ALL_SLOTS) {
+            bool all_valid = true;
+            bool all_complete = true;
+            for (size_t i = 0; i < sensor.size(); i++) {
+                all_valid    = all_valid && sensor[i].valid;
+                all_complete = all_complete && sensor[i].complete;
+            }
+            if (all_valid && (all_complete || !(flags & DATA_COMPLETE))) {
+                return true;
+            }
+        } else if (flags & DATA_TYPE) {
+            int i = findType(type);
+            if ((i > -1) && (sensor[i].complete || !(flags & DATA_COMPLETE))) {
+                return true;
+            }
+        } else if (flags & DATA_COMPLETE) {
+            for (size_t i = 0; i < sensor.size(); i++) {
+                if (sensor[i].valid && sensor[i].complete) {
+                    return true;
+                }
+            }
+        } else {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool WeatherSensor::genMessage(int i, uint32_t id, uint8_t s_type, uint8_t channel, uint8_t startup)
+{
+    if ((i < 0) || ((size_t)i >= sensor.size())) {
+        return false;
+    }
+    Sensor &d = sensor[i];
+
+    memset(&d, 0, sizeof(Sensor));
+    d.sensor_id  = id;
+    d.s_type     = s_type;
+    d.chan       = channel;
+    d.startup    = startup;
+    d.battery_ok = true;
+    d.valid      = true;
+    d.complete   = true;
+    d.rssi       = -88;
+    d.w.temp_ok     = true;
+    d.w.temp_c      = 22.2;
+    d.w.humidity_ok = true;
+    d.w.humidity    = 55;
+    d.w.wind_ok     = true;
+    d.w.wind_direction_deg_fp1  = 2700;
+    d.w.wind_gust_meter_sec_fp1 = 33;
+    d.w.wind_avg_meter_sec_fp1  = 22;
+    d.w.rain_ok     = true;
+    d.w.rain_mm     = 9.9;
+    return true;
+}
@@ -0,0 +1,149 @@
+///////////////////////////////////////////////////////////////////////////////
+// WeatherSensor.h
+//
+// Host (Linux) build - BresserWeatherSensorReceiver stub
+//
+// Simulated sensors - a weather sensor (6-in-1, messages alternating between
+// temperature/humidity and rain data), a soil sensor (channel 1) and a
+// lightning sensor transmit periodically (phase locked to simulation time).
+// Messages are lost with the probability set by --sensor-loss. The time
+// until the requested messages have been received is skipped.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(WEATHER_SENSOR_H)
+#define WEATHER_SENSOR_H
+
+#include <Arduino.h>
+#include "WeatherSensorCfg.h"
+
+// Sensor types
+#define SENSOR_TYPE_WEATHER0        0   //!< Weather Station
+#define SENSOR_TYPE_WEATHER1        1   //!< Weather Station
+#define SENSOR_TYPE_THERMO_HYGRO    2   //!< Thermo-/Hygro-Sensor
+#define SENSOR_TYPE_POOL_THERMO     3   //!< Pool / Spa Thermometer
+#define SENSOR_TYPE_SOIL            4   //!< Soil Temperature and Moisture
+#define SENSOR_TYPE_LEAKAGE         5   //!< Water Leakage
+#define SENSOR_TYPE_AIR_PM          8   //!< Air Quality Sensor (Particle Matter)
+#define SENSOR_TYPE_LIGHTNING       9   //!< Lightning Sensor
+
+// Flags for getData()
+#define DATA_COMPLETE               0x1 //!< only complete data
+#define DATA_TYPE                   0x2 //!< only specified sensor type
+#define DATA_ALL_SLOTS              0x8 //!< wait until all slots are filled
+
+/// Decoder status
+typedef enum DecodeStatus {
+    DECODE_INVALID, DECODE_OK, DECODE_PAR_ERR, DECODE_CHK_ERR, DECODE_DIG_ERR, DECODE_SKIP, DECODE_FULL
+} DecodeStatus;
+
+/// Weather sensor data
+struct WeatherData {
+    bool     temp_ok;                   //!< temperature o.k.
+    bool     humidity_ok;               //!< humidity o.k.
+    bool     wind_ok;                   //!< wind speed/direction o.k.
+    bool     rain_ok;                   //!< rain gauge level o.k.
+    float    temp_c;                    //!< temperature [degC]
+    uint8_t  humidity;                  //!< humidity [%]
+    uint16_t wind_direction_deg_fp1;    //!< wind direction [deg * 10]
+    uint16_t wind_gust_meter_sec_fp1;   //!< wind speed (gusts) [m/s * 10]
+    uint16_t wind_avg_meter_sec_fp1;    //!< wind speed (avg) [m/s * 10]
+    float    wind_direction_deg;        //!< wind direction [deg]
+    float    wind_gust_meter_sec;       //!< wind speed (gusts) [m/s]
+    float    wind_avg_meter_sec;        //!< wind speed (avg) [m/s]
+    float    rain_mm;                   //!< rain gauge level [mm]
+};
+
+/// Soil sensor data
+struct SoilData {
+    float    temp_c;                    //!< temperature [degC]
+    uint8_t  moisture;                  //!< moisture [%]
+};
+
+/// Lightning sensor data
+struct LightningData {
+    uint8_t  distance_km;               //!< distance of last strike [km]
+    uint16_t strike_count;              //!< strike counter
+};
+
+/// Sensor data slot
+struct Sensor {
+    uint32_t sensor_id;                 //!< sensor ID
+    uint8_t  s_type;                    //!< sensor type
+    uint8_t  chan;                      //!< channel
+    bool     startup;                   //!< startup after reset / battery change
+    bool     battery_ok;                //!< battery o.k.
+    bool     valid;                     //!< data valid
+    bool     complete;                  //!< data complete
+    float    rssi;                      //!< RSSI [dBm]
+    union {
+        struct WeatherData   w;         //!< weather sensor data
+        struct SoilData      soil;      //!< soil sensor data
+        struct LightningData lgt;       //!< lightning sensor data
+    };
+};
+
+/*!
+  \class WeatherSensor
+
+  \brief Reception and decoding of sensor messages
+*/
+class WeatherSensor {
+    public:
+        WeatherSensor(void) {
+            sensor.resize(MAX_SENSORS_DEFAULT);
+        };
+        int16_t begin(void);
+        void clearSlots(uint8_t type = 0xFF);
+        bool getData(uint32_t timeout, uint8_t flags = 0, uint8_t type = 0, void (*func)() = NULL);
+        DecodeStatus getMessage(void);
+        bool genMessage(int i, uint32_t id = 0xff, uint8_t s_type = 1, uint8_t channel = 0, uint8_t startup = 0);
+        int findType(uint8_t type, uint8_t channel = 0xFF);
+
+        std::vector<Sensor> sensor;     //!< sensor data slots
+
+    protected:
+        int64_t _seen[3];               //!< time of last message per simulated sensor
+        uint8_t _parts;                 //!< weather sensor message parts received (bit mask)
+
+        /// Find slot for sensor ID (or a free slot)
+        int findSlot(uint32_t id);
+
+        /// Decode message of simulated sensor
+        bool decode(int s, int64_t t_ms, int n);
+};
+
+#endif // WEATHER_SENSOR_H
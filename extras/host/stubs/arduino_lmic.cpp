@@ -0,0 +1,222 @@
+///////////////////////////////////////////////////////////////////////////////
+// arduino_lmic.cpp
+//
+// Host (Linux) build - MCCI LoRaWAN LMIC library stub
+//
+// Time base, job queue, EU868 radio parameters, time-on-air (SX127x formula)
+// and network time requests.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <arduino_lmic.h>
+#include "../host.h"
+
+#include <string.h>
+
+#define GPS_EPOCH_OFFSET    315964800   //!< GPS epoch - Unix epoch [s]
+
+struct lmic_t LMIC;
+
+static osjob_t *scheduledJobs;                          //!< job queue (ordered by deadline)
+static lmic_request_network_time_cb_t *pTimeCb;         //!< network time request callback
+static void *pTimeCtx;                                  //!< network time request callback context
+static lmic_time_reference_t timeRef;                   //!< network time reference
+static bool timeRefValid;                               //!< network time reference valid
+
+ostime_t os_getTime(void)
+{
+    return (ostime_t)(hostMicros() / US_PER_OSTICK);
+}
+
+static void unlinkJob(osjob_t *job)
+{
+    for (osjob_t **pnext = &scheduledJobs; *pnext; pnext = &((*pnext)->next)) {
+        if (*pnext == job) {
+            *pnext = job->next;
+            return;
+        }
+    }
+}
+
+void os_setTimedCallback(osjob_t *job, ostime_t time, osjobcb_t *cb)
+{
+    osjob_t **pnext;
+
+    unlinkJob(job);
+    job->deadline = time;
+    job->func = cb;
+    job->next = NULL;
+    for (pnext = &scheduledJobs; *pnext; pnext = &((*pnext)->next)) {
+        if ((*pnext)->deadline - time > 0) {
+            break;
+        }
+    }
+    job->next = *pnext;
+    *pnext = job;
+}
+
+void os_setCallback(osjob_t *job, osjobcb_t *cb)
+{
+    os_setTimedCallback(job, os_getTime(), cb);
+}
+
+void os_clearCallback(osjob_t *job)
+{
+    unlinkJob(job);
+}
+
+void os_runloop_once(void)
+{
+    osjob_t *job = scheduledJobs;
+
+    if (job && (job->deadline - os_getTime() <= 0)) {
+        scheduledJobs = job->next;
+        job->next = NULL;
+        job->func(job);
+    }
+}
+
+bit_t os_queryTimeCriticalJobs(ostime_t time)
+{
+    return (scheduledJobs != NULL) && (scheduledJobs->deadline - time < 0);
+}
+
+bool hostLmicNextJob(uint64_t *t_us)
+{
+    if (!scheduledJobs) {
+        return false;
+    }
+    *t_us = (scheduledJobs->deadline > 0) ? (uint64_t)osticks2us(scheduledJobs->deadline) : 0;
+    return true;
+}
+
+void hal_spi_write(u1_t cmd, const u1_t *buf, size_t len)
+{
+    (void)cmd;
+    (void)buf;
+    (void)len;
+}
+
+void hal_spi_read(u1_t cmd, u1_t *buf, size_t len)
+{
+    (void)cmd;
+    memset(buf, 0, len);
+}
+
+void LMIC_setClockError(u2_t error)
+{
+    LMIC.clockError = error;
+}
+
+void LMIC_shutdown(void)
+{
+    scheduledJobs = NULL;
+    LMIC.opmode |= OP_SHUTDOWN;
+}
+
+rps_t updr2rps(dr_t dr)
+{
+    if (dr <= 5) {
+        return makeRps((sf_t)(SF12 - dr), BW125, CR_4_5, 0, 0);
+    } else if (dr == 6) {
+        return makeRps(SF7, BW250, CR_4_5, 0, 0);
+    }
+    return makeRps(FSK, BW125, CR_4_5, 0, 0);
+}
+
+rps_t dndr2rps(dr_t dr)
+{
+    // downlinks are sent without payload CRC
+    return updr2rps(dr) | (1 << 7);
+}
+
+ostime_t calcAirTime(rps_t rps, u1_t plen)
+{
+    sf_t sf = getSf(rps);
+
+    if (sf == FSK) {
+        // 50 kbps, preamble (5 bytes), sync word (3 bytes), length, payload, CRC (2 bytes)
+        return us2osticks((uint32_t)(plen + 5 + 3 + 1 + 2) * 8 * 20);
+    }
+    int bw_khz  = 125 << getBw(rps);
+    int sfx     = sf + 6;
+    int de      = ((sfx >= 11) && (bw_khz == 125)) ? 1 : 0;
+    int crc     = getNocrc(rps) ? 0 : 1;
+    int ih      = getIh(rps) ? 1 : 0;
+    int num     = 8 * plen - 4 * sfx + 28 + 16 * crc - 20 * ih;
+    int den     = 4 * (sfx - 2 * de);
+    int nsym    = 8 + ((num > 0) ? ((num + den - 1) / den) * (getCr(rps) + 5) : 0);
+
+    // preamble: 8 + 4.25 symbols; symbol time: 2^SF / BW
+    int64_t tsym_ns = ((int64_t)1000000 << sfx) / bw_khz;
+    return us2osticks((tsym_ns * (4 * (8 + nsym) + 17) / 4) / 1000);
+}
+
+void LMIC_requestNetworkTime(lmic_request_network_time_cb_t *pCallbackfn, void *pUserData)
+{
+    pTimeCb  = pCallbackfn;
+    pTimeCtx = pUserData;
+}
+
+int LMIC_getNetworkTimeReference(lmic_time_reference_t *pReference)
+{
+    if (!timeRefValid) {
+        return 0;
+    }
+    *pReference = timeRef;
+    return 1;
+}
+
+bool hostLmicTimeRequested(void)
+{
+    return pTimeCb != NULL;
+}
+
+void hostLmicTimeResult(ostime_t tLocal, int64_t time_ms)
+{
+    lmic_request_network_time_cb_t *pCb = pTimeCb;
+
+    if (!pCb) {
+        return;
+    }
+    pTimeCb = NULL;
+    if (time_ms) {
+        timeRef.tLocal   = tLocal;
+        timeRef.tNetwork = (lmic_gpstime_t)(time_ms / 1000 - GPS_EPOCH_OFFSET);
+        timeRefValid     = true;
+    }
+    pCb(pTimeCtx, time_ms ? 1 : 0);
+}
@@ -0,0 +1,202 @@
+///////////////////////////////////////////////////////////////////////////////
+// arduino_lmic.h
+//
+// Host (Linux) build - MCCI LoRaWAN LMIC library stub
+//
+// Subset of the LMIC API used by the sketch and src/ - time base (62500 ticks/s,
+// derived from micros()), job scheduling, radio parameters (EU868), time-on-air
+// calculation and network time requests.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(ARDUINO_LMIC_H)
+#define ARDUINO_LMIC_H
+
+#include <Arduino.h>
+
+#define LMIC_ENABLE_DeviceTimeReq   1
+#define CFG_eu868                   1
+
+typedef uint8_t  u1_t;
+typedef int8_t   s1_t;
+typedef uint16_t u2_t;
+typedef int16_t  s2_t;
+typedef uint32_t u4_t;
+typedef int32_t  s4_t;
+typedef uint8_t  bit_t;
+typedef s4_t     ostime_t;
+typedef u4_t     devaddr_t;
+typedef u1_t     dr_t;
+typedef u2_t     rps_t;
+typedef u4_t     lmic_gpstime_t;
+
+// Time base
+#define US_PER_OSTICK               16
+#define OSTICKS_PER_SEC             (1000000 / US_PER_OSTICK)
+#define sec2osticks(sec)            ((ostime_t)((int64_t)(sec) * OSTICKS_PER_SEC))
+#define ms2osticks(ms)              ((ostime_t)(((int64_t)(ms) * OSTICKS_PER_SEC) / 1000))
+#define us2osticks(us)              ((ostime_t)((int64_t)(us) / US_PER_OSTICK))
+#define osticks2ms(os)              ((s4_t)(((os) * (int64_t)1000) / OSTICKS_PER_SEC))
+#define osticks2us(os)              ((s4_t)((os) * (int64_t)US_PER_OSTICK))
+
+#define MAX_CLOCK_ERROR             65536
+
+/// Events
+enum _ev_t {
+    EV_SCAN_TIMEOUT = 1, EV_BEACON_FOUND, EV_BEACON_MISSED, EV_BEACON_TRACKED, EV_JOINING,
+    EV_JOINED, EV_RFU1, EV_JOIN_FAILED, EV_REJOIN_FAILED, EV_TXCOMPLETE, EV_LOST_TSYNC,
+    EV_RESET, EV_RXCOMPLETE, EV_LINK_DEAD, EV_LINK_ALIVE, EV_SCAN_FOUND, EV_TXSTART,
+    EV_TXCANCELED, EV_RXSTART, EV_JOIN_TXCOMPLETE
+};
+typedef enum _ev_t ev_t;
+
+/// Operation modes (LMIC.opmode)
+enum {
+    OP_NONE     = 0x0000,
+    OP_SCAN     = 0x0001,
+    OP_TRACK    = 0x0002,
+    OP_JOINING  = 0x0004,
+    OP_TXDATA   = 0x0008,
+    OP_POLL     = 0x0010,
+    OP_REJOIN   = 0x0020,
+    OP_SHUTDOWN = 0x0040,
+    OP_TXRXPEND = 0x0080,
+    OP_RNDTX    = 0x0100,
+    OP_PINGINI  = 0x0200,
+    OP_PINGABLE = 0x0400,
+    OP_NEXTCHNL = 0x0800,
+    OP_LINKDEAD = 0x1000,
+    OP_TESTMODE = 0x2000,
+    OP_UNJOIN   = 0x4000
+};
+
+// Radio parameters
+enum _sf_t { FSK = 0, SF7, SF8, SF9, SF10, SF11, SF12, SFrfu };
+enum _bw_t { BW125 = 0, BW250, BW500, BWrfu };
+enum _cr_t { CR_4_5 = 0, CR_4_6, CR_4_7, CR_4_8 };
+typedef enum _sf_t sf_t;
+typedef enum _bw_t bw_t;
+typedef enum _cr_t cr_t;
+
+inline sf_t  getSf(rps_t params)    { return (sf_t)(params & 0x7); }
+inline bw_t  getBw(rps_t params)    { return (bw_t)((params >> 3) & 0x3); }
+inline cr_t  getCr(rps_t params)    { return (cr_t)((params >> 5) & 0x3); }
+inline int   getNocrc(rps_t params) { return (params >> 7) & 0x1; }
+inline int   getIh(rps_t params)    { return (params >> 8) & 0xFF; }
+inline rps_t makeRps(sf_t sf, bw_t bw, cr_t cr, int ih, int nocrc) {
+    return (rps_t)((sf) | ((bw) << 3) | ((cr) << 5) | (nocrc ? (1 << 7) : 0) | ((ih & 0xFF) << 8));
+}
+
+/// Radio parameters of uplink data rate (EU868)
+rps_t updr2rps(dr_t dr);
+
+/// Radio parameters of downlink data rate (EU868)
+rps_t dndr2rps(dr_t dr);
+
+/// Time-on-air of frame with PHY payload size plen
+ostime_t calcAirTime(rps_t rps, u1_t plen);
+
+/// MAC state (subset)
+struct lmic_t {
+    u2_t        opmode;         //!< operation mode
+    dr_t        datarate;       //!< current data rate
+    s1_t        snr;            //!< SNR of last downlink [0.25 dB]
+    rps_t       rps;            //!< radio parameters of last transmission
+    u1_t        dataLen;        //!< PHY payload size of last transmission
+    u1_t        rxsyms;         //!< receive window timeout [symbols]
+    u1_t        txChnl;         //!< channel of last transmission
+    devaddr_t   devaddr;        //!< device address
+    u4_t        netid;          //!< network ID
+    u4_t        seqnoUp;        //!< uplink frame counter
+    u4_t        seqnoDn;        //!< downlink frame counter
+    u2_t        clockError;     //!< clock error (see LMIC_setClockError())
+};
+
+extern struct lmic_t LMIC;
+
+// Jobs
+struct osjob_t;
+typedef void osjobcb_t(struct osjob_t *);
+
+/// Job (callback at a given time)
+struct osjob_t {
+    struct osjob_t *next;       //!< next job in queue
+    ostime_t        deadline;   //!< due time
+    osjobcb_t      *func;       //!< callback
+};
+typedef struct osjob_t osjob_t;
+
+ostime_t os_getTime(void);
+void os_setCallback(osjob_t *job, osjobcb_t *cb);
+void os_setTimedCallback(osjob_t *job, ostime_t time, osjobcb_t *cb);
+void os_clearCallback(osjob_t *job);
+void os_runloop_once(void);
+bit_t os_queryTimeCriticalJobs(ostime_t time);
+
+// HAL (radio registers are not simulated - reads return 0)
+void hal_spi_write(u1_t cmd, const u1_t *buf, size_t len);
+void hal_spi_read(u1_t cmd, u1_t *buf, size_t len);
+
+void LMIC_setClockError(u2_t error);
+void LMIC_shutdown(void);
+
+// Network time
+typedef void lmic_request_network_time_cb_t(void *pUserData, int flagSuccess);
+
+/// Network time reference
+struct lmic_time_reference_s {
+    ostime_t        tLocal;     //!< local time at end of uplink
+    lmic_gpstime_t  tNetwork;   //!< GPS time [s] at end of uplink
+};
+typedef struct lmic_time_reference_s lmic_time_reference_t;
+
+void LMIC_requestNetworkTime(lmic_request_network_time_cb_t *pCallbackfn, void *pUserData);
+int LMIC_getNetworkTimeReference(lmic_time_reference_t *pReference);
+
+// Host build only (see Arduino_LoRaWAN.cpp)
+
+/// Check if a network time request is pending
+bool hostLmicTimeRequested(void);
+
+/*!
+ * \brief Complete network time request.
+ *
+ * \param tLocal   local time at end of uplink
+ * \param time_ms  network time at end of uplink in ms since the epoch (0: no DeviceTimeAns)
+ */
+void hostLmicTimeResult(ostime_t tLocal, int64_t time_ms);
+
+#endif // ARDUINO_LMIC_H
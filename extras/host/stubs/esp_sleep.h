@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////
+// esp_sleep.h
+//
+// Host (Linux) build - ESP-IDF sleep stub
+//
+// Light sleep skips the time until the timer wake-up (see TicklessIdle).
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(ESP_SLEEP_H)
+#define ESP_SLEEP_H
+
+#include <stdint.h>
+#include <driver/gpio.h>
+#include "../host.h"
+
+typedef int esp_err_t;
+
+#define ESP_OK      0
+
+typedef enum {
+    ESP_SLEEP_WAKEUP_ALL = 0,
+    ESP_SLEEP_WAKEUP_TIMER = 4,
+    ESP_SLEEP_WAKEUP_GPIO = 7
+} esp_sleep_source_t;
+
+static uint64_t espSleepTimerUs;    //!< timer wake-up
+
+inline esp_err_t esp_sleep_enable_timer_wakeup(uint64_t time_in_us)
+{
+    espSleepTimerUs = time_in_us;
+    return ESP_OK;
+}
+
+inline esp_err_t esp_sleep_enable_gpio_wakeup(void)
+{
+    return ESP_OK;
+}
+
+inline esp_err_t esp_sleep_disable_wakeup_source(esp_sleep_source_t source)
+{
+    (void)source;
+    espSleepTimerUs = 0;
+    return ESP_OK;
+}
+
+inline esp_err_t esp_light_sleep_start(void)
+{
+    hostSkip(espSleepTimerUs);
+    return ESP_OK;
+}
+
+#endif // ESP_SLEEP_H
@@ -40,6 +40,7 @@
 // 20230927 Created from BresserWeatherSensorReceiver
 // 20231004 Added function names and line numbers to ESP8266/RP2040 debug logging
 // 20231005 Allowed re-definition of CORE_DEBUG_LEVEL and log_* macros
+// 20261017 Added per-subsystem log levels (LOG_LEVEL_<subsystem>, logm_*)
 //
 // ToDo:
 // - 
@@ -100,4 +101,42 @@
      #endif
 
 #endif // defined(ARDUINO_ARCH_RP2040)
+
+//
+// Per-subsystem log levels
+//
+// LOG_LEVEL_<subsystem> (ARDUHAL_LOG_LEVEL_*) can only lower CORE_DEBUG_LEVEL.
+// Default is CORE_DEBUG_LEVEL. Set in BresserWeatherSensorTTNCfg.h (for the sketch)
+// or as build flag, e.g. -DLOG_LEVEL_BLE=1 (for the sketch and the files in src/).
+//
+// logm_x(<subsystem>, ...) is resolved at compile time: if the level is disabled,
+// the call is removed as dead code - neither the format string nor the argument
+// evaluation end up in the binary. Code only required
+// for log output (e.g. buffers for hex dumps) can be excluded with
+//   #if LOG_ENABLED(<subsystem>, ARDUHAL_LOG_LEVEL_x)
+//
+#if !defined(LOG_LEVEL_LORAWAN)
+    #define LOG_LEVEL_LORAWAN   CORE_DEBUG_LEVEL    //!< LoRaWAN (join, session, uplink/downlink)
+#endif
+#if !defined(LOG_LEVEL_SENSOR)
+    #define LOG_LEVEL_SENSOR    CORE_DEBUG_LEVEL    //!< weather sensor and auxiliary sensors
+#endif
+#if !defined(LOG_LEVEL_BLE)
+    #define LOG_LEVEL_BLE       CORE_DEBUG_LEVEL    //!< BLE sensors
+#endif
+#if !defined(LOG_LEVEL_RTC)
+    #define LOG_LEVEL_RTC       CORE_DEBUG_LEVEL    //!< real time clock and time synchronization
+#endif
+#if !defined(LOG_LEVEL_PERSIST)
+    #define LOG_LEVEL_PERSIST   CORE_DEBUG_LEVEL    //!< preferences and session storage
+#endif
+
+#define LOG_ENABLED(sub, level) ((CORE_DEBUG_LEVEL >= (level)) && (LOG_LEVEL_##sub >= (level)))
+
+#define logm_e(sub, ...) do { if (LOG_ENABLED(sub, ARDUHAL_LOG_LEVEL_ERROR))   { log_e(__VA_ARGS__); } } while (0)
+#define logm_w(sub, ...) do { if (LOG_ENABLED(sub, ARDUHAL_LOG_LEVEL_WARN))    { log_w(__VA_ARGS__); } } while (0)
+#define logm_i(sub, ...) do { if (LOG_ENABLED(sub, ARDUHAL_LOG_LEVEL_INFO))    { log_i(__VA_ARGS__); } } while (0)
+#define logm_d(sub, ...) do { if (LOG_ENABLED(sub, ARDUHAL_LOG_LEVEL_DEBUG))   { log_d(__VA_ARGS__); } } while (0)
+#define logm_v(sub, ...) do { if (LOG_ENABLED(sub, ARDUHAL_LOG_LEVEL_VERBOSE)) { log_v(__VA_ARGS__); } } while (0)
+
 #endif // LOGGING_H
\ No newline at end of file
@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+
+#########################################################################################
+# Decode binary log (BINLOG_EN) dumped by BinLog::dump()
+#
+# Usage:
+# python3 scripts/binlog_decode.py <serial_log.txt> [<source_dir_or_file> ...]
+#
+# - <serial_log.txt>: serial output containing the dump, i.e. the lines
+#                     "BINLOG <words> <dropped>" and "BL: <hex words>"
+#                     (use '-' for stdin)
+# - <source_dir_or_file>: sketch sources containing the blog_*() calls
+#                     (default: the directory above this script)
+#
+# The format string IDs are FNV-1a hashes of the format strings (see src/BinLog/BinLog.h);
+# the format strings are found by scanning the source files for blog_e/w/i/d/v("...").
+#
+# created: 10/2026
+#
+# MIT License
+# Copyright (C) 10/2026 Matthias Prinke (https://github.com/matthias-bs)
+#
+# History:
+#
+# 20261017 Created
+#
+# To Do:
+# -
+#
+#########################################################################################
+import os
+import re
+import struct
+import sys
+
+LEVELS = {1: 'E', 2: 'W', 3: 'I', 4: 'D', 5: 'V'}
+
+# blog_x( followed by one or more adjacent string literals
+CALL_RE = re.compile(r'\bblog_[ewidv]\s*\(\s*((?:"(?:[^"\\]|\\.)*"\s*)+)')
+LITERAL_RE = re.compile(r'"((?:[^"\\]|\\.)*)"')
+SPEC_RE = re.compile(r'%([-+ #0]*)(\d+|\*)?(?:\.(\d+))?(hh|h|ll|l|z|j|t|L)?([diouxXeEfFgGaAcp%])')
+
+
+def fnv1a(data):
+    h = 2166136261
+    for b in data:
+        h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def unescape(s):
+    """C string literal contents -> bytes (UTF-8 source)"""
+    return s.encode('utf-8').decode('unicode_escape').encode('latin-1')
+
+
+def scan_sources(paths):
+    formats = {}
+    for path in paths:
+        files = []
+        if os.path.isdir(path):
+            for root, _, names in os.walk(path):
+                files += [os.path.join(root, n) for n in names if n.endswith(('.ino', '.h', '.cpp'))]
+        else:
+            files.append(path)
+        for name in files:
+            with open(name, encoding='utf-8', errors='replace') as f:
+                for m in CALL_RE.finditer(f.read()):
+                    fmt = b''.join(unescape(s) for s in LITERAL_RE.findall(m.group(1)))
+                    formats[fnv1a(fmt)] = fmt.decode('utf-8', errors='replace')
+    return formats
+
+
+def format_record(fmt, args):
+    """Format record with Python % operator - conversions derived from format specifiers"""
+    out = ''
+    pos = 0
+    for m in SPEC_RE.finditer(fmt):
+        out += fmt[pos:m.start()]
+        pos = m.end()
+        flags, width, prec, _, conv = m.groups()
+        if conv == '%':
+            out += '%'
+            continue
+        if not args:
+            out += '<?>'
+            continue
+        w = args.pop(0)
+        if conv in 'eEfFgGaA':
+            v = struct.unpack('<f', struct.pack('<I', w))[0]
+            conv = 'f' if conv in 'aA' else conv
+        elif conv in 'di':
+            v = w - (1 << 32) if w & 0x80000000 else w
+        elif conv == 'c':
+            v = chr(w & 0xFF)
+        else:
+            v = w
+            conv = 'x' if conv == 'p' else conv
+            conv = 'd' if conv == 'u' else conv
+        spec = '%' + flags + (width or '') + ('.' + prec if prec is not None else '') + conv
+        out += spec % v
+    return out + fmt[pos:]
+
+
+def read_dump(lines):
+    words = []
+    for line in lines:
+        line = line.strip()
+        if line.startswith('BINLOG'):
+            words = []
+            print('# {}'.format(line))
+        elif line.startswith('BL:'):
+            words += [int(w, 16) for w in line[3:].split()]
+    return words
+
+
+def main():
+    if len(sys.argv) < 2:
+        print('Usage: binlog_decode.py <serial_log.txt> [<source_dir_or_file> ...]')
+        sys.exit(1)
+    sources = sys.argv[2:] or [os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')]
+    formats = scan_sources(sources)
+
+    f = sys.stdin if sys.argv[1] == '-' else open(sys.argv[1], encoding='utf-8', errors='replace')
+    words = read_dump(f)
+
+    i = 0
+    while i + 2 <= len(words):
+        fmt_id, hdr = words[i], words[i + 1]
+        nargs = hdr & 0x1F
+        level = (hdr >> 5) & 0x7
+        ts = hdr >> 8
+        args = words[i + 2:i + 2 + nargs]
+        i += 2 + nargs
+        fmt = formats.get(fmt_id)
+        if fmt is None:
+            msg = '<unknown format 0x{:08X}> {}'.format(fmt_id, ' '.join('{:08X}'.format(a) for a in args))
+        else:
+            msg = format_record(fmt, list(args))
+        print('[{:8d}][{}] {}'.format(ts, LEVELS.get(level, '?'), msg))
+
+
+if __name__ == '__main__':
+    main()
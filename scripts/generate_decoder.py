@@ -4,15 +4,19 @@
 # Generate LoRaWAN Javascript payload decoder function from Arduino C++ header file
 #
 # Usage: 
-# g++ -dM -E BresserWeatherSensorTTNCfg.h | ~/generate_decoder.py
+# g++ -dM -E -include BresserWeatherSensorTTNCfg.h src/Payload/PayloadSchema.h | scripts/generate_decoder.py
 # or
-# g++ -dM -D<ARDUINO_BOARD> -E BresserWeatherSensorTTNCfg.h | ~/generate_decoder.py
+# g++ -dM -D<ARDUINO_BOARD> -E -include BresserWeatherSensorTTNCfg.h src/Payload/PayloadSchema.h | scripts/generate_decoder.py
 #
-# The C++ preprocessor is used to evaluate the defines in the header file. 
+# The C++ preprocessor is used to evaluate the defines in the header files. 
 # Its output is then passed to this script, which creates the decoder function call
 # to be copied into the Javascript decoder in the LoRaWAN Network provider's 
 # web interface.
 #
+# The payload layout is taken from the field table PAYLOAD_FIELDS in
+# src/Payload/PayloadSchema.h - the same table is used by the encoder in
+# BresserWeatherSensorTTN.ino, so the decoder always matches the firmware.
+#
 # created: 02/2023
 #
 # MIT License
@@ -22,6 +26,7 @@
 #
 # 20230221 Created
 # 20230716 Added lightning sensor data, split status bitmap in status_node and status
+# 20261017 Replaced generator dictionary by field table from src/Payload/PayloadSchema.h
 #
 # To Do:
 # - 
@@ -30,68 +35,20 @@
 import sys
 import re
 
-# List of known features
-features = [
-    'SENSORID_EN',
-    'ONEWIRE_EN',
-    'SLEEP_EN',
-    'THEENGSDECODER_EN',
-    'RAINDATA_EN',
-    'SOILSENSOR_EN',
-    'MITHERMOMETER_EN',
-    'DISTANCESENSOR_EN',
-    'LIGHTNINGSENSOR_EN',
-    'ADC_EN',
-    'PIN_ADC_IN',
-    'PIN_ADC0_IN',
-    'PIN_ADC1_IN',
-    'PIN_ADC2_IN',
-    'PIN_ADC3_IN',
-]
+# Maximum uplink payload size (PAYLOAD_SIZE in BresserWeatherSensorTTN.ino)
+PAYLOAD_SIZE = 51
 
-# Javascript decoder generator
-# 
-# The position in the dictionary below must match the order of assignments to the
-# encoder object in doUplink() (BresserWeatherSensorTTN.ino).
-# 
-# The position in the dictionary then defines the order in the output!  
-#
-# Format:
-#   <key> : {'cond': <condition>, 'type': <datatype>}
-#
-#   <key>       : JSON output key name
-#   <condition> : feature which must be present in input or '' if unconditional
-#   <datatype>  : decoder datatype (or rather name of decoding function)
-generator = {
-    'id' : {'cond': 'SENSORID_EN', 'type': 'uint32'},
-    'status_node' : {'cond': '', 'type': 'bitmap'},
-    'status' : {'cond': '', 'type': 'bitmap'},
-    'air_temp_c': {'cond': '', 'type': 'temperature'},
-    'humidity': {'cond': '', 'type': 'uint8'},
-    'wind_gust_meter_sec': {'cond': '', 'type': 'uint16fp1'},
-    'wind_avg_meter_sec': {'cond': '', 'type': 'uint16fp1'}, 
-    'wind_direction_deg': {'cond': '', 'type': 'uint16fp1'},
-    'rain_mm': {'cond': '', 'type': 'rawfloat'},
-    'supply_v': {'cond': 'ADC_EN', 'type': 'uint16'},
-    'battery_v': {'cond': 'PIN_ADC3_IN', 'type': 'uint16'},
-    'water_temp_c': {'cond': 'ONEWIRE_EN', 'type': 'temperature'},
-    'indoor_temp_c': {'cond': 'THEENGSDECODER_EN', 'type': 'temperature'},
-    'indoor_humidity': {'cond': 'THEENGSDECODER_EN', 'type': 'uint8'},
-    'indoor_temp_c': {'cond': 'MITHERMOMETER_EN', 'type': 'temperature'},
-    'indoor_humidity': {'cond': 'MITHERMOMETER_EN', 'type': 'uint8'},
-    'soil_temp_c': {'cond': 'SOILSENSOR_EN', 'type': 'temperature'}, 
-    'soil_moisture': {'cond': 'SOILSENSOR_EN', 'type': 'uint8'},
-    'rain_hr': {'cond': 'RAINDATA_EN', 'type': 'rawfloat'},
-    'rain_day': {'cond': 'RAINDATA_EN', 'type': 'rawfloat'},
-    'rain_week': {'cond': 'RAINDATA_EN', 'type': 'rawfloat'},
-    'rain_mon': {'cond': 'RAINDATA_EN', 'type': 'rawfloat'},
-    'adc0_v': {'cond': 'PIN_ADC0_IN', 'type': 'uint16'},
-    'adc1_v': {'cond': 'PIN_ADC1_IN', 'type': 'uint16'},
-    'adc2_v': {'cond': 'PIN_ADC2_IN', 'type': 'uint16'},
-    'distance_mm': {'cond': 'DISTANCESENSOR_EN', 'type': 'uint16'},
-    'lightning_time': {'cond': 'LIGHTNINGSENSOR_EN', 'type': 'unixtime'},
-    'lightning_count': {'cond': 'LIGHTNINGSENSOR_EN', 'type': 'uint16'},
-    'lightning_distance_km': {'cond': 'LIGHTNINGSENSOR_EN', 'type': 'uint8'},
+# Decoder datatypes (names of decoding functions) and their sizes in bytes
+type_size = {
+    'uint8': 1,
+    'bitmap_node': 1,
+    'bitmap_sensors': 1,
+    'uint16': 2,
+    'uint16fp1': 2,
+    'temperature': 2,
+    'uint32': 4,
+    'unixtime': 4,
+    'rawfloat': 4,
 }
 
 header = '''
@@ -107,37 +64,48 @@ footer = '''
     );
 '''[1:-1]
 
-# Process input from C-preprocessor 
-list=[]
+# Process input from C-preprocessor - collect all macro definitions
+defines = {}
 for line in sys.stdin:
-    line = line.removeprefix('#define')
-    
-    # remove leading whitespaces
-    line = line.lstrip()
-    
-    # remove trailing whitespaces
-    line = line.strip()
-    
-    # remove whitespaces followed by non-whitespaces at end of line
-    # e.g. "PIN_ADC0_IN A3" -> PIN_ADC0_IN
-    line = re.sub(r'\s+\S+$', '', line)
-    
-    # Add all known features from input to the list
-    if line in features:
-        list.append(line)
+    m = re.match(r'#define\s+(\w+)(\([^)]*\))?\s*(.*)$', line.strip())
+    if m:
+        defines[m.group(1)] = m.group(3).strip()
 
-# Print the list for debugging
-#print(list)
+if 'PAYLOAD_FIELDS' not in defines:
+    sys.exit("PAYLOAD_FIELDS not found in input - see usage in " + sys.argv[0])
+
+def resolve(token):
+    """Resolve macro until it does not expand any further"""
+    while token in defines:
+        token = defines[token]
+    return token
+
+# Parse field table: X(<key>, <type>, <enable>) ...
+fields = []
+for key, typ, en in re.findall(r'X\(\s*(\w+)\s*,\s*(\w+)\s*,\s*(\w+)\s*\)', defines['PAYLOAD_FIELDS']):
+    fields.append({'key': key, 'type': resolve(typ), 'cond': en, 'en': resolve(en) == '1'})
 
 # Generate the output
-for k,v in generator.items():
-    if v['cond'] == '' or v['cond'] in list:
-        types += ' ' * 12 + v['type'] + ',\n'
-        keys  += ' ' * 12 + k + ',\n'
+size = 0
+size_max = 0
+for f in fields:
+    size_max += type_size[f['type']]
+    if f['en']:
+        size += type_size[f['type']]
+        types += ' ' * 12 + f['type'] + ',\n'
+        keys  += ' ' * 12 + "'" + f['key'] + "',\n"
 
 # Print the result
+print(' ' * 4 + '// Payload size: {} bytes'.format(size))
 print(header)
-print(types)
-print(' ' * 8 + '],')
-print(keys)
+print(types + ' ' * 8 + '],')
+print(keys + ' ' * 8 + ']')
 print(footer)
+
+# Size check
+# The selected configuration is checked at compile time as well (static_assert);
+# additionally the size with all optional fields enabled is reported.
+print('Payload size: {} bytes (all features enabled: {} bytes, limit: {} bytes)'.format(
+      size, size_max, PAYLOAD_SIZE), file=sys.stderr)
+if size > PAYLOAD_SIZE:
+    sys.exit('Error: Payload size exceeds {} bytes!'.format(PAYLOAD_SIZE))
@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+
+#########################################################################################
+# Report flash/RAM usage for a set of log level configurations
+#
+# Usage:
+# python3 scripts/log_size_report.py [--fqbn <fqbn>] [--sketch <dir>] [--configs <file>]
+#
+# - <fqbn>:   fully qualified board name without DebugLevel option
+#             (default: esp32:esp32:ttgo-lora32)
+# - <dir>:    sketch directory (default: the directory above this script)
+# - <file>:   optional text file with one configuration per line:
+#             <name> <core debug level> [-DLOG_LEVEL_<subsystem>=<level> ...]
+#
+# Each configuration is compiled with arduino-cli; the sizes are taken from the
+# "Sketch uses..." and "Global variables use..." lines of the compiler output.
+# The start-up time cannot be determined here - run the builds on the target with
+# PHASE_TIMER_EN enabled and compare the "setup total" values.
+#
+# created: 10/2026
+#
+# MIT License
+# Copyright (C) 10/2026 Matthias Prinke (https://github.com/matthias-bs)
+#
+# History:
+#
+# 20261017 Created
+#
+# To Do:
+# -
+#
+#########################################################################################
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+# Name, DebugLevel menu option, extra flags
+DEFAULT_CONFIGS = [
+    ("none",           "none",    []),
+    ("error",          "error",   []),
+    ("info",           "info",    []),
+    ("verbose",        "verbose", []),
+    ("verbose-quiet",  "verbose", ["-DLOG_LEVEL_BLE=1", "-DLOG_LEVEL_RTC=1",
+                                   "-DLOG_LEVEL_PERSIST=1"]),
+    ("verbose-lorawan", "verbose", ["-DLOG_LEVEL_SENSOR=1", "-DLOG_LEVEL_BLE=1",
+                                    "-DLOG_LEVEL_RTC=1", "-DLOG_LEVEL_PERSIST=1"]),
+]
+
+RE_FLASH = re.compile(r"Sketch uses (\d+) bytes")
+RE_RAM = re.compile(r"Global variables use (\d+) bytes")
+
+
+def load_configs(fname):
+    configs = []
+    with open(fname) as f:
+        for line in f:
+            line = line.split("#", 1)[0].split()
+            if len(line) >= 2:
+                configs.append((line[0], line[1], line[2:]))
+    return configs
+
+
+def compile_size(fqbn, sketch, level, flags):
+    cmd = ["arduino-cli", "compile", "--fqbn", f"{fqbn}:DebugLevel={level}"]
+    if flags:
+        cmd += ["--build-property", "compiler.cpp.extra_flags=" + " ".join(flags)]
+    with tempfile.TemporaryDirectory() as build_dir:
+        cmd += ["--build-path", build_dir, sketch]
+        res = subprocess.run(cmd, capture_output=True, text=True)
+    if res.returncode != 0:
+        sys.stderr.write(res.stdout + res.stderr)
+        return None, None
+    flash = RE_FLASH.search(res.stdout)
+    ram = RE_RAM.search(res.stdout)
+    return (int(flash.group(1)) if flash else None,
+            int(ram.group(1)) if ram else None)
+
+
+def main():
+    default_sketch = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+    parser = argparse.ArgumentParser(description="Log level flash/RAM report")
+    parser.add_argument("--fqbn", default="esp32:esp32:ttgo-lora32")
+    parser.add_argument("--sketch", default=default_sketch)
+    parser.add_argument("--configs")
+    args = parser.parse_args()
+
+    configs = load_configs(args.configs) if args.configs else DEFAULT_CONFIGS
+
+    print(f"{'config':<16} {'flash':>9} {'ram':>8} {'d_flash':>9} {'d_ram':>8}  flags")
+    ref = None
+    for name, level, flags in configs:
+        flash, ram = compile_size(args.fqbn, args.sketch, level, flags)
+        if flash is None:
+            print(f"{name:<16} {'failed':>9}")
+            continue
+        if ref is None:
+            ref = (flash, ram or 0)
+        print(f"{name:<16} {flash:>9} {ram or 0:>8} {flash - ref[0]:>+9} "
+              f"{(ram or 0) - ref[1]:>+8}  {level} {' '.join(flags)}")
+
+
+if __name__ == "__main__":
+    main()
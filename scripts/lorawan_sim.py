@@ -0,0 +1,325 @@
+#!/usr/bin/env python3
+
+#########################################################################################
+# LoRaWAN network server simulation for BresserWeatherSensorTTN
+#
+# Usage:
+# scripts/lorawan_sim.py [--days 7] [--dr 5 | --dr 0,3,5] [--adr] [--snr 0] [--ack-loss 0.1]
+#                        [--downlink 3600:A80168 --downlink 7200:B1] [--trace] [--summary]
+#
+# Runs the host build of the sketch (extras/host, build with 'make -C extras/host')
+# in network simulation mode (bws_host --sim) and acts as its network server with
+# a virtual clock - no hardware, gateway or network server required. The node's
+# join handling, ReceiveCb() command parsing and doCfgUplink() replies are the
+# real firmware code; the LMIC radio is replaced by a stub which passes each frame
+# to this script (see extras/host/HostNet.cpp for the protocol):
+#
+# - OTAA join (join request/join accept)
+# - RX1/RX2 receive windows (EU868 timing, RX2 at DR3)
+# - ACKs of confirmed uplinks - lost with probability --ack-loss (uplink or
+#   downlink lost, i.e. nothing is received in RX1/RX2)
+# - DeviceTimeReq/DeviceTimeAns (network time)
+# - downlink commands on FPort 1, e.g. 0xA0 CMD_SET_WEATHERSENSOR_TIMEOUT,
+#   0xA8 CMD_SET_SLEEP_INTERVAL, 0xA9 CMD_SET_SLEEP_INTERVAL_LONG,
+#   0xB0 CMD_RESET_RAINGAUGE, 0xB1 CMD_GET_CONFIG (response on FPort 3),
+#   0x86 CMD_GET_DATETIME (response on FPort 2), 0x88 CMD_SET_DATETIME
+# - 1% duty cycle limit per sub-band (the transmission is delayed)
+# - the LMIC lowers the data rate before the 3rd, 5th and 7th transmission of a
+#   confirmed uplink - without ADR, the node does not return to the initial
+#   data rate ('DR end')
+# - ADR: every ADR_FRAMES uplinks, the data rate is raised/lowered according to
+#   the link margin (uplink SNR --snr - required SNR - ADR_MARGIN_DB), 3 dB per step
+#
+# The time-on-air and the time spent in each state are recorded; the energy
+# per day is estimated from the currents in CURRENT_MA (adjust for your board).
+# The awake time and the sensor reception time are reported by the node.
+#
+# created: 10/2026
+#
+# MIT License
+# Copyright (C) 10/2026 Matthias Prinke (https://github.com/matthias-bs)
+#
+# History:
+#
+# 20261017 Created
+#          Replaced model of the node by the host build of the sketch (bws_host --sim)
+#
+# To Do:
+# -
+#
+#########################################################################################
+import argparse
+import math
+import os
+import random
+import subprocess
+import sys
+
+# EU868 data rates: DR -> spreading factor (BW 125 kHz)
+DR_SF = {0: 12, 1: 11, 2: 10, 3: 9, 4: 8, 5: 7}
+
+# Required SNR [dB] for demodulation per data rate
+DR_SNR_MIN = {0: -20.0, 1: -17.5, 2: -15.0, 3: -12.5, 4: -10.0, 5: -7.5}
+
+# LoRaWAN MAC overhead: MHDR(1) + DevAddr(4) + FCtrl(1) + FCnt(2) + FPort(1) + MIC(4)
+MAC_OVERHEAD = 13
+JOIN_REQUEST_SIZE = 23
+JOIN_ACCEPT_SIZE = 17
+DEVICE_TIME_ANS_SIZE = 6
+LINK_ADR_REQ_SIZE = 5
+
+RX1_DELAY = 1.0         # [s]
+JOIN_RX1_DELAY = 5.0    # [s]
+RX2_DR = 3              # RX2 data rate (TTN EU868)
+RX_SYMS = 8             # receive window timeout if no preamble is detected [symbols]
+
+DUTY_CYCLE = 0.01       # 1% per sub-band
+ADR_FRAMES = 20         # uplinks between ADR decisions
+ADR_MARGIN_DB = 10.0    # installation margin [dB]
+
+# Supply currents [mA] per state (ESP32 + RFM95W - adjust for your board)
+CURRENT_MA = {
+    'awake':  40.0,     # CPU active, radio idle (boot, waiting for RX windows / duty cycle)
+    'sensor': 55.0,     # CPU active, radio in FSK receive mode
+    'tx':    120.0,     # LoRa transmit (14 dBm)
+    'rx':     50.0,     # CPU active, LoRa receive
+    'sleep':   0.01,    # deep sleep
+}
+VOLTAGE = 3.3           # [V]
+
+START = 1792195200      # simulation start (2026-10-17 00:00:00 UTC)
+
+BINARY = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'extras', 'host', 'bws_host')
+
+
+def airtime(payload_len, dr, preamble=8, crc=True, explicit_header=True):
+    """LoRa time-on-air [s] (Semtech AN1200.13), BW 125 kHz, CR 4/5"""
+    sf = DR_SF[dr]
+    t_sym = (2 ** sf) / 125000.0
+    de = 1 if sf >= 11 else 0
+    ih = 0 if explicit_header else 1
+    num = 8 * payload_len - 4 * sf + 28 + (16 if crc else 0) - 20 * ih
+    n_payload = 8 + max(math.ceil(num / (4.0 * (sf - 2 * de))) * 5, 0)
+    return (preamble + 4.25) * t_sym + n_payload * t_sym
+
+
+def rx_timeout(dr):
+    """Receive window duration [s] if nothing is received"""
+    return RX_SYMS * (2 ** DR_SF[dr]) / 125000.0
+
+
+def parse_fields(line):
+    """'KEY a=1 b=2' -> {'a': '1', 'b': '2'}"""
+    return dict(f.split('=', 1) for f in line.split()[1:] if '=' in f)
+
+
+class NetworkServer:
+    """Simulated network server: join, RX windows, ACKs, duty cycle, ADR, downlink queue"""
+
+    def __init__(self, ack_loss, downlinks, adr, snr, trace):
+        self.ack_loss = ack_loss
+        self.downlinks = sorted(downlinks)  # [(time [s], bytes)]
+        self.adr = adr
+        self.snr = snr
+        self.trace = trace
+        self.band_free = 0.0
+        self.fcnt_up = None
+        self.acked = True
+        self.adr_frames = 0
+        self.dr = None
+        self.airtime = 0.0
+        self.rx_time = 0.0
+        self.transmissions = 0
+        self.uplinks = 0
+        self.joins = 0
+        self.failed = 0
+        self.received = {}
+
+    def log(self, t, msg):
+        if self.trace:
+            print('{:10.2f} {}'.format(t - START, msg))
+
+    def rx_windows(self, end, rx1_delay, dr, downlink_len):
+        """Receive windows after TX; downlink_len: None - nothing received. Returns end of RX [s]"""
+        rx1 = end + rx1_delay
+        if downlink_len is not None:
+            t = airtime(downlink_len, dr, crc=False)
+            self.rx_time += t
+            return rx1 + t
+        # RX2 opens 1 s after RX1
+        self.rx_time += rx_timeout(dr) + rx_timeout(RX2_DR)
+        return rx1 + 1.0 + rx_timeout(RX2_DR)
+
+    def uplink(self, f):
+        """Process frame (fields of 'UP' line), returns response ('TX' line)"""
+        t = int(f['t']) / 1000.0
+        dr = int(f['dr'])
+        join = f['join'] == '1'
+        length = JOIN_REQUEST_SIZE if join else MAC_OVERHEAD + int(f['len']) + int(f['time_req'])
+
+        # Duty cycle: wait until sub-band is available
+        start = max(t, self.band_free)
+        t_air = airtime(length, dr)
+        end = start + t_air
+        self.band_free = end + t_air * (1 / DUTY_CYCLE - 1)
+        self.airtime += t_air
+        self.transmissions += 1
+        lost = random.random() < self.ack_loss
+        resp = {'start': start, 'ok': 0, 'snr': int(self.snr), 'dr': -1, 'port': 0, 'data': '', 'time': 0}
+
+        if join:
+            resp['ok'] = 0 if lost else 1
+            done = self.rx_windows(end, JOIN_RX1_DELAY, dr, None if lost else JOIN_ACCEPT_SIZE)
+            self.log(start, 'join request DR{} - {}'.format(dr, 'no answer' if lost else 'accepted'))
+            if not lost:
+                self.joins += 1
+                self.fcnt_up = None
+                self.acked = True
+                self.adr_frames = 0
+        else:
+            fcnt = int(f['fcnt'])
+            port = int(f['port'])
+            confirmed = f['confirmed'] == '1'
+            if fcnt != self.fcnt_up:
+                # New frame (retransmissions have the same FCnt)
+                if not self.acked:
+                    self.failed += 1
+                self.fcnt_up = fcnt
+                self.acked = not confirmed
+                self.uplinks += 1
+                self.adr_frames += 1
+                self.received[port] = self.received.get(port, 0) + 1
+            self.dr = dr
+            dl_len = None
+            downlink = None
+            mac = []
+            if not lost:
+                if self.downlinks and self.downlinks[0][0] <= t - START:
+                    downlink = self.downlinks.pop(0)[1]
+                    resp['port'] = 1
+                    resp['data'] = downlink.hex().upper()
+                if f['time_req'] == '1':
+                    # DeviceTimeAns: network time at end of uplink
+                    resp['time'] = int(end * 1000)
+                    mac.append('time')
+                if self.adr and self.adr_frames >= ADR_FRAMES:
+                    self.adr_frames = 0
+                    margin = self.snr - DR_SNR_MIN[dr] - ADR_MARGIN_DB
+                    new_dr = min(max(dr + int(math.floor(margin / 3)), 0), 5)
+                    if new_dr != dr:
+                        resp['dr'] = new_dr
+                        mac.append('ADR DR{}'.format(new_dr))
+                if confirmed:
+                    resp['ok'] = 1
+                    self.acked = True
+                if confirmed or downlink or mac:
+                    dl_len = MAC_OVERHEAD + (len(downlink) if downlink else -1) + \
+                        (DEVICE_TIME_ANS_SIZE if resp['time'] else 0) + \
+                        (LINK_ADR_REQ_SIZE if resp['dr'] >= 0 else 0)
+            done = self.rx_windows(end, RX1_DELAY, dr, dl_len)
+            self.log(start, 'uplink FCnt={} port={} {} bytes DR{} {} attempt {} - {}{}{}'.format(
+                fcnt, port, f['len'], dr, 'confirmed' if confirmed else 'unconfirmed', f['attempt'],
+                'lost' if lost else ('ACK' if resp['ok'] else 'received'),
+                ' - downlink: ' + ' '.join('{:02X}'.format(b) for b in downlink) if downlink else '',
+                ' - ' + ', '.join(mac) if mac else ''))
+
+        resp['done'] = done
+        return 'TX start={} done={} ok={} snr={} dr={} port={} data={} time={}'.format(
+            int(resp['start'] * 1000), int(resp['done'] * 1000), resp['ok'], resp['snr'], resp['dr'],
+            resp['port'], resp['data'], resp['time'])
+
+
+def parse_downlink(arg):
+    t, data = arg.split(':')
+    return float(t), bytes.fromhex(data)
+
+
+def run(args, dr):
+    random.seed(args.seed)
+    ns = NetworkServer(args.ack_loss, [parse_downlink(d) for d in args.downlink], args.adr, args.snr, args.trace)
+    cmd = [args.binary, '--sim', '--days', str(args.days), '--dr', str(dr), '--seed', str(args.seed),
+           '--sensor-loss', str(args.sensor_loss), '--battery', str(args.battery), '--start', str(START)]
+    proc = subprocess.Popen(cmd, stdin=subprocess.PIPE, stdout=subprocess.PIPE,
+                            stderr=None if args.log else subprocess.DEVNULL, text=True, bufsize=1)
+    time_in = {k: 0.0 for k in CURRENT_MA}
+    cycles = 0
+    summary = []
+    for line in proc.stdout:
+        line = line.rstrip('\n')
+        if line.startswith('UP '):
+            proc.stdin.write(ns.uplink(parse_fields(line)) + '\n')
+            proc.stdin.flush()
+        elif line.startswith('BOOT '):
+            cycles += 1
+            ns.log(int(parse_fields(line)['t']) / 1000.0, 'wake-up')
+        elif line.startswith('SLEEP '):
+            f = parse_fields(line)
+            time_in['awake'] += int(f['awake']) / 1e6
+            time_in['sensor'] += int(f['sensor']) / 1e6
+            time_in['sleep'] += int(f['duration']) / 1e6
+            ns.log(int(f['t']) / 1000.0, 'sleep {:.0f} s (awake {:.1f} s)'.format(
+                int(f['duration']) / 1e6, int(f['awake']) / 1e6))
+        else:
+            summary.append(line)
+    if proc.wait() != 0:
+        sys.exit('{} failed (exit code {})'.format(args.binary, proc.returncode))
+
+    # The awake time includes sensor reception, TX and RX
+    time_in['tx'] = ns.airtime
+    time_in['rx'] = ns.rx_time
+    time_in['awake'] = max(time_in['awake'] - time_in['sensor'] - ns.airtime - ns.rx_time, 0.0)
+    total = sum(time_in.values())
+    days = total / 86400
+    charge_mah = sum(CURRENT_MA[k] * t for k, t in time_in.items()) / 3600
+    return {
+        'dr': dr,
+        'cycles': cycles,
+        'uplinks_per_day': ns.uplinks / days,
+        'tx_per_day': ns.transmissions / days,
+        'joins': ns.joins,
+        'failed': ns.failed,
+        'airtime_per_day': ns.airtime / days,
+        'awake_per_day': (total - time_in['sleep']) / days,
+        'mah_per_day': charge_mah / days,
+        'j_per_day': charge_mah * 3.6 * VOLTAGE / days,
+        'received': ns.received,
+        'final_dr': ns.dr,
+        'summary': summary,
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description='LoRaWAN network server simulation for BresserWeatherSensorTTN')
+    parser.add_argument('--days', type=float, default=7, help='simulated time [days]')
+    parser.add_argument('--dr', default='5', help='initial data rate(s), e.g. 5 or 0,3,5')
+    parser.add_argument('--adr', action='store_true', help='network adjusts data rate to link margin')
+    parser.add_argument('--snr', type=float, default=0.0, help='uplink SNR at the gateway [dB] (ADR)')
+    parser.add_argument('--ack-loss', type=float, default=0.0, help='probability of lost uplink/ACK')
+    parser.add_argument('--sensor-loss', type=float, default=0.0, help='probability of lost weather sensor message')
+    parser.add_argument('--battery', type=int, default=4000, help='battery voltage [mV]')
+    parser.add_argument('--downlink', action='append', default=[],
+                        help='downlink <time [s]>:<hex bytes>, e.g. 3600:A80168 (may be repeated)')
+    parser.add_argument('--seed', type=int, default=1, help='random seed')
+    parser.add_argument('--binary', default=BINARY, help='host build of the sketch (bws_host)')
+    parser.add_argument('--trace', action='store_true', help='print events')
+    parser.add_argument('--log', action='store_true', help='show log output of the sketch')
+    parser.add_argument('--summary', action='store_true', help='print summary of host build (e.g. phase timing)')
+    args = parser.parse_args()
+
+    if not os.path.isfile(args.binary):
+        sys.exit('{} not found - build with: make -C extras/host'.format(args.binary))
+
+    print('{:>3} {:>6} {:>7} {:>9} {:>9} {:>6} {:>7} {:>11} {:>10} {:>9} {:>8}'.format(
+        'DR', 'DR end', 'cycles', 'uplinks/d', 'TX/d', 'joins', 'failed', 'airtime/d', 'awake/d', 'mAh/d', 'J/d'))
+    for dr in [int(x) for x in args.dr.split(',')]:
+        r = run(args, dr)
+        print('{:>3} {:>6} {:7d} {:9.1f} {:9.1f} {:6d} {:7d} {:10.1f}s {:9.0f}s {:9.2f} {:8.1f}'.format(
+            r['dr'], r['final_dr'], r['cycles'], r['uplinks_per_day'], r['tx_per_day'], r['joins'], r['failed'],
+            r['airtime_per_day'], r['awake_per_day'], r['mah_per_day'], r['j_per_day']))
+        print('    uplinks per FPort: {}'.format(dict(sorted(r['received'].items()))))
+        if args.summary:
+            print('\n'.join('    ' + s for s in r['summary']))
+
+
+if __name__ == '__main__':
+    main()
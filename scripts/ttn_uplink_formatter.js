@@ -24,10 +24,40 @@
 // -----------
 // CMD_GET_CONFIG   -> FPort=3: {"ws_timeout": <timeout_in_seconds>, 
 //                               "sleep_interval": <interval_in_seconds>,
-//                               "sleep_interval_long": <interval_in_seconds>}
+//                               "sleep_interval_long": <interval_in_seconds>
+//                              [, "cycle_uah": <charge>, "avg_cycle_uah": <charge>,
+//                                 "avg_cycle_s": <duration>, "battery_life_d": <days>]}
+//                              (energy summary with ENERGY_MODEL_EN)
 // 
 // CMD_GET_DATETIME -> FPort=2: {"epoch": <unix_epoch_time>, "rtc_source":<rtc_source>}
 //
+// Batched uplink (BATCH_EN):
+// ---------------------------
+// FPort=5: {"samples": [{"time": <unix_epoch_time>, "ws_batt_ok": <bool>, "air_temp_c": <temp>,
+//                        "humidity": <humidity>, "wind_gust_meter_sec": <speed>,
+//                        "wind_avg_meter_sec": <speed>, "wind_direction_deg": <direction>,
+//                        "rain_mm": <rain>}, ...]}
+//          Samples without weather sensor data only contain "time".
+//
+// Truncated uplink (TX_POLICY_EN):
+// ---------------------------------
+// FPort=8: same as FPort=1, but only the fields which fit into the max. payload size
+//          at the current data rate
+//
+// Diagnostic uplink (TELEMETRY_EN):
+// ----------------------------------
+// FPort=7: {"cycles": <n>, "tx_fail": <n>, "sleep_timeouts": <n>,
+//           "awake_ms": <histogram>, "sensor_rx_ms": <histogram>,
+//           "ble_scan_ms": <histogram>, "join_attempts": <histogram>}
+//          <histogram>: {"<lower bound>": <count>, ...} (logarithmic buckets)
+//
+// Lightning event history (LIGHTNING_HISTORY_EN):
+// -----------------------------------------------
+// FPort=9: {"events": [{"time": <unix_epoch_time>, "strikes": <n>, "distance_km": <distance>}, ...]
+//           [, "overflow": {"events": <n>, "strikes": <n>, "min_distance_km": <distance>,
+//                           "time_last": <unix_epoch_time>}]}
+//          "overflow": events which did not fit into the event list (count only)
+//
 // <timeout_in_seconds> : 0...255
 // <interval>           : 0...65535
 // <epoch>              : unix epoch time, see https://www.epochconverter.com/
@@ -67,6 +97,12 @@
 //
 // History:
 // 20230821 Created
+// 20261017 Added batched uplink (FPort 5)
+//          Added multi-sensor uplink (FPort 6)
+//          Added energy summary in CMD_GET_CONFIG response (FPort 3)
+//          Added diagnostic uplink (FPort 7)
+//          Added truncated uplink (FPort 8)
+//          Added lightning event history (FPort 9)
 //
 // ToDo:
 // -  
@@ -287,6 +323,153 @@ function ttn_decoder(bytes, port) {
         }, {});
     };
 
+    // Lightning event history (see src/LightningHistory/LightningHistory.h)
+    var lightning = function(bytes) {
+        var n = bytes[0] & 0x7F;
+        var ovf = (bytes[0] & 0x80) !== 0;
+        var len = 5 + n * 5 + (ovf ? 6 : 0);
+        if (bytes.length < len) {
+            throw new Error('Lightning frame with ' + n + ' events must have ' + len + ' bytes');
+        }
+        var time = unixtime(bytes.slice(1, 5));
+        var events = [];
+        for (var i = 0; i < n; i++) {
+            var b = bytes.slice(5 + i * 5, 5 + (i + 1) * 5);
+            time += uint16(b.slice(0, 2)) * 60;
+            events.push({time: time, strikes: uint16(b.slice(2, 4)), distance_km: b[4]});
+        }
+        var res = {events: events};
+        if (ovf) {
+            var o = bytes.slice(5 + n * 5, 5 + n * 5 + 6);
+            res.overflow = {
+                events: o[0],
+                strikes: uint16(o.slice(1, 3)),
+                min_distance_km: o[3],
+                time_last: time + uint16(o.slice(4, 6)) * 60
+            };
+        }
+        return res;
+    };
+
+    // Diagnostic frame with log2 histograms (see src/Telemetry/Telemetry.h)
+    var telemetry = function(bytes) {
+        if (bytes.length < 35) {
+            throw new Error('Telemetry frame too short: ' + bytes.length);
+        }
+        var hist = function(offset, shift) {
+            var res = {};
+            for (var k = 0; k < 8; k++) {
+                // bucket k: lower bound 2^(k-1) (scaled by 2^shift), bucket 0: 0
+                res[k === 0 ? 0 : Math.pow(2, k - 1 + shift)] = bytes[offset + k];
+            }
+            return res;
+        };
+        return {
+            cycles: bytes[0],
+            tx_fail: bytes[1],
+            sleep_timeouts: bytes[2],
+            awake_ms: hist(3, 10),
+            sensor_rx_ms: hist(11, 9),
+            ble_scan_ms: hist(19, 9),
+            join_attempts: hist(27, 0)
+        };
+    };
+
+    // Batched weather sensor samples (see src/SampleBatch/SampleBatch.h)
+    var batch = function(bytes) {
+        var n = bytes[0];
+        if (bytes.length < 9 + n * 10) {
+            throw new Error('Batch with ' + n + ' samples must have ' + (9 + n * 10) + ' bytes');
+        }
+        var base_time = unixtime(bytes.slice(1, 5));
+        var base_rain = parseFloat(rawfloat(bytes.slice(5, 9)));
+        var samples = [];
+        for (var i = 0; i < n; i++) {
+            var b = bytes.slice(9 + i * 10, 9 + (i + 1) * 10);
+            var sample = {time: base_time + uint16(b.slice(0, 2))};
+            if ((b[4] & 0x7F) !== 0x7F) {
+                var rain = uint16(b.slice(8, 10));
+                sample.ws_batt_ok = (b[4] & 0x80) !== 0;
+                sample.air_temp_c = temperature(b.slice(2, 4));
+                sample.humidity = b[4] & 0x7F;
+                sample.wind_gust_meter_sec = (b[5] * 0.2).toFixed(1);
+                sample.wind_avg_meter_sec = (b[6] * 0.2).toFixed(1);
+                sample.wind_direction_deg = b[7] * 2;
+                if (rain !== 0xFFFF) {
+                    sample.rain_mm = (base_rain + rain * 0.1).toFixed(1);
+                }
+            }
+            samples.push(sample);
+        }
+        return {samples: samples};
+    };
+
+    // Multi-sensor records (see src/MultiSensor/MultiSensor.h)
+    var multi = function(bytes) {
+        var int16 = function(b) {
+            var i = b[0] | (b[1] << 8);
+            return ((i & 0x8000) ? i - 0x10000 : i) / 10;
+        };
+        var res = {
+            seq: bytes[0] >> 4,
+            frame: (bytes[0] >> 1) & 0x07,
+            last: (bytes[0] & 0x01) !== 0,
+            sensors: []
+        };
+        var offset = 1;
+        while (offset < bytes.length) {
+            var tag = bytes[offset];
+            var type = tag >> 4;
+            var s = {batt_ok: (tag & 0x08) !== 0};
+            if (type === 4) {
+                s.type = 'ble';
+                s.index = bytes[offset + 1];
+                offset += 2;
+                s.temp_c = int16(bytes.slice(offset, offset + 2)).toFixed(1);
+                s.humidity = bytes[offset + 2];
+                s.batt_level = bytes[offset + 3];
+                offset += 4;
+            } else {
+                s.id = uint32(bytes.slice(offset + 1, offset + 5));
+                offset += 5;
+                if (type === 1) {
+                    s.type = 'weather';
+                    if (tag & 0x01) {
+                        s.air_temp_c = int16(bytes.slice(offset, offset + 2)).toFixed(1);
+                        if (bytes[offset + 2] !== 0xFF) {
+                            s.humidity = bytes[offset + 2];
+                        }
+                        offset += 3;
+                    }
+                    if (tag & 0x02) {
+                        s.wind_gust_meter_sec = uint16fp1(bytes.slice(offset, offset + 2));
+                        s.wind_avg_meter_sec = uint16fp1(bytes.slice(offset + 2, offset + 4));
+                        s.wind_direction_deg = uint16fp1(bytes.slice(offset + 4, offset + 6));
+                        offset += 6;
+                    }
+                    if (tag & 0x04) {
+                        s.rain_mm = (uint32(bytes.slice(offset, offset + 4)) / 10).toFixed(1);
+                        offset += 4;
+                    }
+                } else if (type === 2) {
+                    s.type = 'soil';
+                    s.soil_temp_c = int16(bytes.slice(offset, offset + 2)).toFixed(1);
+                    s.soil_moisture = bytes[offset + 2];
+                    offset += 3;
+                } else if (type === 3) {
+                    s.type = 'lightning';
+                    s.lightning_events = uint16(bytes.slice(offset, offset + 2));
+                    s.lightning_distance_km = bytes[offset + 2];
+                    offset += 3;
+                } else {
+                    throw new Error('Unknown record type ' + type);
+                }
+            }
+            res.sensors.push(s);
+        }
+        return res;
+    };
+
     if (typeof module === 'object' && typeof module.exports !== 'undefined') {
         module.exports = {
             unixtime: unixtime,
@@ -303,6 +486,10 @@ function ttn_decoder(bytes, port) {
             rawfloat: rawfloat,
             uint16fp1: uint16fp1,
             rtc_source: rtc_source,
+            batch: batch,
+            multi: multi,
+            telemetry: telemetry,
+            lightning: lightning,
             decode: decode
         };
     }
@@ -312,24 +499,35 @@ function ttn_decoder(bytes, port) {
     }
 
     
-    if (port === 1) {
-        return decode(
-            bytes,
+    if ((port === 1) || (port === 8)) {
+        var mask =
         [   bitmap_node,        bitmap_sensors,     temperature,    uint8,
             uint16fp1,          uint16fp1,          uint16fp1,
             rawfloat,           uint16,             temperature,
             temperature,        uint8,              temperature,    uint8, 
             rawfloat,           rawfloat,           rawfloat,       rawfloat,           
             unixtime,           uint16,             uint8
-        ],
+        ];
+        var names =
         [   'status_node',      'status',           'air_temp_c',   'humidity',
             'wind_gust_meter_sec', 'wind_avg_meter_sec', 'wind_direction_deg',
             'rain_mm',          'supply_v',         'water_temp_c', 
             'indoor_temp_c',    'indoor_humidity',  'soil_temp_c',  'soil_moisture', 
             'rain_hr',          'rain_day',         'rain_week',    'rain_mon',
             'lightning_time',   'lightning_events',  'lightning_distance_km'
-        ]
-        );
+        ];
+        if (port === 8) {
+            // Truncated payload (TX_POLICY_EN) - decode complete fields only
+            var len = 0;
+            var n = 0;
+            while ((n < mask.length) && (len + mask[n].BYTES <= bytes.length)) {
+                len += mask[n].BYTES;
+                n++;
+            }
+            mask = mask.slice(0, n);
+            names = names.slice(0, n);
+        }
+        return decode(bytes, mask, names);
     } else if  (port === 2) {
         return decode(
             bytes,
@@ -339,6 +537,18 @@ function ttn_decoder(bytes, port) {
             ]
         );
     } else if (port === 3) {
+        if (bytes.length >= 13) {
+            // with energy summary (ENERGY_MODEL_EN)
+            return decode(
+                bytes,
+                [ uint8, uint16BE, uint16BE,
+                  uint16BE, uint16BE, uint16BE, uint16BE
+                ],
+                ['ws_timeout', 'sleep_interval', 'sleep_interval_long',
+                 'cycle_uah', 'avg_cycle_uah', 'avg_cycle_s', 'battery_life_d'
+                ]
+            );
+        }
                 return decode(
             bytes,
             [ uint8, uint16BE, uint16BE 
@@ -346,6 +556,14 @@ function ttn_decoder(bytes, port) {
             ['ws_timeout', 'sleep_interval', 'sleep_interval_long'
             ]
         );
+    } else if (port === 5) {
+        return batch(bytes);
+    } else if (port === 6) {
+        return multi(bytes);
+    } else if (port === 7) {
+        return telemetry(bytes);
+    } else if (port === 9) {
+        return lightning(bytes);
     }
 
 }
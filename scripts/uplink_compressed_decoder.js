@@ -0,0 +1,204 @@
+///////////////////////////////////////////////////////////////////////////////
+// uplink_compressed_decoder.js
+//
+// Bresser 5-in-1/6-in-1 868 MHz Weather Sensor Radio Receiver
+// based on ESP32 and RFM95W -
+// sends data to a LoRaWAN network (e.g. The Things Network)
+//
+// This script decodes the delta/varint compressed uplink payload (FPort 4,
+// see src/Payload/PayloadCompressor.h) from bytes to JSON.
+//
+// Delta frames can only be decoded if their reference frame is known, i.e.
+// the decoder is stateful and can NOT be used as TTN uplink payload formatter.
+// Use it where state can be kept between uplinks, e.g. in a Node-RED
+// function node:
+//
+//   var dec = global.get('uplink_compressed_decoder'); // require()'d module
+//   var state = context.get('pl_state') || {};
+//   msg.payload = dec.decodeCompressed(msg.payload.uplink_message.frm_payload_bytes, state);
+//   context.set('pl_state', state);
+//   return msg;
+//
+// The field list FIELDS must match the node's configuration - it is
+// identical to the FPort 1 mask/names which are printed by
+//   g++ -dM -E -include BresserWeatherSensorTTNCfg.h src/Payload/PayloadSchema.h | python3 scripts/generate_decoder.py
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+// 20261017 Created
+//          Fixed rounding of negative rawfloat values
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// [<name>, <type>] - order and enabled fields must match the node's configuration
+var FIELDS = [
+    ['status_node',             'bitmap_node'],
+    ['status',                  'bitmap_sensors'],
+    ['air_temp_c',              'temperature'],
+    ['humidity',                'uint8'],
+    ['wind_gust_meter_sec',     'uint16fp1'],
+    ['wind_avg_meter_sec',      'uint16fp1'],
+    ['wind_direction_deg',      'uint16fp1'],
+    ['rain_mm',                 'rawfloat'],
+    ['supply_v',                'uint16'],
+    ['indoor_temp_c',           'temperature'],
+    ['indoor_humidity',         'uint8'],
+    ['soil_temp_c',             'temperature'],
+    ['soil_moisture',           'uint8'],
+    ['rain_hr',                 'rawfloat'],
+    ['rain_day',                'rawfloat'],
+    ['rain_week',               'rawfloat'],
+    ['rain_mon',                'rawfloat'],
+    ['lightning_time',          'unixtime'],
+    ['lightning_count',         'uint16'],
+    ['lightning_distance_km',   'uint8']
+];
+
+var TYPE_BYTES = {
+    uint8: 1, bitmap_node: 1, bitmap_sensors: 1,
+    uint16: 2, uint16fp1: 2, temperature: 2,
+    uint32: 4, unixtime: 4, rawfloat: 4
+};
+
+var BITMAP_NAMES = {
+    bitmap_node:    ['res7', 'res6', 'res5', 'res4', 'res3', 'res2', 'res1', 'res0'],
+    bitmap_sensors: ['res0', 'ble_ok', 'ls_dec_ok', 'ls_batt_ok', 's1_dec_ok', 's1_batt_ok', 'ws_dec_ok', 'ws_batt_ok']
+};
+
+// Read field from keyframe and convert to quantized integer (see PayloadCompressor::quantize())
+function readQuantized(bytes, offset, type) {
+    var i;
+    switch (type) {
+        case 'temperature':
+            // Big Endian, signed; resolution 0.01
+            i = (bytes[offset] << 8) | bytes[offset + 1];
+            return (i & 0x8000) ? i - 0x10000 : i;
+        case 'rawfloat':
+            var bits = bytes[offset + 3] << 24 | bytes[offset + 2] << 16 | bytes[offset + 1] << 8 | bytes[offset];
+            var sign = (bits >>> 31 === 0) ? 1.0 : -1.0;
+            var e = bits >>> 23 & 0xff;
+            var m = (e === 0) ? (bits & 0x7fffff) << 1 : (bits & 0x7fffff) | 0x800000;
+            // Round half away from zero like lround() in PayloadCompressor::quantize()
+            return sign * Math.round(m * Math.pow(2, e - 150) * 10);
+        default:
+            // Little Endian, unsigned
+            i = 0;
+            for (var x = 0; x < TYPE_BYTES[type]; x++) {
+                i += bytes[offset + x] * Math.pow(2, x * 8);
+            }
+            return i;
+    }
+}
+
+// Convert quantized integer to output value (same format as ttn_uplink_formatter.js)
+function dequantize(q, type) {
+    switch (type) {
+        case 'temperature':
+            return (q / 100).toFixed(1);
+        case 'rawfloat':
+        case 'uint16fp1':
+            return (q / 10).toFixed(1);
+        case 'bitmap_node':
+        case 'bitmap_sensors':
+            return BITMAP_NAMES[type].reduce(function (obj, pos, index) {
+                obj[pos] = ((q >> (7 - index)) & 1) === 1;
+                return obj;
+            }, {});
+        case 'uint32':
+        case 'unixtime':
+            return q >>> 0;
+        default:
+            return q;
+    }
+}
+
+// Decode compressed frame; state: {frames: {<seq>: <quantized values>}} - kept by caller
+function decodeCompressed(bytes, state) {
+    var seq = bytes[0] & 0x7F;
+    var values = [];
+    var offset;
+    var i;
+
+    state.frames = state.frames || {};
+
+    if (bytes[0] & 0x80) {
+        // Keyframe
+        offset = 1;
+        for (i = 0; i < FIELDS.length; i++) {
+            values.push(readQuantized(bytes, offset, FIELDS[i][1]));
+            offset += TYPE_BYTES[FIELDS[i][1]];
+        }
+    } else {
+        // Delta frame
+        var ref = state.frames[bytes[1]];
+        if (ref === undefined) {
+            throw new Error('Reference frame #' + bytes[1] + ' unknown');
+        }
+        offset = 2 + Math.ceil(FIELDS.length / 8);
+        for (i = 0; i < FIELDS.length; i++) {
+            var q = ref[i];
+            if (bytes[2 + (i >> 3)] & (1 << (i & 7))) {
+                // unsigned LEB128 varint
+                var zz = 0;
+                var shift = 0;
+                var b;
+                do {
+                    b = bytes[offset++];
+                    zz += (b & 0x7F) * Math.pow(2, shift);
+                    shift += 7;
+                } while (b & 0x80);
+                // zigzag decoding
+                var delta = (zz % 2) ? -(zz + 1) / 2 : zz / 2;
+                q = q + delta;
+                if (FIELDS[i][1] === 'uint32' || FIELDS[i][1] === 'unixtime') {
+                    q = q >>> 0;
+                }
+            }
+            values.push(q);
+        }
+    }
+
+    // Any frame received may become a reference frame
+    state.frames[seq] = values;
+
+    var res = {};
+    for (i = 0; i < FIELDS.length; i++) {
+        res[FIELDS[i][0]] = dequantize(values[i], FIELDS[i][1]);
+    }
+    return res;
+}
+
+if (typeof module === 'object' && typeof module.exports !== 'undefined') {
+    module.exports = {
+        FIELDS: FIELDS,
+        decodeCompressed: decodeCompressed
+    };
+}
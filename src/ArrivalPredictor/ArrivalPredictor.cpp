@@ -0,0 +1,154 @@
+///////////////////////////////////////////////////////////////////////////////
+// ArrivalPredictor.cpp
+//
+// Prediction of weather sensor transmission times for wake-up scheduling
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//          Limited period measurement to every n-th wake cycle
+//          Added restart()
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ArrivalPredictor.h"
+#include "../../logging.h"
+
+void ArrivalPredictor::begin(void)
+{
+    if (_state->magic != ARRIVAL_MAGIC) {
+        memset(_state, 0, sizeof(arrival_state_t));
+        _state->magic = ARRIVAL_MAGIC;
+    }
+}
+
+void ArrivalPredictor::rxStart(int64_t now_ms)
+{
+    if (_state->planned_wake_ms == 0) {
+        return;
+    }
+
+    int64_t delay_ms = now_ms - _state->planned_wake_ms;
+    _state->planned_wake_ms = 0;
+
+    // Ignore implausible values, e.g. wake-up by reset
+    if ((delay_ms < -(int64_t)_period_max_ms) || (delay_ms > (int64_t)_period_max_ms)) {
+        return;
+    }
+
+    // Exponential smoothing (weight 1/4)
+    _state->boot_delay_ms += ((int32_t)delay_ms - _state->boot_delay_ms) / 4;
+    log_d("Wake-up delay: %d ms, learned: %d ms", (int)delay_ms, (int)_state->boot_delay_ms);
+}
+
+void ArrivalPredictor::arrival(int64_t now_ms)
+{
+    const int64_t period_us = _state->period_us;
+
+    // Check prediction
+    if ((period_us != 0) && (_state->predicted_ms != 0)) {
+        int64_t err_ms = now_ms - _state->predicted_ms;
+        log_d("Arrival prediction error: %d ms", (int)err_ms);
+        if ((err_ms * 4000 > period_us) || (-err_ms * 4000 > period_us)) {
+            if (++_state->misses >= ARRIVAL_MAX_MISSES) {
+                log_d("Prediction failed - measuring period again");
+                _state->period_us = 0;
+                _state->samples   = 0;
+                _state->misses    = 0;
+            }
+        } else {
+            _state->misses = 0;
+        }
+        _state->predicted_ms = 0;
+    }
+
+    if (_state->last_ms != 0) {
+        int64_t interval_ms = now_ms - _state->last_ms;
+
+        if (_state->period_us == 0) {
+            // Direct measurement - consecutive messages
+            if ((interval_ms > 0) && (interval_ms <= _period_max_ms)) {
+                _state->period_us = interval_ms * 1000;
+                _state->samples   = 1;
+                log_d("Period measured: %u ms", (unsigned)interval_ms);
+            }
+        } else if (interval_ms > 0) {
+            // Refinement - interval is a multiple of the period
+            int64_t k = (interval_ms * 1000 + (int64_t)_state->period_us / 2) / _state->period_us;
+            if (k >= 1) {
+                int64_t p_us = interval_ms * 1000 / k;
+                int64_t diff_us = p_us - _state->period_us;
+                // Only accept small corrections (< 2%)
+                if ((diff_us * 50 < (int64_t)_state->period_us) && (-diff_us * 50 < (int64_t)_state->period_us)) {
+                    if (_state->samples < ARRIVAL_SAMPLES_MAX) {
+                        _state->samples++;
+                    }
+                    _state->period_us += diff_us / _state->samples;
+                    log_d("Period refined: %u us (k=%d)", (unsigned)_state->period_us, (int)k);
+                }
+            }
+        }
+    }
+    _state->last_ms = now_ms;
+}
+
+bool ArrivalPredictor::measure(void)
+{
+    if (periodValid()) {
+        return false;
+    }
+    if (_state->learn_wait > 0) {
+        _state->learn_wait--;
+        log_d("Period measurement in %u cycles", _state->learn_wait + 1);
+        return false;
+    }
+    _state->learn_wait = _learn_interval - 1;
+    return true;
+}
+
+int64_t ArrivalPredictor::wakeTime(int64_t target_ms, uint32_t guard_ms)
+{
+    if (!periodValid()) {
+        return target_ms;
+    }
+
+    // Expected transmission closest to the target time
+    const int64_t period_us = _state->period_us;
+    int64_t n = ((target_ms - _state->last_ms) * 1000 + period_us / 2) / period_us;
+    int64_t arrival_ms = _state->last_ms + n * period_us / 1000;
+
+    _state->predicted_ms    = arrival_ms;
+    _state->planned_wake_ms = arrival_ms - guard_ms - _state->boot_delay_ms;
+    log_d("Expected arrival: target %+d ms", (int)(arrival_ms - target_ms));
+
+    return _state->planned_wake_ms;
+}
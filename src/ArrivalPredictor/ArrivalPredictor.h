@@ -0,0 +1,169 @@
+///////////////////////////////////////////////////////////////////////////////
+// ArrivalPredictor.h
+//
+// Prediction of weather sensor transmission times for wake-up scheduling
+//
+// Bresser sensors transmit at a fixed period. The arrival times of sensor
+// messages are recorded across deep sleep cycles in a state buffer provided
+// by the caller (e.g. in RTC RAM). From these, the transmission period and
+// phase are estimated, and the wake-up time is set shortly (guard time)
+// before the next expected transmission.
+//
+// Period estimation:
+// - Initially, the period is measured directly from two consecutive
+//   messages received in the same wake cycle (interval <= max. period).
+//   Since this requires extended reception, a measurement is only
+//   attempted every <learn_interval>-th wake cycle (see measure()).
+// - Afterwards, the period is refined from the interval between arrivals
+//   in different wake cycles, which is an integer multiple of the period.
+// - If the prediction fails repeatedly, the period is measured again.
+//
+// Wake-up error correction:
+// The delay between the planned wake-up time and the start of reception
+// (boot time and sleep timer inaccuracy) is learned and subtracted
+// from the wake-up time.
+//
+// All times are in milliseconds since the epoch (node's clock).
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//          Limited period measurement to every n-th wake cycle
+//          Added restart()
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(ARRIVAL_PREDICTOR_H)
+#define ARRIVAL_PREDICTOR_H
+
+#include <Arduino.h>
+
+#define ARRIVAL_MAGIC           0x41525231  // "ARR1"
+#define ARRIVAL_MAX_MISSES      3           //!< max. consecutive prediction failures before period is measured again
+#define ARRIVAL_SAMPLES_MAX     8           //!< averaging weight limit for period refinement
+
+/// Predictor state - must be retained across deep sleep (e.g. in RTC RAM)
+struct ArrivalStateS {
+    uint32_t magic;             //!< validation of retained data
+    uint32_t period_us;         //!< estimated transmission period [us] (0: unknown)
+    uint8_t  samples;           //!< number of period estimates
+    uint8_t  misses;            //!< consecutive prediction failures
+    uint8_t  learn_wait;        //!< wake cycles until next period measurement
+    int32_t  boot_delay_ms;     //!< learned delay from planned wake-up to start of reception
+    int64_t  last_ms;           //!< last arrival time (0: none)
+    int64_t  predicted_ms;      //!< predicted arrival time for current wake cycle (0: none)
+    int64_t  planned_wake_ms;   //!< planned wake-up time (0: none)
+};
+
+typedef struct ArrivalStateS arrival_state_t; //!< Shortcut for struct ArrivalStateS
+
+
+/*!
+  \class ArrivalPredictor
+  \brief Prediction of weather sensor transmission times for wake-up scheduling
+*/
+class ArrivalPredictor {
+    public:
+        /*!
+        \brief Constructor.
+
+        \param state            Predictor state (retained across deep sleep)
+        \param period_max_ms    Max. plausible transmission period in ms
+        \param learn_interval   Wake cycles between period measurements
+        */
+        ArrivalPredictor(arrival_state_t *state, uint32_t period_max_ms, uint8_t learn_interval = 1) {
+            _state = state;
+            _period_max_ms = period_max_ms;
+            _learn_interval = (learn_interval > 0) ? learn_interval : 1;
+        };
+
+        /*!
+        \brief Initialization - clears state if retained data is invalid.
+        */
+        void begin(void);
+
+        /*!
+        \brief Reception has been started - update learned wake-up delay.
+
+        \param now_ms   Current time
+        */
+        void rxStart(int64_t now_ms);
+
+        /*!
+        \brief Sensor message has been received - update period/phase estimate.
+
+        \param now_ms   Current time
+        */
+        void arrival(int64_t now_ms);
+
+        /*!
+        \brief Check if transmission period is known.
+        */
+        bool periodValid(void) {
+            return (_state->period_us != 0) && (_state->last_ms != 0);
+        };
+
+        /*!
+        \brief Check if period shall be measured in the current wake cycle.
+
+        Must be called once per wake cycle (after arrival()).
+
+        \returns true if period is unknown and measurement is due
+        */
+        bool measure(void);
+
+        /*!
+        \brief Discard last arrival time - the next arrival() does not measure the period.
+
+        Used if messages may have been missed since the last call of arrival().
+        */
+        void restart(void) {
+            _state->last_ms = 0;
+        };
+
+        /*!
+        \brief Get wake-up time for the expected transmission closest to the target time.
+
+        \param target_ms    Target wake-up time (e.g. aligned to sleep interval)
+        \param guard_ms     Guard time before the expected transmission
+
+        \returns Wake-up time - target_ms if period is unknown
+        */
+        int64_t wakeTime(int64_t target_ms, uint32_t guard_ms);
+
+    protected:
+        arrival_state_t *_state;            //!< predictor state
+        uint32_t        _period_max_ms;     //!< max. plausible transmission period
+        uint8_t         _learn_interval;    //!< wake cycles between period measurements
+};
+
+#endif // ARRIVAL_PREDICTOR_H
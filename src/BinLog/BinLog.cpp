@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////////////////
+// BinLog.cpp
+//
+// Deferred binary logging into a RAM ring buffer
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "BinLog.h"
+
+void BinLog::put(const uint32_t *words, uint8_t n)
+{
+    if (n > _size) {
+        return;
+    }
+
+    // Discard oldest records
+    while (_state->used + n > _size) {
+        uint16_t tail = (_state->head + _size - _state->used) % _size;
+        uint8_t  len  = 2 + (_buf[(tail + 1) % _size] & 0x1F);
+        _state->used -= (len < _state->used) ? len : _state->used;
+        _state->dropped++;
+    }
+
+    for (uint8_t i=0; i < n; i++) {
+        _buf[_state->head] = words[i];
+        _state->head = (_state->head + 1) % _size;
+    }
+    _state->used += n;
+}
+
+void BinLog::dump(Print &out)
+{
+    uint16_t idx = (_state->head + _size - _state->used) % _size;
+
+    out.printf("BINLOG %u %u\n", _state->used, (unsigned)_state->dropped);
+    for (uint16_t i=0; i < _state->used; i++) {
+        if (i % 8 == 0) {
+            out.print((i == 0) ? "BL:" : "\nBL:");
+        }
+        out.printf(" %08X", (unsigned)_buf[idx]);
+        idx = (idx + 1) % _size;
+    }
+    out.println();
+}
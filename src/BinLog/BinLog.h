@@ -0,0 +1,193 @@
+///////////////////////////////////////////////////////////////////////////////
+// BinLog.h
+//
+// Deferred binary logging into a RAM ring buffer
+//
+// Instead of formatting a message at run time, only a hash of the format
+// string (calculated at compile time) and the raw argument values are
+// stored. The ring buffer can be dumped (as hex words) on demand and is
+// decoded on the host by scripts/binlog_decode.py, which finds the format
+// strings by scanning the source files for blog_*() calls.
+//
+// Record format (32-bit words)
+// -----------------------------
+// word 0:      format string ID (FNV-1a hash, see BinLog::hash())
+// word 1:      bits 31:8 timestamp (millis(), modulo 2^24)
+//              bits  7:5 log level (ARDUHAL_LOG_LEVEL_*)
+//              bits  4:0 number of arguments
+// word 2..:    arguments - integers are stored as 32-bit values,
+//              floating point values as IEEE 754 single precision
+//
+// If the buffer is full, the oldest records are discarded.
+//
+// Dump format
+// ------------
+// BINLOG <words> <dropped>
+// BL: <word> <word> ... (max. 8 hex words per line, oldest first)
+//
+// Note:
+// Only integer and floating point arguments are supported - strings
+// (%s) must be logged with log_*().
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(BIN_LOG_H)
+#define BIN_LOG_H
+
+#include <Arduino.h>
+#include <string.h>
+#include <type_traits>
+
+#define BINLOG_MAGIC        0x424C4F47 // "BLOG"
+#define BINLOG_ARGS_MAX     31
+
+/// Format string ID - evaluated at compile time
+#define BINLOG_ID(fmt) (std::integral_constant<uint32_t, BinLog::hash(fmt)>::value)
+
+/// Ring buffer state - must be retained across deep sleep (e.g. in RTC RAM)
+struct BinLogStateS {
+    uint32_t magic;         //!< validation of retained data
+    uint16_t head;          //!< index of next word to be written
+    uint16_t used;          //!< number of words used
+    uint32_t dropped;       //!< number of records discarded
+};
+
+typedef struct BinLogStateS binlog_state_t; //!< Shortcut for struct BinLogStateS
+
+
+/*!
+  \class BinLog
+  \brief Deferred binary logging into a RAM ring buffer
+*/
+class BinLog {
+    public:
+        /*!
+        \brief Constructor.
+
+        \param state    Ring buffer state (retained across deep sleep)
+        \param buf      Ring buffer (retained across deep sleep)
+        \param words    Size of ring buffer in 32-bit words
+        */
+        BinLog(binlog_state_t *state, uint32_t *buf, uint16_t words) {
+            _state = state;
+            _buf   = buf;
+            _size  = words;
+        };
+
+        /*!
+        \brief Initialization - clears buffer if retained data is invalid.
+        */
+        void begin(void) {
+            if ((_state->magic != BINLOG_MAGIC) || (_state->head >= _size) || (_state->used > _size)) {
+                clear();
+            }
+        };
+
+        /*!
+        \brief Clear buffer.
+        */
+        void clear(void) {
+            _state->magic   = BINLOG_MAGIC;
+            _state->head    = 0;
+            _state->used    = 0;
+            _state->dropped = 0;
+        };
+
+        /*!
+        \brief FNV-1a hash of format string.
+
+        \param s    Format string
+        \param h    Hash value of preceding characters
+
+        \returns Hash value
+        */
+        static constexpr uint32_t hash(const char *s, uint32_t h = 2166136261UL) {
+            return (*s == '\0') ? h : hash(s + 1, (h ^ (uint8_t)*s) * 16777619UL);
+        };
+
+        /*!
+        \brief Write record.
+
+        \param level    Log level (ARDUHAL_LOG_LEVEL_*)
+        \param id       Format string ID (BINLOG_ID(fmt))
+        \param args     Arguments (integer or floating point)
+        */
+        template<typename... Args>
+        void write(uint8_t level, uint32_t id, Args... args) {
+            static_assert(sizeof...(args) <= BINLOG_ARGS_MAX, "Too many arguments");
+            const uint32_t words[] = {
+                id,
+                (uint32_t)(((millis() & 0xFFFFFF) << 8) | ((level & 0x7) << 5) | sizeof...(args)),
+                toWord(args)...
+            };
+            put(words, sizeof(words) / sizeof(uint32_t));
+        };
+
+        /*!
+        \brief Dump buffer as hex words (oldest first).
+
+        \param out  Output stream, e.g. Serial
+        */
+        void dump(Print &out);
+
+    protected:
+        binlog_state_t  *_state;    //!< ring buffer state
+        uint32_t        *_buf;      //!< ring buffer
+        uint16_t        _size;      //!< size of ring buffer in words
+
+        /*!
+        \brief Write record to ring buffer - discards oldest records if required.
+        */
+        void put(const uint32_t *words, uint8_t n);
+
+        static uint32_t toWord(float v) {
+            uint32_t w;
+            memcpy(&w, &v, sizeof(w));
+            return w;
+        };
+
+        static uint32_t toWord(double v) {
+            return toWord((float)v);
+        };
+
+        template<typename T>
+        static uint32_t toWord(T v) {
+            static_assert(std::is_integral<T>::value || std::is_enum<T>::value, "Unsupported argument type");
+            return (uint32_t)v;
+        };
+};
+
+#endif
@@ -35,6 +35,15 @@
 // History:
 //
 // 20230211 Created
+// 20261017 Added startScan()/waitScan() for non-blocking scan
+//          Added native decoding of ATC1441/pvvx formats and MAC address
+//          lookup before decoding (Theengs Decoder only for known devices)
+//          Replaced linear search by hash table lookup, discard duplicates
+//          by decoded flags
+//          BLE initialization and scan callback object only once,
+//          initialization time is measured and checked against budget
+//          Added passive scan and adaptive scan duration/duty cycle
+//          Log output with subsystem log level (LOG_LEVEL_BLE)
 //
 // ToDo:
 // - 
@@ -44,42 +53,91 @@
 #if !defined(ARDUINO_ADAFRUIT_FEATHER_ESP32S2) && !defined(ARDUINO_ARCH_RP2040)
 
 #include "BleSensors.h"
+#include "../../logging.h"
+
+uint64_t BleSensors::macToInt(const std::string &mac)
+{
+    uint64_t res = 0;
+    unsigned digits = 0;
+
+    for (char c : mac) {
+        uint8_t nibble;
+        if ((c >= '0') && (c <= '9')) {
+            nibble = c - '0';
+        } else if ((c >= 'a') && (c <= 'f')) {
+            nibble = c - 'a' + 10;
+        } else if ((c >= 'A') && (c <= 'F')) {
+            nibble = c - 'A' + 10;
+        } else {
+            continue;
+        }
+        res = (res << 4) | nibble;
+        digits++;
+    }
+    return (digits == 12) ? res : 0;
+}
+
+// Advertising data types / service UUIDs
+#define BLE_AD_TYPE_SERVICE_DATA_16     0x16    //!< Service Data - 16-bit UUID
+#define BLE_UUID_ENV_SENSING            0x181A  //!< Environmental Sensing (ATC1441/pvvx custom firmware)
+#define BLE_ATC1441_LEN                 15      //!< UUID + ATC1441 format
+#define BLE_PVVX_LEN                    17      //!< UUID + pvvx custom format
 
 class MyAdvertisedDeviceCallbacks: public NimBLEAdvertisedDeviceCallbacks {
 public:
   NimBLEScan*                   m_pBLEScan;
-  std::vector<std::string>      m_knownBLEAddresses;
+  BleSensors*                   m_pBleSensors;
   std::vector<ble_sensors_t>*   m_sensorData;
 
 private:
-  int m_devices_found = 0; //!< Number of known devices found
+  /*
+   * Decode ATC1441/pvvx custom firmware formats directly from advertising payload
+   * (Service Data, UUID 0x181A) - no heap allocation
+   *
+   * ATC1441 (big endian):  MAC[6], temp [0.1 degC] int16, hum [%] uint8, batt [%] uint8, batt [mV] uint16, cnt uint8
+   * pvvx (little endian):  MAC[6], temp [0.01 degC] int16, hum [0.01 %] uint16, batt [mV] uint16, batt [%] uint8, cnt uint8, flags uint8
+   */
+  bool decodeNative(const uint8_t *payload, size_t len, ble_sensors_t &data) {
+    size_t pos = 0;
 
-  std::string convertServiceData(std::string deviceServiceData) {
-    int serviceDataLength = (int)deviceServiceData.length();
-    char spr[2 * serviceDataLength + 1];
-    for (int i = 0; i < serviceDataLength; i++) sprintf(spr + 2 * i, "%.2x", (unsigned char)deviceServiceData[i]);
-    spr[2 * serviceDataLength] = 0;
-    return spr;
+    // Iterate over AD structures: <length> <type> <data[length-1]>
+    while (pos + 1 < len) {
+      const uint8_t ad_len = payload[pos];
+      if ((ad_len == 0) || (pos + 1 + ad_len > len))
+        break;
+
+      const uint8_t  ad_type = payload[pos + 1];
+      const uint8_t *d = &payload[pos + 2];
+      const uint8_t  d_len = ad_len - 1;
+
+      if ((ad_type == BLE_AD_TYPE_SERVICE_DATA_16) && (d_len >= 2) &&
+          ((d[0] | (d[1] << 8)) == BLE_UUID_ENV_SENSING)) {
+        if (d_len == BLE_ATC1441_LEN) {
+          data.temperature = (int16_t)((d[8] << 8) | d[9]) / 10.0;
+          data.humidity    = d[10];
+          data.batt_level  = d[11];
+          return true;
+        }
+        if (d_len == BLE_PVVX_LEN) {
+          data.temperature = (int16_t)(d[8] | (d[9] << 8)) / 100.0;
+          data.humidity    = (uint16_t)(d[10] | (d[11] << 8)) / 100.0;
+          data.batt_level  = d[14];
+          return true;
+        }
+      }
+      pos += 1 + ad_len;
+    }
+    return false;
   }
 
-  void onResult(BLEAdvertisedDevice* advertisedDevice) {
+  // Decode other sensor types with Theengs Decoder
+  bool decodeTheengs(BLEAdvertisedDevice* advertisedDevice, ble_sensors_t &data) {
     TheengsDecoder decoder;
-    bool device_found = false;
-    unsigned idx;
     JsonDocument doc;
-
-    log_v("Advertised Device: %s", advertisedDevice->toString().c_str());
     JsonObject BLEdata = doc.to<JsonObject>();
     String mac_adress = advertisedDevice->getAddress().toString().c_str();
    
     BLEdata["id"] = (char*)mac_adress.c_str();
-    for (idx = 0; idx < m_knownBLEAddresses.size(); idx++) {
-        if (mac_adress == m_knownBLEAddresses[idx].c_str()) {
-            log_v("BLE device found at index %d", idx);
-            device_found = true;
-            break;
-        }
-    }
     
     if (advertisedDevice->haveName())
       BLEdata["name"] = (char*)advertisedDevice->getName().c_str();
@@ -106,32 +164,61 @@ private:
       }
     }
 
-    if (decoder.decodeBLEJson(BLEdata) && device_found) {
-      if (CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_DEBUG) {
-        char buf[512];
-        serializeJson(BLEdata, buf);
-        log_d("TheengsDecoder found device: %s", buf);
-      }
-      BLEdata.remove("manufacturerdata");
-      BLEdata.remove("servicedata");
-      
-      // see https://stackoverflow.com/questions/5348089/passing-a-vector-between-functions-via-pointers
-      (*m_sensorData)[idx].temperature  = (float)BLEdata["tempc"];
-      (*m_sensorData)[idx].humidity     = (float)BLEdata["hum"];
-      (*m_sensorData)[idx].batt_level   = (uint8_t)BLEdata["batt"];
-      (*m_sensorData)[idx].rssi         = (int)BLEdata["rssi"];
-      (*m_sensorData)[idx].valid        = ((*m_sensorData)[idx].batt_level > 0);
-      log_i("Temperature:       %.1f°C", (*m_sensorData)[idx].temperature);
-      log_i("Humidity:          %.1f%%", (*m_sensorData)[idx].humidity);
-      log_i("Battery level:     %d%%",   (*m_sensorData)[idx].batt_level);
-      log_i("RSSI:             %ddBm",   (*m_sensorData)[idx].rssi = (int)BLEdata["rssi"]);
-      m_devices_found++;   
-      log_d("BLE devices found: %d", m_devices_found);
+    if (!decoder.decodeBLEJson(BLEdata))
+      return false;
+
+    #if LOG_ENABLED(BLE, ARDUHAL_LOG_LEVEL_DEBUG)
+      char buf[512];
+      serializeJson(BLEdata, buf);
+      log_d("TheengsDecoder found device: %s", buf);
+    #endif
+    data.temperature  = (float)BLEdata["tempc"];
+    data.humidity     = (float)BLEdata["hum"];
+    data.batt_level   = (uint8_t)BLEdata["batt"];
+    return true;
+  }
+
+  std::string convertServiceData(std::string deviceServiceData) {
+    int serviceDataLength = (int)deviceServiceData.length();
+    char spr[2 * serviceDataLength + 1];
+    for (int i = 0; i < serviceDataLength; i++) sprintf(spr + 2 * i, "%.2x", (unsigned char)deviceServiceData[i]);
+    spr[2 * serviceDataLength] = 0;
+    return spr;
+  }
+
+  void onResult(BLEAdvertisedDevice* advertisedDevice) {
+    // Fast path: discard unknown devices by MAC address (native byte order: LSB first)
+    const uint8_t *addr = advertisedDevice->getAddress().getNative();
+    uint64_t mac = 0;
+    for (int i = 5; i >= 0; i--) {
+      mac = (mac << 8) | addr[i];
     }
+    int idx = m_pBleSensors->lookup(mac);
+    if ((idx < 0) || m_pBleSensors->isDecoded(idx))
+      return;
+
+    logm_v(BLE, "BLE device found at index %d", idx);
+    ble_sensors_t &data = (*m_sensorData)[idx];
+    
+    bool decoded = decodeNative(advertisedDevice->getPayload(), advertisedDevice->getPayloadLength(), data);
+    if (!decoded) {
+      // Fallback for other sensor types
+      decoded = decodeTheengs(advertisedDevice, data);
+    }
+    if (!decoded)
+      return;
+
+    data.rssi  = advertisedDevice->getRSSI();
+    data.valid = (data.batt_level > 0);
+    logm_i(BLE, "Temperature:       %.1f°C", data.temperature);
+    logm_i(BLE, "Humidity:          %.1f%%", data.humidity);
+    logm_i(BLE, "Battery level:     %d%%",   data.batt_level);
+    logm_i(BLE, "RSSI:             %ddBm",   data.rssi);
+    m_pBleSensors->setDecoded(idx);
     
     // Abort scanning because all known devices have been found
-    if (m_devices_found == m_knownBLEAddresses.size()) {
-      log_i("All devices found.");
+    if (m_pBleSensors->complete()) {
+      logm_i(BLE, "All devices found.");
       m_pBLEScan->stop();
     }
   }
@@ -143,12 +230,22 @@ void BleSensors::resetData(void)
     for (int i=0; i < _known_sensors.size(); i++) {
         data[i].valid = false;
     }
+    memset(_decoded, 0, sizeof(_decoded));
+    _num_decoded = 0;
 }
 
 /**
- * \brief Get BLE sensor data
+ * \brief Initialize BLE and scan parameters
  */
-unsigned BleSensors::getData(uint32_t duration) {
+void BleSensors::initScan(void) {
+    if (_pBLEScan != nullptr) {
+        // Already initialized - only clear results of previous scan
+        _pBLEScan->clearResults();
+        return;
+    }
+    
+    uint32_t t_start = millis();
+    
     // From https://github.com/theengs/decoder/blob/development/examples/ESP32/ScanAndDecode/ScanAndDecode.ino:
     // MyAdvertisedDeviceCallbacks are still triggered multiple times; this makes keeping track of received
     // sensors difficult. Setting ScanFilterMode to CONFIG_BTDM_SCAN_DUPL_TYPE_DATA_DEVICE seems to
@@ -161,22 +258,159 @@ unsigned BleSensors::getData(uint32_t duration) {
     _pBLEScan = NimBLEDevice::getScan(); //create new scan
     
     // Set the callback for when devices are discovered, no duplicates.
-    //_pBLEScan->setAdvertisedDeviceCallbacks(new MyAdvertisedDeviceCallbacks(), false);
+    // The callback object is allocated once and refers to this object's data.
     MyAdvertisedDeviceCallbacks *myCb = new MyAdvertisedDeviceCallbacks();
-    
-    // Copy some data required by the Callback
     myCb->m_pBLEScan = _pBLEScan;
-    myCb->m_knownBLEAddresses = _known_sensors;
+    myCb->m_pBleSensors = this;
     myCb->m_sensorData = &data;
+    _pCallbacks = myCb;
     
-    _pBLEScan->setAdvertisedDeviceCallbacks(myCb);
-    _pBLEScan->setActiveScan(true); // Set active scanning, this will get more data from the advertiser.
+    _pBLEScan->setAdvertisedDeviceCallbacks(_pCallbacks);
+    _pBLEScan->setActiveScan(!_passive); // Set active scanning, this will get more data from the advertiser.
     _pBLEScan->setInterval(97); // How often the scan occurs / switches channels; in milliseconds,
     _pBLEScan->setWindow(37);  // How long to scan during the interval; in milliseconds.
     _pBLEScan->setMaxResults(0); // do not store the scan results, use callback only.
+    
+    _init_ms = millis() - t_start;
+    if (_init_ms > BLE_INIT_BUDGET_MS) {
+        logm_w(BLE, "BLE init: %u ms (budget: %u ms)", (unsigned)_init_ms, (unsigned)BLE_INIT_BUDGET_MS);
+    } else {
+        logm_d(BLE, "BLE init: %u ms", (unsigned)_init_ms);
+    }
+}
+
+/**
+ * \brief Initialization with adaptive scan
+ */
+void BleSensors::begin(ble_scan_state_t *state, bool passive) {
+    _state   = state;
+    _passive = passive;
+    
+    if ((_state != nullptr) && (_state->magic != BLE_SCAN_MAGIC)) {
+        memset(_state, 0, sizeof(ble_scan_state_t));
+        _state->magic = BLE_SCAN_MAGIC;
+        _state->duty_level = BLE_DUTY_LEVELS - 1;
+        for (int i = 0; i < BLE_SENSORS_MAX; i++) {
+            _state->latency[i] = BLE_LATENCY_UNKNOWN;
+        }
+    }
+}
+
+/**
+ * \brief Prepare scan - set scan parameters and get duration
+ */
+uint32_t BleSensors::prepareScan(uint32_t duration) {
+    // Scan window for each duty cycle level; scan interval is 97 ms
+    static const uint16_t window[BLE_DUTY_LEVELS] = {37, 65, 97};
+    
+    _scan_start_ms = millis();
+    _latency_ms = 0;
+    if (_state == nullptr) {
+        _scan_duration = duration;
+        return duration;
+    }
+    
+    // Expected max. latency - full duration if any sensor has not been found yet
+    uint32_t max_latency = 0;
+    for (size_t i = 0; i < _known_sensors.size(); i++) {
+        if (_state->latency[i] == BLE_LATENCY_UNKNOWN) {
+            max_latency = duration * 1000;
+            break;
+        }
+        if (_state->latency[i] > max_latency) {
+            max_latency = _state->latency[i];
+        }
+    }
+    uint32_t adaptive = (2 * max_latency + BLE_SCAN_MARGIN_MS + 999) / 1000;
+    if (adaptive < duration) {
+        duration = adaptive;
+    }
+    
+    _pBLEScan->setWindow(window[_state->duty_level]);
+    logm_d(BLE, "BLE scan: %u s, window %u ms", (unsigned)duration, window[_state->duty_level]);
+    _scan_duration = duration;
+    
+    return duration;
+}
+
+/**
+ * \brief Evaluate scan results and update adaptive scan state
+ */
+void BleSensors::finishScan(void) {
+    if (_latency_ms) {
+        logm_i(BLE, "BLE scan complete after %u ms", (unsigned)_latency_ms);
+    } else {
+        logm_i(BLE, "BLE scan incomplete (%u/%u sensors)", _num_decoded, (unsigned)_known_sensors.size());
+    }
+    if (_state == nullptr)
+        return;
+    
+    for (size_t i = 0; i < _known_sensors.size(); i++) {
+        if (!isDecoded(i)) {
+            // Not found - scan for full duration next time
+            _state->latency[i] = BLE_LATENCY_UNKNOWN;
+        } else if (_state->latency[i] == BLE_LATENCY_UNKNOWN) {
+            _state->latency[i] = (_found_ms[i] < BLE_LATENCY_UNKNOWN) ? _found_ms[i] : BLE_LATENCY_UNKNOWN - 1;
+        } else {
+            // Exponential smoothing (alpha = 1/4); track increases immediately
+            uint32_t lat = (3 * _state->latency[i] + _found_ms[i]) / 4;
+            if (_found_ms[i] > lat) {
+                lat = _found_ms[i];
+            }
+            _state->latency[i] = (lat < BLE_LATENCY_UNKNOWN) ? lat : BLE_LATENCY_UNKNOWN - 1;
+        }
+    }
+    
+    // Adapt duty cycle: increase after missed sensors, decrease after BLE_DUTY_STEP_DOWN complete scans
+    if (!complete()) {
+        _state->complete_cnt = 0;
+        if (_state->duty_level < BLE_DUTY_LEVELS - 1) {
+            _state->duty_level++;
+        }
+    } else if (++_state->complete_cnt >= BLE_DUTY_STEP_DOWN) {
+        _state->complete_cnt = 0;
+        if (_state->duty_level > 0) {
+            _state->duty_level--;
+        }
+    }
+}
+
+/**
+ * \brief Get BLE sensor data
+ */
+unsigned BleSensors::getData(uint32_t duration) {
+    initScan();
+    duration = prepareScan(duration);
     _pBLEScan->start(duration, false /* is_continue */);
+    finishScan();
     
     return 0;
 }
 
+/**
+ * \brief Start BLE scan (non-blocking)
+ */
+void BleSensors::startScan(uint32_t duration) {
+    initScan();
+    duration = prepareScan(duration);
+    _scanStarted = _pBLEScan->start(duration, nullptr, false /* is_continue */);
+    logm_d(BLE, "BLE scan started: %d", _scanStarted);
+}
+
+/**
+ * \brief Wait for completion of BLE scan
+ */
+bool BleSensors::waitScan(void) {
+    if (!_scanStarted) {
+        return false;
+    }
+    while (_pBLEScan->isScanning()) {
+        delay(10);
+    }
+    _scanStarted = false;
+    finishScan();
+    
+    return true;
+}
+
 #endif
@@ -35,6 +35,15 @@
 // History:
 //
 // 20230211 Created
+// 20261017 Added startScan()/waitScan() for non-blocking scan
+//          Added native decoding of ATC1441/pvvx formats and MAC address
+//          lookup before decoding (Theengs Decoder only for known devices)
+//          Added hash table for MAC address lookup, decoded flags
+//          and getValid()
+//          BLE initialization and scan callback object only once,
+//          added initTime() and BLE_INIT_BUDGET_MS
+//          Added passive scan and adaptive scan duration/duty cycle
+//          (scan state retained across deep sleep), added scanLatency()
 //
 // ToDo:
 // - 
@@ -49,6 +58,22 @@
 #include <NimBLEDevice.h>       //!< https://github.com/h2zero/NimBLE-Arduino
 #include <decoder.h>            //!< https://github.com/theengs/decoder
 
+#if !defined(BLE_SENSORS_MAX)
+#define BLE_SENSORS_MAX     32      //!< Max. number of known sensors
+#endif
+#if !defined(BLE_INIT_BUDGET_MS)
+#define BLE_INIT_BUDGET_MS  300     //!< Expected max. BLE initialization time; a warning is logged if exceeded
+#endif
+#if !defined(BLE_SCAN_MARGIN_MS)
+#define BLE_SCAN_MARGIN_MS  2000    //!< Adaptive scan: margin added to max. expected latency
+#endif
+#define BLE_SCAN_MAGIC      0x424C5331  //!< Scan state validation ("BLS1")
+#define BLE_LATENCY_UNKNOWN 0xFFFF      //!< Scan state: no latency history available
+#define BLE_DUTY_LEVELS     3           //!< Adaptive scan: number of duty cycle levels
+#define BLE_DUTY_STEP_DOWN  8           //!< Adaptive scan: complete scans before reducing duty cycle
+#define BLE_TABLE_BITS      7       //!< log2 of MAC address table size
+#define BLE_TABLE_SIZE      (1 << BLE_TABLE_BITS) //!< MAC address table size (load factor <= 0.25)
+
 // Local Sensor Data
 struct BleDataS {
       bool     valid;              //!< data valid
@@ -60,6 +85,16 @@ struct BleDataS {
 
 typedef struct BleDataS ble_sensors_t; //!< Shortcut for struct BleDataS
 
+/// Adaptive scan state - must be retained across deep sleep (e.g. in RTC RAM)
+struct BleScanStateS {
+    uint32_t magic;                     //!< validation of retained data
+    uint8_t  duty_level;                //!< duty cycle level (0: lowest)
+    uint8_t  complete_cnt;              //!< consecutive complete scans
+    uint16_t latency[BLE_SENSORS_MAX];  //!< smoothed time from scan start until sensor was found in ms
+};
+
+typedef struct BleScanStateS ble_scan_state_t; //!< Shortcut for struct BleScanStateS
+
 
 /*!
   \class Ble_Sensors
@@ -74,8 +109,87 @@ class BleSensors {
         */
         BleSensors(std::vector<std::string> known_sensors) {
             _known_sensors = known_sensors;
-            data.resize(known_sensors.size());
+            if (_known_sensors.size() > BLE_SENSORS_MAX) {
+                _known_sensors.resize(BLE_SENSORS_MAX);
+            }
+            memset(_mac_table, 0, sizeof(_mac_table));
+            for (size_t i = 0; i < _known_sensors.size(); i++) {
+                insert(macToInt(_known_sensors[i]), i);
+            }
+            data.resize(_known_sensors.size());
+        };
+
+        /*!
+        \brief Find known sensor by MAC address.
+        
+        \param mac          MAC address as 48-bit integer
+        
+        \returns Sensor index (into data) or -1 if unknown
+        */
+        int lookup(uint64_t mac) const {
+            unsigned pos = hash(mac);
+            
+            for (unsigned n = 0; n < BLE_TABLE_SIZE; n++) {
+                if (_mac_table[pos].idx == 0)
+                    return -1;
+                if (_mac_table[pos].mac == mac)
+                    return _mac_table[pos].idx - 1;
+                pos = (pos + 1) & (BLE_TABLE_SIZE - 1);
+            }
+            return -1;
+        };
+        
+        /*!
+        \brief Mark sensor as decoded in current scan.
+        
+        \param idx          Sensor index
+        
+        \returns false if sensor had already been decoded before, true otherwise
+        */
+        bool setDecoded(int idx) {
+            const uint32_t mask = 1UL << (idx & 31);
+            
+            if (_decoded[idx >> 5] & mask)
+                return false;
+            _decoded[idx >> 5] |= mask;
+            _num_decoded++;
+            _found_ms[idx] = millis() - _scan_start_ms;
+            if (complete()) {
+                _latency_ms = _found_ms[idx];
+            }
+            return true;
         };
+        
+        /*!
+        \brief Check if sensor has already been decoded in current scan.
+        */
+        bool isDecoded(int idx) const {
+            return (_decoded[idx >> 5] >> (idx & 31)) & 1;
+        };
+        
+        /*!
+        \brief Check if all known sensors have been decoded in current scan.
+        */
+        bool complete(void) const {
+            return _num_decoded >= _known_sensors.size();
+        };
+        
+        /*!
+        \brief Get index of n-th valid sensor data set.
+        
+        \param n            Ordinal number of valid data set (0...)
+        
+        \returns Index into data or -1 if not available
+        */
+        int getValid(unsigned n = 0) const {
+            for (size_t i = 0; i < data.size(); i++) {
+                if (data[i].valid && (n-- == 0))
+                    return i;
+            }
+            return -1;
+        };
+
+        static uint64_t macToInt(const std::string &mac);
 
         /*!
         \brief Initialization.
@@ -83,6 +197,19 @@ class BleSensors {
         void begin(void) {
         };
         
+        /*!
+        \brief Initialization with adaptive and/or passive scan.
+        
+        Scan duration and duty cycle (window/interval) are adapted based on
+        the time needed to find each known sensor in previous scans.
+        The scan duration passed to getData()/startScan() is used as upper limit.
+        
+        \param state        Scan state (retained across deep sleep); nullptr: fixed scan parameters
+        \param passive      Use passive scanning - sufficient if no data from scan responses
+                            is required (e.g. ATC1441/pvvx custom firmware formats)
+        */
+        void begin(ble_scan_state_t *state, bool passive);
+        
         /*!
         \brief Delete results from BLEScan buffer to release memory.
         */        
@@ -96,7 +223,39 @@ class BleSensors {
         \param duration     Scan duration in seconds
         */                
         unsigned getData(uint32_t duration);
+
+        /*!
+        \brief Start BLE scan without blocking - sensor data is available after waitScan().
+        
+        \param duration     Scan duration in seconds
+        */
+        void startScan(uint32_t duration);
+
+        /*!
+        \brief Wait until BLE scan started by startScan() has been completed.
+        
+        \returns true if a scan had been started, false otherwise
+        */
+        bool waitScan(void);
         
+        /*!
+        \brief Get time from start of last scan until all known sensors were found.
+        
+        \returns Latency in ms or 0 if not all sensors were found
+        */
+        uint32_t scanLatency(void) const {
+            return _latency_ms;
+        };
+
+        /*!
+        \brief Get BLE initialization time.
+        
+        \returns BLE stack/scan initialization time in ms (0 if not initialized yet)
+        */
+        uint32_t initTime(void) const {
+            return _init_ms;
+        };
+
         /*!
         \brief Set sensor data invalid.
         */                        
@@ -108,7 +267,62 @@ class BleSensors {
         std::vector<ble_sensors_t>  data;
         
     protected:
+        /// MAC address table entry
+        struct MacEntryS {
+            uint64_t mac;       //!< MAC address as 48-bit integer
+            uint8_t  idx;       //!< sensor index + 1; 0: empty
+        };
+        
         std::vector<std::string> _known_sensors;
-        NimBLEScan*              _pBLEScan;
+        struct MacEntryS         _mac_table[BLE_TABLE_SIZE];     //!< known MAC addresses (open addressing)
+        uint32_t                 _decoded[(BLE_SENSORS_MAX + 31) / 32] = {0}; //!< decoded flags (current scan)
+        unsigned                 _num_decoded = 0;               //!< number of sensors decoded (current scan)
+        NimBLEScan*              _pBLEScan = nullptr;
+        NimBLEAdvertisedDeviceCallbacks* _pCallbacks = nullptr; //!< scan callbacks (allocated once)
+        bool                     _scanStarted = false;   //!< scan started by startScan()
+        uint32_t                 _init_ms = 0;           //!< BLE initialization time in ms
+        ble_scan_state_t*        _state = nullptr;       //!< adaptive scan state (nullptr: disabled)
+        bool                     _passive = false;       //!< passive scan
+        uint32_t                 _scan_start_ms = 0;     //!< start of current scan
+        uint32_t                 _scan_duration = 0;     //!< duration of current scan in seconds
+        uint32_t                 _latency_ms = 0;        //!< time until all sensors were found
+        uint32_t                 _found_ms[BLE_SENSORS_MAX]; //!< time until sensor was found (current scan)
+
+        /*!
+        \brief Initialize BLE and scan parameters (only once).
+        */
+        void initScan(void);
+
+        /*!
+        \brief Prepare scan - set scan parameters and get duration.
+        
+        \param duration     Max. scan duration in seconds
+        
+        \returns Scan duration in seconds
+        */
+        uint32_t prepareScan(uint32_t duration);
+        
+        /*!
+        \brief Evaluate scan results and update adaptive scan state.
+        */
+        void finishScan(void);
+
+        /// Hash function for MAC address (Fibonacci hashing)
+        static unsigned hash(uint64_t mac) {
+            return (unsigned)((mac * 0x9E3779B97F4A7C15ULL) >> (64 - BLE_TABLE_BITS));
+        };
+        
+        /// Insert MAC address into table
+        void insert(uint64_t mac, size_t idx) {
+            unsigned pos = hash(mac);
+            
+            while (_mac_table[pos].idx != 0) {
+                if (_mac_table[pos].mac == mac)
+                    return;
+                pos = (pos + 1) & (BLE_TABLE_SIZE - 1);
+            }
+            _mac_table[pos].mac = mac;
+            _mac_table[pos].idx = idx + 1;
+        };
 };
 #endif
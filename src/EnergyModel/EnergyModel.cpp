@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////////////////////
+// EnergyModel.cpp
+//
+// Energy accounting of wake/sleep cycles
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "EnergyModel.h"
+#include "../../logging.h"
+
+#if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_INFO
+// Only used by print()
+static const char *phase_names[ENERGY_NUM] = {
+    "boot",
+    "sensor rx",
+    "BLE scan",
+    "OneWire",
+    "distance",
+    "join",
+    "TX",
+    "RX",
+    "awake",
+    "sleep"
+};
+#endif
+
+void EnergyModel::begin(void)
+{
+    if (_state->magic != ENERGY_MAGIC) {
+        memset(_state, 0, sizeof(energy_state_t));
+        _state->magic = ENERGY_MAGIC;
+    }
+    _running = 0;
+    memset(_time_us, 0, sizeof(_time_us));
+    _time_us[ENERGY_BOOT] = millis() * 1000;
+}
+
+void EnergyModel::finish(uint32_t sleep_ms)
+{
+    uint32_t charge = 0;
+
+    for (int i=0; i < ENERGY_NUM; i++) {
+        stop((energy_phase_t)i);
+    }
+    for (int i=0; i < ENERGY_NUM; i++) {
+        uint64_t time_us;
+        if (i == ENERGY_AWAKE) {
+            time_us = (uint64_t)millis() * 1000;
+        } else if (i == ENERGY_SLEEP) {
+            time_us = (uint64_t)sleep_ms * 1000;
+        } else {
+            time_us = _time_us[i];
+        }
+        _state->time_ms[i]    = time_us / 1000;
+        _state->charge_uas[i] = time_us * _current_ua[i] / 1000000;
+        charge += _state->charge_uas[i];
+    }
+
+    uint32_t cycle_ms = _state->time_ms[ENERGY_AWAKE] + sleep_ms;
+    if (_state->cycles == 0) {
+        _state->avg_charge_uas = charge;
+        _state->avg_cycle_ms   = cycle_ms;
+    } else {
+        // Exponentially weighted moving average, alpha = 1/8
+        _state->avg_charge_uas = _state->avg_charge_uas - (_state->avg_charge_uas >> 3) + (charge >> 3);
+        _state->avg_cycle_ms   = _state->avg_cycle_ms - (_state->avg_cycle_ms >> 3) + (cycle_ms >> 3);
+    }
+    _state->cycles++;
+    print();
+}
+
+uint16_t EnergyModel::lastUah(void)
+{
+    uint32_t charge = 0;
+
+    for (int i=0; i < ENERGY_NUM; i++) {
+        charge += _state->charge_uas[i];
+    }
+    return sat16(charge / 3600);
+}
+
+uint16_t EnergyModel::lifeDays(void)
+{
+    if ((_state->cycles == 0) || (_state->avg_charge_uas == 0)) {
+        return 0;
+    }
+    // battery capacity [uAs] / charge per cycle [uAs] * cycle duration [d]
+    float days = (float)_battery_mah * 3600000.0f / _state->avg_charge_uas
+                 * _state->avg_cycle_ms / 86400000.0f;
+
+    return (days > UINT16_MAX) ? UINT16_MAX : (uint16_t)days;
+}
+
+uint8_t EnergyModel::encode(uint8_t *buf)
+{
+    uint16_t values[4] = {lastUah(), avgUah(), avgCycle(), lifeDays()};
+
+    for (int i=0; i < 4; i++) {
+        buf[2 * i]     = values[i] >> 8;
+        buf[2 * i + 1] = values[i] & 0xFF;
+    }
+    return ENERGY_SUMMARY_SIZE;
+}
+
+void EnergyModel::print(void)
+{
+    log_i("--- Energy (last cycle) ---");
+    for (int i=0; i < ENERGY_NUM; i++) {
+        log_i("%-10s: %8u ms %9u uAs", phase_names[i],
+            (unsigned)_state->time_ms[i], (unsigned)_state->charge_uas[i]);
+    }
+    log_i("Cycle: %u uAh - avg: %u uAh / %u s - battery life: %u d (%u mAh)",
+        lastUah(), avgUah(), avgCycle(), lifeDays(), (unsigned)_battery_mah);
+}
@@ -0,0 +1,285 @@
+///////////////////////////////////////////////////////////////////////////////
+// EnergyModel.h
+//
+// Energy accounting of wake/sleep cycles
+//
+// The durations of the phases of a wake cycle (weather sensor reception,
+// BLE scan, OneWire/distance sensor reading, LoRaWAN join, TX and RX windows)
+// and of the following deep sleep are measured and multiplied with the
+// supply currents of the board - this gives the charge per cycle and
+// a projection of the battery life.
+//
+// Charge model
+// -------------
+// The total awake time (reset until entering sleep mode) is charged with
+// ENERGY_I_ACTIVE_UA (CPU active, radio in standby mode). The phase currents
+// are the additional currents during the phase, e.g. ENERGY_I_TX_UA is the
+// current of the LoRa transceiver in transmit mode. Phases may overlap
+// (e.g. concurrent BLE scan and weather sensor reception).
+//
+// The default currents are rough estimates - adjust them for your board
+// (e.g. measured with a power profiler) by defining ENERGY_I_<phase>_UA in
+// BresserWeatherSensorTTNCfg.h.
+//
+// The results of the last cycle and a moving average are retained across
+// deep sleep cycles; the summary is appended to the CMD_GET_CONFIG response.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(ENERGY_MODEL_H)
+#define ENERGY_MODEL_H
+
+#include <Arduino.h>
+
+#define ENERGY_MAGIC            0x454E4731 // "ENG1"
+
+// Supply currents [uA] - see above
+#if defined(ESP32)
+    #if !defined(ENERGY_I_ACTIVE_UA)
+        #define ENERGY_I_ACTIVE_UA      45000   //!< CPU active (240 MHz), radio standby
+    #endif
+    #if !defined(ENERGY_I_SLEEP_UA)
+        #define ENERGY_I_SLEEP_UA       150     //!< deep sleep incl. voltage regulator
+    #endif
+    #if !defined(ENERGY_I_BLE_UA)
+        #define ENERGY_I_BLE_UA         55000   //!< additional: BLE scan
+    #endif
+#else
+    #if !defined(ENERGY_I_ACTIVE_UA)
+        #define ENERGY_I_ACTIVE_UA      25000   //!< CPU active, radio standby
+    #endif
+    #if !defined(ENERGY_I_SLEEP_UA)
+        #define ENERGY_I_SLEEP_UA       1300    //!< sleep mode incl. voltage regulator
+    #endif
+    #if !defined(ENERGY_I_BLE_UA)
+        #define ENERGY_I_BLE_UA         0       //!< additional: BLE scan
+    #endif
+#endif
+#if !defined(ENERGY_I_SENSOR_RX_UA)
+    #define ENERGY_I_SENSOR_RX_UA   11500   //!< additional: transceiver in FSK receive mode
+#endif
+#if !defined(ENERGY_I_ONEWIRE_UA)
+    #define ENERGY_I_ONEWIRE_UA     1500    //!< additional: DS18B20 temperature conversion
+#endif
+#if !defined(ENERGY_I_DISTANCE_UA)
+    #define ENERGY_I_DISTANCE_UA    8000    //!< additional: A02YYUW distance sensor powered
+#endif
+#if !defined(ENERGY_I_TX_UA)
+    #define ENERGY_I_TX_UA          44000   //!< additional: LoRa transmit (+14 dBm)
+#endif
+#if !defined(ENERGY_I_RX_UA)
+    #define ENERGY_I_RX_UA          11500   //!< additional: LoRa receive
+#endif
+
+// Battery capacity for battery life projection [mAh]
+#if !defined(ENERGY_BATTERY_MAH)
+    #define ENERGY_BATTERY_MAH      2000
+#endif
+
+/// Currents [uA] indexed by energy_phase_t
+#define ENERGY_CURRENT_UA { \
+    0, \
+    ENERGY_I_SENSOR_RX_UA, \
+    ENERGY_I_BLE_UA, \
+    ENERGY_I_ONEWIRE_UA, \
+    ENERGY_I_DISTANCE_UA, \
+    0, \
+    ENERGY_I_TX_UA, \
+    ENERGY_I_RX_UA, \
+    ENERGY_I_ACTIVE_UA, \
+    ENERGY_I_SLEEP_UA \
+}
+
+/// Wake/sleep cycle phases
+enum energy_phase_t {
+    ENERGY_BOOT,            //!< reset until start of setup() (time only)
+    ENERGY_SENSOR_RX,       //!< weather sensor data reception
+    ENERGY_BLE_SCAN,        //!< BLE sensor scan
+    ENERGY_ONEWIRE,         //!< OneWire temperature sensor reading
+    ENERGY_DISTANCE,        //!< distance sensor reading (incl. power-up and retries)
+    ENERGY_JOIN,            //!< LoRaWAN join procedure (time only - TX/RX are accounted separately)
+    ENERGY_TX,              //!< LoRa transmission (time-on-air)
+    ENERGY_RX,              //!< LoRa receive windows
+    ENERGY_AWAKE,           //!< total awake time
+    ENERGY_SLEEP,           //!< sleep mode
+    ENERGY_NUM              //!< number of phases
+};
+
+/// Energy accounting state - must be retained across deep sleep (e.g. in RTC RAM)
+struct EnergyStateS {
+    uint32_t magic;                     //!< validation of retained data
+    uint32_t cycles;                    //!< number of completed cycles
+    uint32_t time_ms[ENERGY_NUM];       //!< last cycle: phase durations in ms
+    uint32_t charge_uas[ENERGY_NUM];    //!< last cycle: charge per phase in uAs
+    uint32_t avg_charge_uas;            //!< moving average of charge per cycle in uAs
+    uint32_t avg_cycle_ms;              //!< moving average of cycle duration in ms
+};
+
+typedef struct EnergyStateS energy_state_t; //!< Shortcut for struct EnergyStateS
+
+/// Size of summary (see EnergyModel::encode())
+#define ENERGY_SUMMARY_SIZE 8
+
+
+/*!
+  \class EnergyModel
+  \brief Energy accounting of wake/sleep cycles
+*/
+class EnergyModel {
+    public:
+        /*!
+        \brief Constructor.
+
+        \param state        Energy accounting state (retained across deep sleep)
+        \param current_ua   Currents in uA indexed by energy_phase_t (see ENERGY_CURRENT_UA)
+        \param battery_mah  Battery capacity in mAh
+        */
+        EnergyModel(energy_state_t *state, const uint32_t *current_ua, uint32_t battery_mah) {
+            _state       = state;
+            _current_ua  = current_ua;
+            _battery_mah = battery_mah;
+        };
+
+        /*!
+        \brief Initialization at start of setup() - clears state if retained data is invalid.
+        */
+        void begin(void);
+
+        /*!
+        \brief Start phase - no effect if the phase is already running.
+
+        \param phase    Wake cycle phase
+        */
+        void start(energy_phase_t phase) {
+            if (!(_running & (1 << phase))) {
+                _start_us[phase] = micros();
+                _running |= 1 << phase;
+            }
+        };
+
+        /*!
+        \brief Stop phase - no effect if the phase is not running.
+
+        \param phase    Wake cycle phase
+        */
+        void stop(energy_phase_t phase) {
+            if (_running & (1 << phase)) {
+                _time_us[phase] += micros() - _start_us[phase];
+                _running &= ~(1 << phase);
+            }
+        };
+
+        /*!
+        \brief Add duration to phase, e.g. calculated time-on-air.
+
+        \param phase    Wake cycle phase
+        \param us       Duration in us
+        */
+        void add(energy_phase_t phase, uint32_t us) {
+            _time_us[phase] += us;
+        };
+
+        /*!
+        \brief Complete cycle before entering sleep mode.
+
+        Stops all running phases and updates the retained state.
+
+        \param sleep_ms Sleep duration in ms
+        */
+        void finish(uint32_t sleep_ms);
+
+        /*!
+        \brief Get charge of last completed cycle.
+
+        \returns Charge in uAh (saturated)
+        */
+        uint16_t lastUah(void);
+
+        /*!
+        \brief Get moving average of charge per cycle.
+
+        \returns Charge in uAh (saturated)
+        */
+        uint16_t avgUah(void) {
+            return sat16(_state->avg_charge_uas / 3600);
+        };
+
+        /*!
+        \brief Get moving average of cycle duration.
+
+        \returns Duration in s (saturated)
+        */
+        uint16_t avgCycle(void) {
+            return sat16(_state->avg_cycle_ms / 1000);
+        };
+
+        /*!
+        \brief Get projected battery life.
+
+        \returns Battery life in days (saturated); 0 if unknown
+        */
+        uint16_t lifeDays(void);
+
+        /*!
+        \brief Encode summary (big endian, ENERGY_SUMMARY_SIZE bytes).
+
+        lastUah(), avgUah(), avgCycle(), lifeDays()
+
+        \param buf  Output buffer
+
+        \returns Length in bytes
+        */
+        uint8_t encode(uint8_t *buf);
+
+        /*!
+        \brief Print phase durations and charge of last completed cycle.
+        */
+        void print(void);
+
+    protected:
+        energy_state_t  *_state;                    //!< retained state
+        const uint32_t  *_current_ua;               //!< currents per phase in uA
+        uint32_t        _battery_mah;               //!< battery capacity in mAh
+        uint16_t        _running = 0;               //!< running phases (bitmap)
+        uint32_t        _start_us[ENERGY_NUM];      //!< start timestamps in us
+        uint32_t        _time_us[ENERGY_NUM];       //!< durations of current cycle in us
+
+        static uint16_t sat16(uint32_t v) {
+            return (v > UINT16_MAX) ? UINT16_MAX : v;
+        };
+};
+
+#endif
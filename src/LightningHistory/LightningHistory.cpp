@@ -0,0 +1,177 @@
+///////////////////////////////////////////////////////////////////////////////
+// LightningHistory.cpp
+//
+// Lightning strike event history with compact burst encoding (FPort 9)
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "LightningHistory.h"
+#include <LoraMessage.h>
+#include "../../logging.h"
+
+// Time difference in minutes, saturated
+static uint16_t diffMin(uint32_t t1, uint32_t t0)
+{
+    uint32_t d = (t1 > t0) ? (t1 - t0) / 60 : 0;
+    return (d < 0xFFFF) ? d : 0xFFFF;
+}
+
+void LightningHistory::begin(void)
+{
+    if ((_history->magic != LGT_HISTORY_MAGIC) || (_history->head >= LGT_HISTORY_SIZE) || (_history->num > LGT_HISTORY_SIZE)) {
+        memset(_history, 0, sizeof(lightning_history_t));
+        _history->magic = LGT_HISTORY_MAGIC;
+    }
+}
+
+void LightningHistory::update(time_t timestamp, int count, uint8_t distance_km, bool startup)
+{
+    if ((count < 0) || (count >= LGT_COUNT_MAX)) {
+        return;
+    }
+    if (!_history->prev_valid) {
+        // First reading - no reference
+        _history->prev_count = count;
+        _history->prev_valid = true;
+        return;
+    }
+
+    int strikes;
+    if (count >= _history->prev_count) {
+        strikes = count - _history->prev_count;
+    } else if (startup) {
+        // Sensor has been restarted, counter starts from 0
+        strikes = count;
+    } else {
+        // Counter overflow
+        strikes = count + LGT_COUNT_MAX - _history->prev_count;
+    }
+    _history->prev_count = count;
+
+    if (strikes > 0) {
+        add(timestamp, (strikes < 0xFFFF) ? strikes : 0xFFFF, distance_km);
+    }
+}
+
+void LightningHistory::add(uint32_t timestamp, uint16_t strikes, uint8_t distance_km)
+{
+    // Once the list has overflowed, events are counted until the summary has been sent
+    // to keep the chronological order
+    if ((_history->num < LGT_HISTORY_SIZE) && (_history->ovf_events == 0)) {
+        lightning_event_t *ev = &_history->events[(_history->head + _history->num) % LGT_HISTORY_SIZE];
+        ev->time        = timestamp;
+        ev->strikes     = strikes;
+        ev->distance_km = distance_km;
+        _history->num++;
+        log_d("Lightning event #%u: %u strikes, %u km", _history->num, strikes, distance_km);
+        return;
+    }
+
+    if ((_history->ovf_events == 0) || (distance_km < _history->ovf_distance_km)) {
+        _history->ovf_distance_km = distance_km;
+    }
+    if (_history->ovf_events < 0xFF) {
+        _history->ovf_events++;
+    }
+    uint32_t sum = (uint32_t)_history->ovf_strikes + strikes;
+    _history->ovf_strikes = (sum < 0xFFFF) ? sum : 0xFFFF;
+    _history->ovf_time    = timestamp;
+    log_d("Lightning history overflow: %u events, %u strikes", _history->ovf_events, _history->ovf_strikes);
+}
+
+uint8_t LightningHistory::encode(uint8_t *buf, uint8_t size)
+{
+    _sent = true;
+    _pending_num = 0;
+    _pending_ovf = false;
+
+    if (size < LGT_HDR_SIZE) {
+        return 0;
+    }
+
+    uint8_t n = (size - LGT_HDR_SIZE) / LGT_REC_SIZE;
+    if (n > _history->num) {
+        n = _history->num;
+    }
+    // Overflow summary only after the last record
+    bool ovf = (_history->ovf_events > 0) && (n == _history->num) &&
+        (LGT_HDR_SIZE + n * LGT_REC_SIZE + LGT_OVF_SIZE <= size);
+    if ((n == 0) && !ovf) {
+        return 0;
+    }
+
+    const lightning_event_t *first = &_history->events[_history->head];
+    uint32_t t_prev = (n > 0) ? first->time : _history->ovf_time;
+    LoraEncoder encoder(buf);
+
+    encoder.writeUint8(n | (ovf ? LGT_OVF_FLAG : 0));
+    encoder.writeUnixtime(t_prev);
+    for (uint8_t i=0; i < n; i++) {
+        const lightning_event_t *ev = &_history->events[(_history->head + i) % LGT_HISTORY_SIZE];
+        encoder.writeUint16(diffMin(ev->time, t_prev));
+        encoder.writeUint16(ev->strikes);
+        encoder.writeUint8(ev->distance_km);
+        t_prev = ev->time;
+    }
+    if (ovf) {
+        encoder.writeUint8(_history->ovf_events);
+        encoder.writeUint16(_history->ovf_strikes);
+        encoder.writeUint8(_history->ovf_distance_km);
+        encoder.writeUint16(diffMin(_history->ovf_time, t_prev));
+    }
+
+    _pending_num = n;
+    _pending_ovf = ovf;
+    return encoder.getLength();
+}
+
+void LightningHistory::sent(bool ack)
+{
+    _sent = true;
+    if (!ack) {
+        return;
+    }
+    _history->head = (_history->head + _pending_num) % LGT_HISTORY_SIZE;
+    _history->num -= _pending_num;
+    if (_pending_ovf) {
+        _history->ovf_events      = 0;
+        _history->ovf_strikes     = 0;
+        _history->ovf_distance_km = 0;
+        _history->ovf_time        = 0;
+    }
+    _pending_num = 0;
+    _pending_ovf = false;
+}
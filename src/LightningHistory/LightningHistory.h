@@ -0,0 +1,180 @@
+///////////////////////////////////////////////////////////////////////////////
+// LightningHistory.h
+//
+// Lightning strike event history with compact burst encoding (FPort 9)
+//
+// The lightning sensor only provides an accumulated strike counter and the
+// distance of the last strike. At each wake-up, the increment of the strike
+// counter since the previous reading is stored as an event (time, strikes,
+// distance) in a fixed-size list which is retained across deep sleep. The
+// events are sent in a separate uplink on FPort 9 and are removed from the
+// list when the frame has been acknowledged. If the list is full, further
+// events are only counted (overflow summary) until the list has been sent.
+// Without lightning activity, no frame is sent.
+//
+// Frame format (multi-byte values little endian)
+// ----------------------------------------------
+// byte 0:      bits 0..6: number of event records n
+//              bit 7:     overflow summary appended
+// byte 1..4:   time of first event (unix time)
+// n records, 5 bytes each:
+//   byte 0..1: time since previous event (first record: 0) [min]
+//   byte 2..3: strikes
+//   byte 4:    distance of last strike [km]
+// overflow summary, 6 bytes:
+//   byte 0:    number of events
+//   byte 1..2: strikes
+//   byte 3:    min. distance [km]
+//   byte 4..5: time of last event since last record [min]
+// Time differences and counters saturate at their max. values.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#if !defined(LIGHTNING_HISTORY_H)
+#define LIGHTNING_HISTORY_H
+
+#include <Arduino.h>
+
+#define LGT_HISTORY_MAGIC   0x4C474830  // "LGH0"
+#define LGT_HISTORY_SIZE    8           //!< number of event records
+#define LGT_HDR_SIZE        5           //!< frame header size
+#define LGT_REC_SIZE        5           //!< event record size
+#define LGT_OVF_SIZE        6           //!< overflow summary size
+#define LGT_OVF_FLAG        0x80        //!< overflow summary flag in frame header
+
+#if !defined(LGT_COUNT_MAX)
+    #define LGT_COUNT_MAX   1600        //!< sensor's strike counter wraps to 0 at this value
+#endif
+
+/// Lightning event
+struct LightningEventS {
+    uint32_t time;          //!< time of detection (unix time)
+    uint16_t strikes;       //!< number of strikes since previous reading
+    uint8_t  distance_km;   //!< distance of last strike [km]
+};
+
+typedef struct LightningEventS lightning_event_t; //!< Shortcut for struct LightningEventS
+
+/// Lightning history - must be retained across deep sleep (e.g. in RTC RAM)
+struct LightningHistoryS {
+    uint32_t          magic;                        //!< validation of retained data
+    bool              prev_valid;                   //!< prev_count is valid
+    uint16_t          prev_count;                   //!< strike counter at previous reading
+    uint8_t           head;                         //!< index of oldest event
+    uint8_t           num;                          //!< number of events in list
+    uint8_t           ovf_events;                   //!< overflow: number of events
+    uint16_t          ovf_strikes;                  //!< overflow: number of strikes
+    uint8_t           ovf_distance_km;              //!< overflow: min. distance [km]
+    uint32_t          ovf_time;                     //!< overflow: time of last event
+    lightning_event_t events[LGT_HISTORY_SIZE];     //!< event list
+};
+
+typedef struct LightningHistoryS lightning_history_t; //!< Shortcut for struct LightningHistoryS
+
+/// Max. frame size
+#define LGT_FRAME_SIZE (LGT_HDR_SIZE + LGT_HISTORY_SIZE * LGT_REC_SIZE + LGT_OVF_SIZE)
+
+
+/*!
+  \class LightningHistory
+  \brief Lightning strike event history
+*/
+class LightningHistory {
+    public:
+        /*!
+        \brief Constructor.
+
+        \param history  Lightning history (retained across deep sleep)
+        */
+        LightningHistory(lightning_history_t *history) {
+            _history = history;
+        };
+
+        /*!
+        \brief Initialization - clears history if retained data is invalid.
+        */
+        void begin(void);
+
+        /*!
+        \brief Update history with lightning sensor data.
+
+        \param timestamp    Time of reading (unix time)
+        \param count        Accumulated strike counter
+        \param distance_km  Distance of last strike [km]
+        \param startup      Sensor startup flag (counter has been reset)
+        */
+        void update(time_t timestamp, int count, uint8_t distance_km, bool startup);
+
+        /*!
+        \brief Check if a lightning uplink has to be sent in this cycle.
+
+        \returns true if events are available and no frame has been encoded in this cycle
+        */
+        bool pending(void) {
+            return ((_history->num > 0) || (_history->ovf_events > 0)) && !_sent;
+        };
+
+        /*!
+        \brief Encode frame with as many event records as fit into the buffer.
+
+        \param buf      Buffer
+        \param size     Buffer size
+
+        \returns frame size (0 if no events or buffer too small)
+        */
+        uint8_t encode(uint8_t *buf, uint8_t size);
+
+        /*!
+        \brief Frame has been sent - events are removed if acknowledged.
+
+        \param ack      Frame has been acknowledged
+        */
+        void sent(bool ack);
+
+    protected:
+        lightning_history_t *_history;          //!< lightning history
+        bool                _sent = false;      //!< lightning uplink tried in current cycle
+        uint8_t             _pending_num = 0;   //!< event records in last frame
+        bool                _pending_ovf = false; //!< overflow summary in last frame
+
+        /*!
+        \brief Add event to list or to overflow summary.
+        */
+        void add(uint32_t timestamp, uint16_t strikes, uint8_t distance_km);
+};
+
+#endif // LIGHTNING_HISTORY_H
@@ -0,0 +1,187 @@
+///////////////////////////////////////////////////////////////////////////////
+// MultiSensor.cpp
+//
+// Multi-sensor uplink (FPort 6)
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "MultiSensor.h"
+#include "../../logging.h"
+
+unsigned MultiSensor::build(WeatherSensor &ws)
+{
+    unsigned n = 0;
+
+    _len    = 0;
+    _offset = 0;
+    _next   = 0;
+    _frame  = 0;
+    _seq    = (_seq + 1) & 0x0F;
+
+    for (size_t i = 0; i < ws.sensor.size(); i++) {
+        const Sensor &s = ws.sensor[i];
+        uint8_t tag;
+
+        if (!s.valid)
+            continue;
+
+        if (_len + MS_REC_SIZE_MAX > MULTI_SENSOR_BUF_SIZE) {
+            log_w("Record buffer full - sensor ID 0x%08X skipped", (unsigned)s.sensor_id);
+            continue;
+        }
+
+        if ((s.s_type == SENSOR_TYPE_WEATHER0) || (s.s_type == SENSOR_TYPE_WEATHER1)) {
+            tag = MS_TYPE_WEATHER << 4;
+            tag |= s.w.temp_ok ? MS_FLAG_TEMP_HUM : 0;
+            tag |= s.w.wind_ok ? MS_FLAG_WIND : 0;
+            tag |= s.w.rain_ok ? MS_FLAG_RAIN : 0;
+        } else if (s.s_type == SENSOR_TYPE_SOIL) {
+            tag = MS_TYPE_SOIL << 4;
+        } else if (s.s_type == SENSOR_TYPE_LIGHTNING) {
+            tag = MS_TYPE_LIGHTNING << 4;
+        } else {
+            log_d("Sensor type %u not supported", s.s_type);
+            continue;
+        }
+        tag |= s.battery_ok ? MS_FLAG_BATT_OK : 0;
+
+        put(tag, 1);
+        put(s.sensor_id, 4);
+        switch (tag >> 4) {
+            case MS_TYPE_WEATHER:
+                if (tag & MS_FLAG_TEMP_HUM) {
+                    put((uint16_t)(int16_t)lroundf(s.w.temp_c * 10), 2);
+                    put(s.w.humidity_ok ? s.w.humidity : 0xFF, 1);
+                }
+                if (tag & MS_FLAG_WIND) {
+                    put(s.w.wind_gust_meter_sec_fp1, 2);
+                    put(s.w.wind_avg_meter_sec_fp1, 2);
+                    put(s.w.wind_direction_deg_fp1, 2);
+                }
+                if (tag & MS_FLAG_RAIN) {
+                    put((uint32_t)lroundf(s.w.rain_mm * 10), 4);
+                }
+                break;
+
+            case MS_TYPE_SOIL:
+                put((uint16_t)(int16_t)lroundf(s.soil.temp_c * 10), 2);
+                put(s.soil.moisture, 1);
+                break;
+
+            case MS_TYPE_LIGHTNING:
+                put(s.lgt.strike_count, 2);
+                put(s.lgt.distance_km, 1);
+                break;
+        }
+        n++;
+    }
+    log_d("Multi-sensor set #%u: %u records, %u bytes", _seq, n, _len);
+
+    return n;
+}
+
+bool MultiSensor::addBle(uint8_t idx, float temp_c, float humidity, uint8_t batt_level)
+{
+    if (_len + MS_REC_SIZE_MAX > MULTI_SENSOR_BUF_SIZE) {
+        log_w("Record buffer full - BLE sensor #%u skipped", idx);
+        return false;
+    }
+    put((MS_TYPE_BLE << 4) | ((batt_level > 0) ? MS_FLAG_BATT_OK : 0), 1);
+    put(idx, 1);
+    put((uint16_t)(int16_t)lroundf(temp_c * 10), 2);
+    put((uint8_t)lroundf(humidity), 1);
+    put(batt_level, 1);
+
+    return true;
+}
+
+uint8_t MultiSensor::recordSize(uint8_t tag)
+{
+    switch (tag >> 4) {
+        case MS_TYPE_WEATHER:
+            return 5 + ((tag & MS_FLAG_TEMP_HUM) ? 3 : 0) + ((tag & MS_FLAG_WIND) ? 6 : 0) + ((tag & MS_FLAG_RAIN) ? 4 : 0);
+        case MS_TYPE_SOIL:
+        case MS_TYPE_LIGHTNING:
+            return 8;
+        default:
+            // MS_TYPE_BLE
+            return 6;
+    }
+}
+
+uint8_t MultiSensor::encode(uint8_t *buf, uint8_t size)
+{
+    uint16_t pos = _offset;
+    uint8_t  len = 1;
+
+    if (!pending())
+        return 0;
+
+    // Copy as many complete records as possible
+    while (pos < _len) {
+        uint8_t rec_size = recordSize(_buf[pos]);
+        if (len + rec_size > size)
+            break;
+        memcpy(&buf[len], &_buf[pos], rec_size);
+        len += rec_size;
+        pos += rec_size;
+    }
+
+    if (len == 1) {
+        // Record larger than frame (very low data rate) - drop the set
+        log_w("Record too large for frame size %u", size);
+        _offset = _len;
+        return 0;
+    }
+
+    // Last frame of set? (remaining records are dropped if max. number of frames is reached)
+    bool last = (pos >= _len) || (_frame == MS_FRAMES_MAX - 1);
+    if (last && (pos < _len)) {
+        log_w("Multi-sensor set truncated - %u bytes dropped", (unsigned)(_len - pos));
+        pos = _len;
+    }
+    buf[0] = (_seq << 4) | (_frame << 1) | (last ? MS_HDR_LAST : 0);
+    _next = pos;
+    log_d("Multi-sensor frame #%u.%u: %u bytes", _seq, _frame, len);
+
+    return len;
+}
+
+void MultiSensor::sent(void)
+{
+    _offset = _next;
+    _frame++;
+}
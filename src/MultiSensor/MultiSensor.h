@@ -0,0 +1,171 @@
+///////////////////////////////////////////////////////////////////////////////
+// MultiSensor.h
+//
+// Multi-sensor uplink (FPort 6)
+//
+// All valid sensor data slots of the weather sensor receiver (and optionally
+// BLE sensor data) are encoded as self-describing records. If the records
+// do not fit into a single uplink, they are split across several frames
+// at record boundaries.
+//
+// Frame format
+// -------------
+// byte 0:   header
+//           bits 7:4: sequence number (incremented with each set of frames)
+//           bits 3:1: frame index
+//           bit 0:    1 - last frame of set
+// byte 1..: records
+//
+// Record format
+// --------------
+// byte 0:   tag
+//           bits 7:4: record type (MS_TYPE_xxx)
+//           bit 3:    battery o.k.
+//           bits 2:0: record type specific flags
+// byte 1-4: sensor ID (uint32, little endian) - MS_TYPE_BLE: byte 1 is the sensor index
+// byte ...: record type specific data (little endian)
+//
+// MS_TYPE_WEATHER: flags bit 0: temperature/humidity, bit 1: wind, bit 2: rain
+//   [bit 0] temperature [0.1 degC] int16, humidity [%] uint8 (0xFF: invalid)
+//   [bit 1] wind gust, wind average [0.1 m/s] uint16, wind direction [0.1 deg] uint16
+//   [bit 2] rain gauge [0.1 mm] uint32
+// MS_TYPE_SOIL:      temperature [0.1 degC] int16, moisture [%] uint8
+// MS_TYPE_LIGHTNING: strike count uint16, distance [km] uint8
+// MS_TYPE_BLE:       temperature [0.1 degC] int16, humidity [%] uint8, battery level [%] uint8
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(MULTI_SENSOR_H)
+#define MULTI_SENSOR_H
+
+#include <Arduino.h>
+#include "WeatherSensorCfg.h"
+#include "WeatherSensor.h"
+
+#define MS_TYPE_WEATHER         1       //!< record type: weather sensor
+#define MS_TYPE_SOIL            2       //!< record type: soil sensor
+#define MS_TYPE_LIGHTNING       3       //!< record type: lightning sensor
+#define MS_TYPE_BLE             4       //!< record type: BLE temperature/humidity sensor
+
+#define MS_FLAG_BATT_OK         0x08    //!< tag: battery o.k.
+#define MS_FLAG_TEMP_HUM        0x01    //!< weather record: temperature/humidity
+#define MS_FLAG_WIND            0x02    //!< weather record: wind
+#define MS_FLAG_RAIN            0x04    //!< weather record: rain
+
+#define MS_HDR_LAST             0x01    //!< header: last frame of set
+#define MS_FRAMES_MAX           8       //!< max. number of frames per set
+#define MS_REC_SIZE_MAX         20      //!< max. record size in bytes
+
+#if !defined(MULTI_SENSOR_BUF_SIZE)
+#define MULTI_SENSOR_BUF_SIZE   200     //!< record buffer size in bytes
+#endif
+
+
+/*!
+  \class MultiSensor
+  \brief Multi-sensor uplink encoder
+*/
+class MultiSensor {
+    public:
+        /*!
+        \brief Constructor.
+        */
+        MultiSensor() {};
+
+        /*!
+        \brief Build records from all valid sensor data slots - starts a new set of frames.
+
+        \param ws       Weather sensor receiver
+
+        \returns Number of records
+        */
+        unsigned build(WeatherSensor &ws);
+
+        /*!
+        \brief Add BLE sensor record to current set.
+
+        \param idx          BLE sensor index
+        \param temp_c       temperature [degC]
+        \param humidity     humidity [%]
+        \param batt_level   battery level [%]
+
+        \returns true if record has been added
+        */
+        bool addBle(uint8_t idx, float temp_c, float humidity, uint8_t batt_level);
+
+        /*!
+        \brief Check if frames of the current set are waiting for transmission.
+        */
+        bool pending(void) {
+            return _offset < _len;
+        };
+
+        /*!
+        \brief Encode next frame of current set.
+
+        \param buf      Output buffer
+        \param size     Size of output buffer (max. frame size)
+
+        \returns Frame length in bytes (0 if no records are pending)
+        */
+        uint8_t encode(uint8_t *buf, uint8_t size);
+
+        /*!
+        \brief Mark frame returned by encode() as sent.
+        */
+        void sent(void);
+
+    protected:
+        uint8_t  _buf[MULTI_SENSOR_BUF_SIZE];   //!< records
+        uint16_t _len    = 0;                   //!< length of records in buffer
+        uint16_t _offset = 0;                   //!< start of next frame's records in buffer
+        uint16_t _next   = 0;                   //!< start of records following the encoded frame
+        uint8_t  _seq    = 0;                   //!< sequence number of set
+        uint8_t  _frame  = 0;                   //!< index of next frame in set
+
+        /// Append uint8/16/32 to record buffer (little endian)
+        void put(uint32_t val, uint8_t bytes) {
+            while (bytes--) {
+                _buf[_len++] = val & 0xFF;
+                val >>= 8;
+            }
+        };
+
+        /// Get record length from tag
+        static uint8_t recordSize(uint8_t tag);
+};
+
+#endif // MULTI_SENSOR_H
@@ -0,0 +1,158 @@
+///////////////////////////////////////////////////////////////////////////////
+// PayloadCompressor.cpp
+//
+// Delta/varint compressed uplink payload (FPort 4)
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <math.h>
+#include "PayloadCompressor.h"
+
+void PayloadCompressor::begin(void)
+{
+    if (_state->magic != PAYLOAD_DELTA_MAGIC) {
+        reset();
+    }
+}
+
+void PayloadCompressor::reset(void)
+{
+    memset(_state, 0, sizeof(payload_delta_state_t));
+    _state->magic = PAYLOAD_DELTA_MAGIC;
+}
+
+uint8_t PayloadCompressor::encodeFrame(const PayloadValueU *values, uint8_t *buf, uint8_t size, uint8_t &seq)
+{
+    uint8_t len = 0;
+
+    seq = _state->seq;
+    _state->seq = (_state->seq + 1) & PAYLOAD_HDR_SEQ_MASK;
+    for (unsigned i=0; i < PF_NUM; i++) {
+        _state->pending_val[i] = quantize(_fields[i].type, values[i]);
+    }
+    _state->pending_seq = seq;
+    _state->pending = true;
+
+    if (_state->ref_age < 0xFF) {
+        _state->ref_age++;
+    }
+    if (_state->ref_valid && (_state->ref_age >= PAYLOAD_REF_AGE_MAX)) {
+        // The decoder's copy of the reference frame may have been replaced
+        // by a frame with the same (wrapped) sequence number
+        log_d("Reference #%u expired", _state->ref_seq);
+        _state->ref_valid = false;
+    }
+
+    if (_state->ref_valid && (_state->frames < _keyframe_interval)) {
+        len = encodeDelta(seq, buf, size);
+    }
+    if (len != 0) {
+        _state->frames++;
+        log_d("Delta frame #%u (ref #%u), %u bytes", seq, _state->ref_seq, len);
+    }
+    return len;
+}
+
+void PayloadCompressor::confirm(bool ack)
+{
+    if (ack && _state->pending) {
+        memcpy(_state->ref, _state->pending_val, sizeof(_state->ref));
+        _state->ref_seq   = _state->pending_seq;
+        _state->ref_age   = 0;
+        _state->ref_valid = true;
+    }
+    _state->pending = false;
+}
+
+int32_t PayloadCompressor::quantize(uint8_t type, const PayloadValueU &v)
+{
+    switch (type) {
+        case PL_TYPE_uint8:
+        case PL_TYPE_bitmap_node:
+        case PL_TYPE_bitmap_sensors:
+            return v.u8;
+        case PL_TYPE_uint16:
+        case PL_TYPE_uint16fp1:
+            return v.u16;
+        case PL_TYPE_temperature:
+            return (int32_t)(v.f * 100);
+        case PL_TYPE_rawfloat:
+            // Calculated in double precision like the decoder
+            return (int32_t)lround((double)v.f * 10);
+        default:
+            return (int32_t)v.u32;
+    }
+}
+
+uint8_t PayloadCompressor::encodeDelta(uint8_t seq, uint8_t *buf, uint8_t size)
+{
+    unsigned field_count = 0;
+    for (unsigned i=0; i < PF_NUM; i++) {
+        field_count += _fields[i].en ? 1 : 0;
+    }
+    const uint8_t bitmap_len = (field_count + 7) / 8;
+    const uint8_t max_len = (size < 1 + _frame_size) ? size : 1 + _frame_size;
+    uint8_t len = 2 + bitmap_len;
+    unsigned n = 0;
+
+    buf[0] = seq;
+    buf[1] = _state->ref_seq;
+    memset(&buf[2], 0, bitmap_len);
+
+    for (unsigned i=0; i < PF_NUM; i++) {
+        if (!_fields[i].en)
+            continue;
+
+        int32_t delta = (int32_t)((uint32_t)_state->pending_val[i] - (uint32_t)_state->ref[i]);
+        if (delta != 0) {
+            buf[2 + n / 8] |= 1 << (n % 8);
+
+            // zigzag encoding
+            uint32_t zz = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+
+            // unsigned LEB128 varint
+            do {
+                if (len >= max_len) {
+                    return 0;
+                }
+                buf[len++] = (zz & 0x7F) | ((zz > 0x7F) ? 0x80 : 0);
+                zz >>= 7;
+            } while (zz);
+        }
+        n++;
+    }
+    return (len < max_len) ? len : 0;
+}
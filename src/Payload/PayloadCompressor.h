@@ -0,0 +1,210 @@
+///////////////////////////////////////////////////////////////////////////////
+// PayloadCompressor.h
+//
+// Delta/varint compressed uplink payload (FPort 4)
+//
+// The payload fields defined in PayloadSchema.h are encoded as
+// zigzag-varint deltas against the last frame acknowledged by the network.
+// Fields which did not change are omitted. Periodically - or if no valid
+// reference is available - a keyframe with the full payload is sent.
+//
+// Frame format
+// -------------
+// byte 0:   header
+//           bit 7:    1 - keyframe / 0 - delta frame
+//           bits 6:0: sequence number
+//
+// Keyframe:
+// byte 1..: payload as defined in PayloadSchema.h (i.e. as on FPort 1)
+//
+// Delta frame:
+// byte 1:   sequence number of reference frame
+// byte 2..: change bitmap - one bit per enabled payload field
+//           (bit <n%8> in byte <n/8> refers to the n-th enabled field)
+// byte ...: for each changed field: zigzag-encoded delta as unsigned LEB128 varint
+//
+// The deltas are calculated from quantized integer values:
+//   uint8/uint16/uint16fp1/uint32/unixtime/bitmap: raw value
+//   temperature: value * 100 (same resolution as LoraEncoder::writeTemperature())
+//   rawfloat:    value * 10
+//
+// Note:
+// The reference is updated only after the frame has been acknowledged,
+// so network server and node always share the reference. Since a frame
+// may be received by the network server even if the acknowledgement was lost,
+// the delta frame contains the sequence number of its reference frame.
+// The decoder keeps one frame per sequence number; if the reference would be
+// PAYLOAD_REF_AGE_MAX or more frames behind, it is dropped and a keyframe
+// is sent instead.
+//
+// rawfloat values are rounded half away from zero (lround()) - the decoder
+// (scripts/uplink_compressed_decoder.js) must use the same rounding.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//          Fixed reference becoming invalid after sequence number wrap-around
+//          Fixed rounding of rawfloat values to match decoder
+//          Added missing include
+//          Moved implementation to PayloadCompressor.cpp
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(PAYLOAD_COMPRESSOR_H)
+#define PAYLOAD_COMPRESSOR_H
+
+#include "PayloadEncoder.h"
+#include "../../logging.h"
+
+#define PAYLOAD_DELTA_MAGIC     0x504C4432 // "PLD2"
+#define PAYLOAD_HDR_KEYFRAME    0x80
+#define PAYLOAD_HDR_SEQ_MASK    0x7F
+#define PAYLOAD_REF_AGE_MAX     (PAYLOAD_HDR_SEQ_MASK + 1) //!< max. sequence number distance to reference frame
+
+/// Compressor state - must be retained across deep sleep (e.g. in RTC RAM)
+struct PayloadDeltaStateS {
+    uint32_t magic;                 //!< validation of retained data
+    uint8_t  seq;                   //!< sequence number of next frame
+    uint8_t  frames;                //!< delta frames since last keyframe
+    bool     ref_valid;             //!< reference frame valid
+    uint8_t  ref_seq;               //!< sequence number of reference frame
+    uint8_t  ref_age;               //!< frames sent since reference frame
+    int32_t  ref[PF_NUM];           //!< quantized values of reference frame
+    bool     pending;               //!< frame waiting for acknowledgement
+    uint8_t  pending_seq;           //!< sequence number of pending frame
+    int32_t  pending_val[PF_NUM];   //!< quantized values of pending frame
+};
+
+typedef struct PayloadDeltaStateS payload_delta_state_t; //!< Shortcut for struct PayloadDeltaStateS
+
+
+/*!
+  \class PayloadCompressor
+  \brief Delta/varint compressed uplink payload encoder
+
+  The field enables depend on the feature defines in BresserWeatherSensorTTNCfg.h,
+  so the field table and the keyframe encoding are taken from the caller's
+  translation unit.
+*/
+class PayloadCompressor {
+    public:
+        /*!
+        \brief Constructor.
+
+        \param state            Compressor state (retained across deep sleep)
+        \param keyframe_interval Max. number of delta frames between keyframes
+        \param fields           Payload field table
+        \param frame_size       Size of uncompressed payload in bytes
+        */
+        PayloadCompressor(payload_delta_state_t *state, uint8_t keyframe_interval,
+                          const PayloadFieldS *fields = PAYLOAD_FIELD_TABLE,
+                          uint8_t frame_size = payloadFrameSize()) {
+            _state = state;
+            _keyframe_interval = keyframe_interval;
+            _fields = fields;
+            _frame_size = frame_size;
+        };
+
+        /*!
+        \brief Initialization - clears state if retained data is invalid.
+        */
+        void begin(void);
+
+        /*!
+        \brief Reset state - next frame will be a keyframe.
+        */
+        void reset(void);
+
+        /*!
+        \brief Encode payload.
+
+        \param values   Payload values, indexed by PF_<key>
+        \param buf      Output buffer
+        \param size     Size of output buffer
+
+        \returns Frame length in bytes
+        */
+        uint8_t encode(const PayloadValueU *values, uint8_t *buf, uint8_t size) {
+            uint8_t seq;
+            uint8_t len = encodeFrame(values, buf, size, seq);
+
+            if (len == 0) {
+                // Keyframe required or delta frame not smaller than keyframe
+                buf[0] = PAYLOAD_HDR_KEYFRAME | seq;
+                LoraEncoder encoder(&buf[1]);
+                encodePayload(encoder, values);
+                len = 1 + encoder.getLength();
+                _state->frames = 0;
+                log_d("Keyframe #%u, %u bytes", seq, len);
+            }
+            return len;
+        };
+
+        /*!
+        \brief Update reference after transmission has been completed.
+
+        \param ack      true if frame has been acknowledged by the network
+        */
+        void confirm(bool ack);
+
+    protected:
+        payload_delta_state_t *_state;          //!< compressor state
+        uint8_t               _keyframe_interval; //!< max. delta frames between keyframes
+        const PayloadFieldS   *_fields;         //!< payload field table
+        uint8_t               _frame_size;      //!< size of uncompressed payload
+
+        /*!
+        \brief Update state for a new frame and encode it as delta frame if possible.
+
+        \param values   Payload values, indexed by PF_<key>
+        \param buf      Output buffer
+        \param size     Size of output buffer
+        \param seq      Sequence number of frame
+
+        \returns Frame length in bytes or 0 if a keyframe is required
+        */
+        uint8_t encodeFrame(const PayloadValueU *values, uint8_t *buf, uint8_t size, uint8_t &seq);
+
+        /*!
+        \brief Quantize payload value to integer.
+        */
+        static int32_t quantize(uint8_t type, const PayloadValueU &v);
+
+        /*!
+        \brief Encode delta frame.
+
+        \returns Frame length in bytes or 0 if keyframe would not be larger
+        */
+        uint8_t encodeDelta(uint8_t seq, uint8_t *buf, uint8_t size);
+};
+
+#endif // PAYLOAD_COMPRESSOR_H
@@ -0,0 +1,133 @@
+///////////////////////////////////////////////////////////////////////////////
+// PayloadEncoder.h
+//
+// Table-driven uplink payload encoder
+//
+// The encoder is generated at compile time from the field table in
+// PayloadSchema.h - for each field, a writer is selected by
+// (field index, data type, enable flag). Disabled fields and the
+// recursion over the field index are resolved by the compiler,
+// i.e. the resulting code is a plain sequence of LoraEncoder calls
+// without any run-time branches.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(PAYLOAD_ENCODER_H)
+#define PAYLOAD_ENCODER_H
+
+#include <LoraMessage.h>        //!< https://github.com/thesolarnomad/lora-serialization
+#include "PayloadSchema.h"
+
+/*!
+  \brief Writer for a single payload field - disabled fields are not written.
+*/
+template <uint8_t Type, bool En>
+struct PayloadWriter {
+    static inline void write(LoraEncoder &, const PayloadValueU &) {}
+};
+
+template <>
+struct PayloadWriter<PL_TYPE_uint8, true> {
+    static inline void write(LoraEncoder &encoder, const PayloadValueU &v) { encoder.writeUint8(v.u8); }
+};
+
+template <>
+struct PayloadWriter<PL_TYPE_bitmap_node, true> {
+    static inline void write(LoraEncoder &encoder, const PayloadValueU &v) { encoder.writeUint8(v.u8); }
+};
+
+template <>
+struct PayloadWriter<PL_TYPE_bitmap_sensors, true> {
+    static inline void write(LoraEncoder &encoder, const PayloadValueU &v) { encoder.writeUint8(v.u8); }
+};
+
+template <>
+struct PayloadWriter<PL_TYPE_uint16, true> {
+    static inline void write(LoraEncoder &encoder, const PayloadValueU &v) { encoder.writeUint16(v.u16); }
+};
+
+template <>
+struct PayloadWriter<PL_TYPE_uint16fp1, true> {
+    static inline void write(LoraEncoder &encoder, const PayloadValueU &v) { encoder.writeUint16(v.u16); }
+};
+
+template <>
+struct PayloadWriter<PL_TYPE_uint32, true> {
+    static inline void write(LoraEncoder &encoder, const PayloadValueU &v) { encoder.writeUint32(v.u32); }
+};
+
+template <>
+struct PayloadWriter<PL_TYPE_unixtime, true> {
+    static inline void write(LoraEncoder &encoder, const PayloadValueU &v) { encoder.writeUnixtime(v.u32); }
+};
+
+template <>
+struct PayloadWriter<PL_TYPE_temperature, true> {
+    static inline void write(LoraEncoder &encoder, const PayloadValueU &v) { encoder.writeTemperature(v.f); }
+};
+
+template <>
+struct PayloadWriter<PL_TYPE_rawfloat, true> {
+    static inline void write(LoraEncoder &encoder, const PayloadValueU &v) { encoder.writeRawFloat(v.f); }
+};
+
+/*!
+  \brief Encoder for payload fields <Idx>...PF_NUM-1 (unrolled at compile time)
+*/
+template <unsigned Idx, unsigned Num = PF_NUM>
+struct PayloadFieldEncoder {
+    static inline void encode(LoraEncoder &encoder, const PayloadValueU *values) {
+        PayloadWriter<PAYLOAD_FIELD_TABLE[Idx].type, PAYLOAD_FIELD_TABLE[Idx].en>::write(encoder, values[Idx]);
+        PayloadFieldEncoder<Idx + 1, Num>::encode(encoder, values);
+    }
+};
+
+template <unsigned Num>
+struct PayloadFieldEncoder<Num, Num> {
+    static inline void encode(LoraEncoder &, const PayloadValueU *) {}
+};
+
+/*!
+  \brief Encode payload
+
+  \param encoder    LoRa_Serialization encoder
+  \param values     Payload values, indexed by PF_<key>
+*/
+inline void encodePayload(LoraEncoder &encoder, const PayloadValueU *values) {
+    PayloadFieldEncoder<0>::encode(encoder, values);
+}
+
+#endif // PAYLOAD_ENCODER_H
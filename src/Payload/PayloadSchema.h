@@ -0,0 +1,239 @@
+///////////////////////////////////////////////////////////////////////////////
+// PayloadSchema.h
+//
+// Uplink payload schema (FPort 1)
+//
+// The layout of the uplink payload is defined once in the field table
+// PAYLOAD_FIELDS below. It is used for
+// - encoding the payload in cSensor::doUplink() (see PayloadEncoder.h)
+// - checking the frame size at compile time
+// - generating the Javascript decoder specification (scripts/generate_decoder.py)
+//
+// Each table entry is
+//   X(<key>, <type>, <enable>)
+//
+//   <key>    : JSON output key name (and suffix of the field index PF_<key>)
+//   <type>   : data type - name of the decoding function in scripts/*.js
+//   <enable> : 1 if the field is part of the payload, 0 otherwise;
+//              derived from the feature defines in BresserWeatherSensorTTNCfg.h
+//
+// The order of the table entries defines the order in the payload!
+//
+// Note:
+// This file must only include headers which are available to the host's
+// C preprocessor, because scripts/generate_decoder.py evaluates it with
+// g++ -dM -E -include BresserWeatherSensorTTNCfg.h src/Payload/PayloadSchema.h
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//          Added payloadPrefixSize() for truncated uplinks (FPort 8)
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(PAYLOAD_SCHEMA_H)
+#define PAYLOAD_SCHEMA_H
+
+#include <stdint.h>
+
+//
+// Field enables - derived from the feature defines in BresserWeatherSensorTTNCfg.h
+//
+#define PL_ALWAYS 1
+
+#if defined(SENSORID_EN)
+    #define PL_SENSORID 1
+#else
+    #define PL_SENSORID 0
+#endif
+
+#if defined(ADC_EN)
+    #define PL_ADC 1
+#else
+    #define PL_ADC 0
+#endif
+
+#if defined(ADC_EN) && defined(PIN_ADC3_IN)
+    #define PL_ADC3 1
+#else
+    #define PL_ADC3 0
+#endif
+
+#if defined(ONEWIRE_EN)
+    #define PL_ONEWIRE 1
+#else
+    #define PL_ONEWIRE 0
+#endif
+
+#if defined(MITHERMOMETER_EN) || defined(THEENGSDECODER_EN)
+    #define PL_BLE 1
+#else
+    #define PL_BLE 0
+#endif
+
+#if defined(SOILSENSOR_EN)
+    #define PL_SOIL 1
+#else
+    #define PL_SOIL 0
+#endif
+
+#if defined(RAINDATA_EN)
+    #define PL_RAINDATA 1
+#else
+    #define PL_RAINDATA 0
+#endif
+
+#if defined(DISTANCESENSOR_EN)
+    #define PL_DISTANCE 1
+#else
+    #define PL_DISTANCE 0
+#endif
+
+#if defined(LIGHTNINGSENSOR_EN)
+    #define PL_LIGHTNING 1
+#else
+    #define PL_LIGHTNING 0
+#endif
+
+// Wind speed/direction data type
+#if defined(ENCODE_AS_FLOAT)
+    #define PL_WIND_TYPE rawfloat
+#else
+    #define PL_WIND_TYPE uint16fp1
+#endif
+
+//
+// Payload field table - the order must match the decoder!
+//
+#define PAYLOAD_FIELDS(X) \
+    X(id,                       uint32,             PL_SENSORID)    \
+    X(status_node,              bitmap_node,        PL_ALWAYS)      \
+    X(status,                   bitmap_sensors,     PL_ALWAYS)      \
+    X(air_temp_c,               temperature,        PL_ALWAYS)      \
+    X(humidity,                 uint8,              PL_ALWAYS)      \
+    X(wind_gust_meter_sec,      PL_WIND_TYPE,       PL_ALWAYS)      \
+    X(wind_avg_meter_sec,       PL_WIND_TYPE,       PL_ALWAYS)      \
+    X(wind_direction_deg,       PL_WIND_TYPE,       PL_ALWAYS)      \
+    X(rain_mm,                  rawfloat,           PL_ALWAYS)      \
+    X(supply_v,                 uint16,             PL_ADC)         \
+    X(battery_v,                uint16,             PL_ADC3)        \
+    X(water_temp_c,             temperature,        PL_ONEWIRE)     \
+    X(indoor_temp_c,            temperature,        PL_BLE)         \
+    X(indoor_humidity,          uint8,              PL_BLE)         \
+    X(soil_temp_c,              temperature,        PL_SOIL)        \
+    X(soil_moisture,            uint8,              PL_SOIL)        \
+    X(rain_hr,                  rawfloat,           PL_RAINDATA)    \
+    X(rain_day,                 rawfloat,           PL_RAINDATA)    \
+    X(rain_week,                rawfloat,           PL_RAINDATA)    \
+    X(rain_mon,                 rawfloat,           PL_RAINDATA)    \
+    X(distance_mm,              uint16,             PL_DISTANCE)    \
+    X(lightning_time,           unixtime,           PL_LIGHTNING)   \
+    X(lightning_count,          uint16,             PL_LIGHTNING)   \
+    X(lightning_distance_km,    uint8,              PL_LIGHTNING)
+
+// Token pasting with prior macro expansion of the arguments
+#define PL_CAT_(a, b) a ## b
+#define PL_CAT(a, b) PL_CAT_(a, b)
+
+/// Payload data types - the names match the decoder functions in scripts/*.js
+enum PayloadTypeE {
+    PL_TYPE_uint8,
+    PL_TYPE_uint16,
+    PL_TYPE_uint16fp1,
+    PL_TYPE_uint32,
+    PL_TYPE_temperature,
+    PL_TYPE_rawfloat,
+    PL_TYPE_unixtime,
+    PL_TYPE_bitmap_node,
+    PL_TYPE_bitmap_sensors
+};
+
+/// Payload field indices PF_<key>
+enum PayloadFieldE {
+    #define PL_FIELD_INDEX(key, type, en) PF_ ## key,
+    PAYLOAD_FIELDS(PL_FIELD_INDEX)
+    #undef PL_FIELD_INDEX
+    PF_NUM              //!< number of fields in table (enabled or not)
+};
+
+/// Payload field table entry
+struct PayloadFieldS {
+    const char *key;    //!< JSON output key name
+    uint8_t     type;   //!< data type (PayloadTypeE)
+    bool        en;     //!< field is part of the payload
+};
+
+/// Payload field table
+constexpr PayloadFieldS PAYLOAD_FIELD_TABLE[PF_NUM] = {
+    #define PL_FIELD_ENTRY(key, type, en) { #key, PL_CAT(PL_TYPE_, type), (en) != 0 },
+    PAYLOAD_FIELDS(PL_FIELD_ENTRY)
+    #undef PL_FIELD_ENTRY
+};
+
+/// Size of payload data type in bytes
+constexpr uint8_t payloadTypeSize(uint8_t type) {
+    return ((type == PL_TYPE_uint8) || (type == PL_TYPE_bitmap_node) || (type == PL_TYPE_bitmap_sensors)) ? 1 :
+           ((type == PL_TYPE_uint16) || (type == PL_TYPE_uint16fp1) || (type == PL_TYPE_temperature)) ? 2 : 4;
+}
+
+/// Size of payload (fields <idx>...PF_NUM-1) in bytes
+constexpr unsigned payloadFrameSize(unsigned idx = 0) {
+    return (idx >= PF_NUM) ? 0 :
+        (PAYLOAD_FIELD_TABLE[idx].en ? payloadTypeSize(PAYLOAD_FIELD_TABLE[idx].type) : 0) + payloadFrameSize(idx + 1);
+}
+
+/// Size of payload field in bytes (0 if disabled)
+constexpr uint8_t payloadFieldSize(unsigned idx) {
+    return PAYLOAD_FIELD_TABLE[idx].en ? payloadTypeSize(PAYLOAD_FIELD_TABLE[idx].type) : 0;
+}
+
+/// Size of the longest payload prefix (complete fields in table order) not exceeding max_size
+/// - used for the truncated uplink (FPort 8) if the payload does not fit at the current data rate
+constexpr unsigned payloadPrefixSize(unsigned max_size, unsigned idx = 0, unsigned size = 0) {
+    return ((idx >= PF_NUM) || (size + payloadFieldSize(idx) > max_size)) ? size :
+        payloadPrefixSize(max_size, idx + 1, size + payloadFieldSize(idx));
+}
+
+/// Payload field value
+union PayloadValueU {
+    uint8_t  u8;        //!< uint8, bitmap_node, bitmap_sensors
+    uint16_t u16;       //!< uint16, uint16fp1
+    uint32_t u32;       //!< uint32, unixtime
+    float    f;         //!< temperature, rawfloat
+};
+
+/// Pack eight flags into a bitmap byte (a: MSB ... h: LSB), compatible to LoraEncoder::writeBitmap()
+constexpr uint8_t payloadBitmap(bool a, bool b, bool c, bool d, bool e, bool f, bool g, bool h) {
+    return (a << 7) | (b << 6) | (c << 5) | (d << 4) | (e << 3) | (f << 2) | (g << 1) | h;
+}
+
+#endif // PAYLOAD_SCHEMA_H
@@ -0,0 +1,170 @@
+///////////////////////////////////////////////////////////////////////////////
+// PersistStore.cpp
+//
+// Persistent storage of data structures as versioned, CRC-checked blobs
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "PersistStore.h"
+#include "../../logging.h"
+
+uint32_t PersistStore::crc32(const void *data, size_t size, uint32_t crc)
+{
+    const uint8_t *p = (const uint8_t *)data;
+
+    crc = ~crc;
+    while (size--) {
+        crc ^= *p++;
+        for (int k = 0; k < 8; k++) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+PersistStore::CacheEntryS *PersistStore::findCache(const char *key)
+{
+    for (int i = 0; i < PERSIST_CACHE_SIZE; i++) {
+        if ((_cache[i].key != nullptr) && (strcmp(_cache[i].key, key) == 0))
+            return &_cache[i];
+    }
+    return nullptr;
+}
+
+void PersistStore::updateCache(const char *key, uint32_t crc, uint8_t version)
+{
+    struct CacheEntryS *entry = findCache(key);
+
+    if (entry == nullptr) {
+        entry = &_cache[_cache_next];
+        _cache_next = (_cache_next + 1) % PERSIST_CACHE_SIZE;
+    }
+    entry->key     = key;
+    entry->crc     = crc;
+    entry->version = version;
+}
+
+bool PersistStore::load(const char *key, void *data, size_t size, uint8_t version)
+{
+    uint8_t buf[sizeof(persist_hdr_t) + PERSIST_SIZE_MAX];
+    persist_hdr_t *hdr = (persist_hdr_t *)buf;
+
+    if (size > PERSIST_SIZE_MAX)
+        return false;
+
+    if (!_prefs.begin(_name, true)) {
+        logm_d(PERSIST, "%s/%s: not available", _name, key);
+        return false;
+    }
+    size_t len = _prefs.getBytes(key, buf, sizeof(persist_hdr_t) + size);
+    _prefs.end();
+
+    if ((len != sizeof(persist_hdr_t) + size) || (hdr->magic != PERSIST_MAGIC) ||
+        (hdr->version != version) || (hdr->size != size)) {
+        logm_d(PERSIST, "%s/%s: not found or invalid", _name, key);
+        return false;
+    }
+    if (crc32(&buf[sizeof(persist_hdr_t)], size) != hdr->crc) {
+        logm_w(PERSIST, "%s/%s: CRC error", _name, key);
+        return false;
+    }
+    memcpy(data, &buf[sizeof(persist_hdr_t)], size);
+    updateCache(key, hdr->crc, version);
+    logm_v(PERSIST, "%s/%s: loaded", _name, key);
+
+    return true;
+}
+
+bool PersistStore::save(const char *key, const void *data, size_t size, uint8_t version)
+{
+    uint8_t buf[sizeof(persist_hdr_t) + PERSIST_SIZE_MAX];
+    persist_hdr_t *hdr = (persist_hdr_t *)buf;
+
+    if (size > PERSIST_SIZE_MAX)
+        return false;
+
+    uint32_t crc = crc32(data, size);
+
+    // Skip if data did not change
+    struct CacheEntryS *entry = findCache(key);
+    if ((entry != nullptr) && (entry->crc == crc) && (entry->version == version)) {
+        logm_v(PERSIST, "%s/%s: unchanged", _name, key);
+        return false;
+    }
+
+    _prefs.begin(_name, false);
+    if (entry == nullptr) {
+        // Not cached - compare to stored header
+        persist_hdr_t stored;
+        if ((_prefs.getBytesLength(key) == sizeof(persist_hdr_t) + size) &&
+            (_prefs.getBytes(key, buf, sizeof(persist_hdr_t) + size) == sizeof(persist_hdr_t) + size)) {
+            memcpy(&stored, buf, sizeof(persist_hdr_t));
+            if ((stored.magic == PERSIST_MAGIC) && (stored.version == version) &&
+                (stored.size == size) && (stored.crc == crc)) {
+                _prefs.end();
+                updateCache(key, crc, version);
+                logm_v(PERSIST, "%s/%s: unchanged", _name, key);
+                return false;
+            }
+        }
+    }
+
+    hdr->magic    = PERSIST_MAGIC;
+    hdr->version  = version;
+    hdr->reserved = 0;
+    hdr->size     = size;
+    hdr->crc      = crc;
+    memcpy(&buf[sizeof(persist_hdr_t)], data, size);
+    size_t len = _prefs.putBytes(key, buf, sizeof(persist_hdr_t) + size);
+    _prefs.end();
+
+    if (len != sizeof(persist_hdr_t) + size) {
+        logm_w(PERSIST, "%s/%s: write failed", _name, key);
+        return false;
+    }
+    updateCache(key, crc, version);
+    logm_d(PERSIST, "%s/%s: saved (%u bytes)", _name, key, (unsigned)len);
+
+    return true;
+}
+
+void PersistStore::clear(void)
+{
+    _prefs.begin(_name, false);
+    _prefs.clear();
+    _prefs.end();
+    memset(_cache, 0, sizeof(_cache));
+}
@@ -0,0 +1,150 @@
+///////////////////////////////////////////////////////////////////////////////
+// PersistStore.h
+//
+// Persistent storage of data structures as versioned, CRC-checked blobs
+//
+// Each data structure is stored as a single Preferences entry (one flash
+// write instead of one per member) with a header containing magic, version,
+// size and CRC32 of the data. On load, entries with invalid header or CRC
+// are rejected. On save, the CRC of the data is compared to the CRC of the
+// entry last loaded/saved (cached in RAM, otherwise read from flash) and
+// the write is skipped if the data did not change.
+//
+// Note: Wear levelling is provided by the underlying storage (NVS on ESP32,
+// LittleFS on RP2040).
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(PERSIST_STORE_H)
+#define PERSIST_STORE_H
+
+#include <Arduino.h>
+#include <Preferences.h>
+
+#define PERSIST_MAGIC           0x5042      //!< entry header magic ("PB")
+#define PERSIST_SIZE_MAX        256         //!< max. data size in bytes
+#define PERSIST_CACHE_SIZE      4           //!< number of cached CRCs
+
+/// Entry header
+struct PersistHdrS {
+    uint16_t magic;         //!< PERSIST_MAGIC
+    uint8_t  version;       //!< data structure version
+    uint8_t  reserved;      //!< reserved
+    uint16_t size;          //!< data size in bytes
+    uint32_t crc;           //!< CRC32 of data
+} __attribute__((packed));
+
+typedef struct PersistHdrS persist_hdr_t; //!< Shortcut for struct PersistHdrS
+
+
+/*!
+  \class PersistStore
+  \brief Persistent storage of data structures as versioned, CRC-checked blobs
+*/
+class PersistStore {
+    public:
+        /*!
+        \brief Constructor.
+
+        \param prefs        Preferences object
+        \param name         Preferences namespace
+        */
+        PersistStore(Preferences &prefs, const char *name) : _prefs(prefs) {
+            _name = name;
+            memset(_cache, 0, sizeof(_cache));
+        };
+
+        /*!
+        \brief Load data structure.
+
+        \param key          Preferences key
+        \param data         Data structure
+        \param size         Size of data structure
+        \param version      Expected data structure version
+
+        \returns true if entry was found and valid
+        */
+        bool load(const char *key, void *data, size_t size, uint8_t version);
+
+        /*!
+        \brief Save data structure - skipped if data did not change.
+
+        \param key          Preferences key
+        \param data         Data structure
+        \param size         Size of data structure
+        \param version      Data structure version
+
+        \returns true if data has been written
+        */
+        bool save(const char *key, const void *data, size_t size, uint8_t version);
+
+        /*!
+        \brief Remove all entries in namespace.
+        */
+        void clear(void);
+
+        /*!
+        \brief Calculate CRC32 (IEEE 802.3).
+
+        \param data         Data
+        \param size         Size of data
+        \param crc          Initial value (result of previous call for calculation over multiple blocks)
+
+        \returns CRC32
+        */
+        static uint32_t crc32(const void *data, size_t size, uint32_t crc = 0);
+
+    protected:
+        /// Cached CRC of entry
+        struct CacheEntryS {
+            const char *key;    //!< Preferences key
+            uint32_t    crc;    //!< CRC of stored data
+            uint8_t     version; //!< version of stored data
+        };
+
+        Preferences &_prefs;                        //!< Preferences object
+        const char  *_name;                         //!< Preferences namespace
+        struct CacheEntryS _cache[PERSIST_CACHE_SIZE]; //!< cached CRCs
+        uint8_t      _cache_next = 0;               //!< next cache entry to be replaced
+
+        /// Find cache entry
+        struct CacheEntryS *findCache(const char *key);
+
+        /// Update cache entry
+        void updateCache(const char *key, uint32_t crc, uint8_t version);
+};
+
+#endif // PERSIST_STORE_H
@@ -0,0 +1,105 @@
+///////////////////////////////////////////////////////////////////////////////
+// PhaseTimer.cpp
+//
+// Execution time measurement of wake cycle phases
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "PhaseTimer.h"
+#include "../../logging.h"
+
+// Phase names - order must match phase_t
+static const char *phase_names[PHASE_NUM] = {
+    "sensor lookup",
+    "encoding",
+    "send scheduling",
+    "serial init",
+    "sensor reception",
+    "BLE scan",
+    "LoRaWAN init",
+    "setup total"
+};
+
+void PhaseTimer::reset(void)
+{
+    for (int i=0; i < PHASE_NUM; i++) {
+        _stats[i].count  = 0;
+        _stats[i].min_us = UINT32_MAX;
+        _stats[i].max_us = 0;
+        _stats[i].sum_us = 0;
+        _last[i]         = 0;
+    }
+}
+
+uint32_t PhaseTimer::stop(phase_t phase)
+{
+    uint32_t duration = micros() - _start[phase];
+
+    _last[phase] = duration;
+    if ((_stats[phase].count == 0) || (duration < _stats[phase].min_us)) {
+        _stats[phase].min_us = duration;
+    }
+    if (duration > _stats[phase].max_us) {
+        _stats[phase].max_us = duration;
+    }
+    _stats[phase].sum_us += duration;
+    _stats[phase].count++;
+
+    return duration;
+}
+
+const char *PhaseTimer::name(phase_t phase)
+{
+    return phase_names[phase];
+}
+
+void PhaseTimer::print(void)
+{
+    log_i("--- Phase Timing [us] ---");
+    for (int i=0; i < PHASE_NUM; i++) {
+        if (_stats[i].count == 0) {
+            log_i("%-16s: ---", phase_names[i]);
+            continue;
+        }
+        log_i("%-16s: last=%6u min=%6u avg=%6u max=%6u (n=%u)",
+            phase_names[i],
+            (unsigned)_last[i],
+            (unsigned)_stats[i].min_us,
+            (unsigned)(_stats[i].sum_us / _stats[i].count),
+            (unsigned)_stats[i].max_us,
+            (unsigned)_stats[i].count);
+    }
+}
@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////////////////////
+// PhaseTimer.h
+//
+// Execution time measurement of wake cycle phases
+//
+// The durations of the phases of a wake cycle (e.g. serial port and LoRaWAN
+// initialization, sensor data reception, finding the sensor data, encoding
+// the payload, scheduling the uplink) are measured with micros().
+// Statistics (count/min/max/sum) are accumulated in a buffer provided by
+// the caller - if this buffer is located in RTC RAM, the statistics are
+// retained across deep sleep cycles and can be used as a baseline
+// for optimizations.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(PHASE_TIMER_H)
+#define PHASE_TIMER_H
+
+#include <Arduino.h>
+
+/// Wake cycle phases
+enum phase_t {
+    PHASE_SENSOR_LOOKUP,    //!< find sensor data in WeatherSensor slots
+    PHASE_ENCODE,           //!< encode uplink payload
+    PHASE_SCHEDULE,         //!< schedule uplink transmission
+    PHASE_SERIAL_INIT,      //!< serial port initialization in setup()
+    PHASE_SENSOR_RX,        //!< weather sensor data reception
+    PHASE_BLE_SCAN,         //!< BLE sensor scan (remaining time if run concurrently)
+    PHASE_LORAWAN_INIT,     //!< LoRaWAN initialization
+    PHASE_SETUP,            //!< complete setup(), i.e. wake-up until uplink request
+    PHASE_NUM               //!< number of phases
+};
+
+/// Execution time statistics of a single phase
+struct PhaseStatsS {
+    uint32_t count;         //!< number of measurements
+    uint32_t min_us;        //!< minimum duration in us
+    uint32_t max_us;        //!< maximum duration in us
+    uint64_t sum_us;        //!< sum of durations in us
+};
+
+typedef struct PhaseStatsS phase_stats_t; //!< Shortcut for struct PhaseStatsS
+
+
+/*!
+  \class PhaseTimer
+  \brief Execution time measurement of wake cycle phases
+*/
+class PhaseTimer {
+    public:
+        /*!
+        \brief Constructor.
+
+        \param stats    Statistics buffer with PHASE_NUM entries (e.g. in RTC RAM)
+        */
+        PhaseTimer(phase_stats_t *stats) {
+            _stats = stats;
+        };
+
+        /*!
+        \brief Clear statistics.
+        */
+        void reset(void);
+
+        /*!
+        \brief Start measurement of phase.
+
+        \param phase    Wake cycle phase
+        */
+        void start(phase_t phase) {
+            _start[phase] = micros();
+        };
+
+        /*!
+        \brief Stop measurement of phase and update statistics.
+
+        \param phase    Wake cycle phase
+
+        \returns Duration in us
+        */
+        uint32_t stop(phase_t phase);
+
+        /*!
+        \brief Get duration of last measurement.
+
+        \param phase    Wake cycle phase
+
+        \returns Duration in us
+        */
+        uint32_t last(phase_t phase) {
+            return _last[phase];
+        };
+
+        /*!
+        \brief Get name of phase.
+
+        \param phase    Wake cycle phase
+
+        \returns Phase name
+        */
+        static const char *name(phase_t phase);
+
+        /*!
+        \brief Print last durations and statistics of all phases.
+        */
+        void print(void);
+
+    protected:
+        phase_stats_t *_stats;              //!< statistics buffer
+        uint32_t      _start[PHASE_NUM];    //!< start timestamps in us
+        uint32_t      _last[PHASE_NUM];     //!< last durations in us
+};
+
+#endif
@@ -0,0 +1,123 @@
+///////////////////////////////////////////////////////////////////////////////
+// RadioCtx.cpp
+//
+// SX127x radio context switch between LoRaWAN (LMIC) and FSK sensor reception
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "RadioCtx.h"
+#include <arduino_lmic.h>
+#include "../../logging.h"
+
+// SX127x registers
+#define SX127X_REG_FIFO         0x00
+#define SX127X_REG_OPMODE       0x01
+#define SX127X_OPMODE_LORA      0x80
+#define SX127X_OPMODE_MASK      0x07
+#define SX127X_OPMODE_SLEEP     0x00
+
+// Registers saved in LoRa mode - the order is the order of restoring
+static const uint8_t radio_ctx_regs[RADIO_CTX_NUM_REGS] = {
+    0x06, 0x07, 0x08,       // RegFrfMsb/Mid/Lsb
+    0x09, 0x0A, 0x0B, 0x0C, // RegPaConfig, RegPaRamp, RegOcp, RegLna
+    0x0D, 0x0E, 0x0F,       // RegFifoAddrPtr, RegFifoTxBaseAddr, RegFifoRxBaseAddr
+    0x11,                   // RegIrqFlagsMask
+    0x1D, 0x1E, 0x1F,       // RegModemConfig1/2, RegSymbTimeoutLsb
+    0x20, 0x21, 0x22, 0x23, // RegPreambleMsb/Lsb, RegPayloadLength, RegMaxPayloadLength
+    0x24, 0x26, 0x27,       // RegHopPeriod, RegModemConfig3, RegPpmCorrection
+    0x31, 0x33, 0x37,       // RegDetectOptimize, RegInvertIQ, RegDetectionThreshold
+    0x39, 0x3B,             // RegSyncWord, RegInvertIQ2
+    0x40, 0x41,             // RegDioMapping1/2
+    0x4B, 0x4D,             // RegTcxo, RegPaDac
+    0x61, 0x62, 0x63, 0x64  // RegAgcRef, RegAgcThresh1/2/3
+};
+
+// Read SX127x register via LMIC HAL
+static uint8_t readReg(uint8_t addr)
+{
+    uint8_t val;
+
+    hal_spi_read(addr & 0x7F, &val, 1);
+    return val;
+}
+
+// Write SX127x register via LMIC HAL
+static void writeReg(uint8_t addr, uint8_t val)
+{
+    hal_spi_write(addr | 0x80, &val, 1);
+}
+
+bool RadioCtx::lmicIdle(void)
+{
+    return (LMIC.opmode & (OP_JOINING | OP_TXDATA | OP_POLL | OP_TXRXPEND | OP_RNDTX)) == 0;
+}
+
+bool RadioCtx::save(void)
+{
+    _opmode = readReg(SX127X_REG_OPMODE);
+    _valid  = (_opmode & SX127X_OPMODE_LORA) != 0;
+
+    if (!_valid) {
+        log_d("Radio not in LoRa mode - context not saved");
+        return false;
+    }
+
+    for (int i=0; i < RADIO_CTX_NUM_REGS; i++) {
+        _regs[i] = readReg(radio_ctx_regs[i]);
+    }
+    log_v("Radio context saved (RegOpMode=0x%02X)", _opmode);
+
+    return true;
+}
+
+void RadioCtx::restore(void)
+{
+    if (!_valid) {
+        return;
+    }
+
+    // The mode (FSK/LoRa) can only be changed in sleep mode
+    uint8_t opmode = readReg(SX127X_REG_OPMODE);
+    writeReg(SX127X_REG_OPMODE, (opmode & ~SX127X_OPMODE_MASK) | SX127X_OPMODE_SLEEP);
+    writeReg(SX127X_REG_OPMODE, (_opmode & ~SX127X_OPMODE_MASK) | SX127X_OPMODE_SLEEP);
+
+    for (int i=0; i < RADIO_CTX_NUM_REGS; i++) {
+        writeReg(radio_ctx_regs[i], _regs[i]);
+    }
+
+    writeReg(SX127X_REG_OPMODE, _opmode);
+    log_v("Radio context restored (RegOpMode=0x%02X)", readReg(SX127X_REG_OPMODE));
+}
@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////////////////////////
+// RadioCtx.h
+//
+// SX127x radio context switch between LoRaWAN (LMIC) and FSK sensor reception
+//
+// The radio transceiver is shared between the LMIC (LoRa mode) and
+// BresserWeatherSensorReceiver (FSK mode, RadioLib). WeatherSensor::begin()
+// resets and re-initializes the transceiver, i.e. all settings made by
+// the LMIC are lost. RadioCtx saves the LoRa mode registers before and
+// restores them after sensor data reception, so the LMIC can continue
+// without a restart.
+//
+// Notes:
+// - The LMIC must be idle (no TX/RX or join pending) while the context
+//   is switched - see RadioCtx::lmicIdle().
+// - In the SX127x, the register addresses 0x0D...0x3F are mapped to
+//   different registers in FSK mode and in LoRa mode. Therefore these
+//   registers are saved in LoRa mode and are restored after switching
+//   back to LoRa mode (which is only possible in sleep mode).
+// - The LMIC re-configures the modem (frequency, spreading factor,
+//   bandwidth, power, ...) before each transmission/reception, anyway.
+//   Restoring the context makes sure that settings which are only made
+//   during initialization are retained, too.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(RADIO_CTX_H)
+#define RADIO_CTX_H
+
+#include <Arduino.h>
+
+#define RADIO_CTX_NUM_REGS 34   //!< number of saved registers - see RadioCtx.cpp
+
+
+/*!
+  \class RadioCtx
+  \brief SX127x radio context switch between LoRaWAN (LMIC) and FSK sensor reception
+*/
+class RadioCtx {
+    public:
+        /*!
+        \brief Constructor.
+        */
+        RadioCtx() {
+            _valid = false;
+        };
+
+        /*!
+        \brief Check if LMIC is idle, i.e. if the radio context may be switched.
+
+        \returns true if no LMIC radio operation is pending
+        */
+        static bool lmicIdle(void);
+
+        /*!
+        \brief Save LoRa mode register context.
+
+        \returns true if the radio was in LoRa mode and the context has been saved
+        */
+        bool save(void);
+
+        /*!
+        \brief Restore LoRa mode register context.
+
+        Puts the radio into sleep mode, switches to LoRa mode and
+        writes the saved registers.
+        */
+        void restore(void);
+
+    protected:
+        bool    _valid;                         //!< context has been saved
+        uint8_t _opmode;                        //!< saved RegOpMode
+        uint8_t _regs[RADIO_CTX_NUM_REGS];      //!< saved register values
+};
+
+#endif // RADIO_CTX_H
@@ -0,0 +1,137 @@
+///////////////////////////////////////////////////////////////////////////////
+// RainHistory.cpp
+//
+// Rain gauge statistics with constant-time window queries
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "RainHistory.h"
+#include "../../logging.h"
+
+// https://howardhinnant.github.io/date_algorithms.html#days_from_civil
+int32_t RainHistory::daysFromCivil(int y, unsigned m, unsigned d)
+{
+    y -= m <= 2;
+    const int32_t  era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = (unsigned)(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (int32_t)doe - 719468;
+}
+
+void RainHistory::reset(uint8_t flags)
+{
+    if (flags & RESET_RAIN_H) {
+        _state->buckets = 0;
+    }
+    if (flags & RESET_RAIN_D) {
+        _state->day_base = _state->total;
+    }
+    if (flags & RESET_RAIN_W) {
+        _state->week_base = _state->total;
+    }
+    if (flags & RESET_RAIN_M) {
+        _state->month_base = _state->total;
+    }
+}
+
+void RainHistory::update(time_t timestamp, float rain, bool startup)
+{
+    struct tm t;
+    localtime_r(&timestamp, &t);
+
+    const int32_t  raw    = lroundf(rain * 10);
+    const int32_t  day    = daysFromCivil(t.tm_year + 1900, t.tm_mon + 1, t.tm_mday);
+    const int32_t  week   = (day + 3) / 7; // weeks start on Monday; 1970-01-01 was a Thursday
+    const int32_t  month  = (t.tm_year + 1900) * 12 + t.tm_mon;
+    const uint32_t bucket = (uint32_t)timestamp / RAIN_HIST_BUCKET_S;
+
+    // Start new calendar periods
+    if (!_state->valid || (day != _state->day)) {
+        _state->day      = day;
+        _state->day_base = _state->total;
+    }
+    if (!_state->valid || (week != _state->week)) {
+        _state->week      = week;
+        _state->week_base = _state->total;
+    }
+    if (!_state->valid || (month != _state->month)) {
+        _state->month      = month;
+        _state->month_base = _state->total;
+    }
+
+    // Advance time buckets - new buckets start with the current total
+    if ((_state->buckets == 0) || (bucket < _state->bucket)) {
+        _state->bucket  = bucket;
+        _state->buckets = 1;
+        _state->prefix[bucket % RAIN_HIST_BUCKETS] = _state->total;
+    } else if (bucket > _state->bucket) {
+        uint32_t gap = bucket - _state->bucket;
+        if (gap > RAIN_HIST_BUCKETS) {
+            gap = RAIN_HIST_BUCKETS;
+        }
+        for (uint32_t i = 0; i < gap; i++) {
+            _state->prefix[(bucket - i) % RAIN_HIST_BUCKETS] = _state->total;
+        }
+        _state->buckets = (_state->buckets + gap < RAIN_HIST_BUCKETS) ? _state->buckets + gap : RAIN_HIST_BUCKETS;
+        _state->bucket  = bucket;
+    }
+
+    // Accumulate rain gauge delta
+    if (_state->valid) {
+        int32_t delta = raw - _state->raw;
+        if (delta < 0) {
+            if (startup) {
+                // Sensor restart - counter started from zero
+                delta = raw;
+                log_d("Rain gauge: sensor restart");
+            } else {
+                // Counter overflow
+                delta += _max;
+                log_d("Rain gauge: overflow");
+            }
+        }
+        if (delta > 0) {
+            _state->total += delta;
+        }
+    }
+    _state->raw     = raw;
+    _state->startup = startup;
+    _state->valid   = true;
+
+    log_v("Rain total: %u (0.1 mm), bucket %u (%u valid)", (unsigned)_state->total,
+          (unsigned)_state->bucket, _state->buckets);
+}
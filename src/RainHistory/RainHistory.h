@@ -0,0 +1,182 @@
+///////////////////////////////////////////////////////////////////////////////
+// RainHistory.h
+//
+// Rain gauge statistics with constant-time window queries
+//
+// Drop-in replacement for RainGauge (BresserWeatherSensorReceiver) which
+// keeps its state in a compact structure provided by the caller - if the
+// structure is located in RAM retained during deep sleep, no flash
+// (Preferences) writes are required.
+//
+// The rain gauge value is accumulated as fixed-point total [0.1 mm]
+// (handling counter overflow and sensor restart). All windows are
+// evaluated as difference of this total and a prefix value:
+// - past 60 minutes: ring buffer with the total at the start of each
+//   time bucket (RAIN_HIST_BUCKET_S); the oldest bucket is the reference
+// - current day/week/month: total at the start of the calendar period
+//
+// I.e. update() and all queries are O(1). Rain is attributed to the
+// bucket of the update in which it was detected; the past 60 minutes
+// window has a resolution of RAIN_HIST_BUCKET_S.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(RAIN_HISTORY_H)
+#define RAIN_HISTORY_H
+
+#include <Arduino.h>
+#include <time.h>
+
+#if !defined(RAIN_HIST_BUCKET_S)
+#define RAIN_HIST_BUCKET_S      300     //!< time bucket for past 60 minutes [s]
+#endif
+#define RAIN_HIST_BUCKETS       (3600 / RAIN_HIST_BUCKET_S + 1) //!< number of buckets (60 minutes + current)
+#define RAIN_HIST_MAGIC         0x5241494E  //!< validation of retained data ("RAIN")
+
+// Flags for reset() - same as RainGauge
+#if !defined(RESET_RAIN_H)
+#define RESET_RAIN_H            1       //!< reset past 60 minutes
+#define RESET_RAIN_D            2       //!< reset current day
+#define RESET_RAIN_W            4       //!< reset current week
+#define RESET_RAIN_M            8       //!< reset current month
+#endif
+
+/// Rain history - must be retained across deep sleep (e.g. in RTC RAM)
+struct RainHistoryS {
+    uint32_t magic;                             //!< validation of retained data
+    bool     valid;                             //!< raw value/time valid
+    bool     startup;                           //!< sensor startup flag at last update
+    int32_t  raw;                               //!< last raw rain gauge value [0.1 mm]
+    uint32_t total;                             //!< accumulated rain [0.1 mm]
+    uint32_t bucket;                            //!< current time bucket (time / RAIN_HIST_BUCKET_S)
+    uint8_t  buckets;                           //!< number of valid buckets
+    uint32_t prefix[RAIN_HIST_BUCKETS];         //!< total at start of time bucket
+    int32_t  day;                               //!< current day (days since 1970-01-01, local time)
+    int32_t  week;                              //!< current week (weeks since 1969-12-29, local time)
+    int32_t  month;                             //!< current month (year * 12 + month, local time)
+    uint32_t day_base;                          //!< total at start of current day
+    uint32_t week_base;                         //!< total at start of current week
+    uint32_t month_base;                        //!< total at start of current month
+};
+
+typedef struct RainHistoryS rain_history_t; //!< Shortcut for struct RainHistoryS
+
+
+/*!
+  \class RainHistory
+  \brief Rain gauge statistics with constant-time window queries
+*/
+class RainHistory {
+    public:
+        /*!
+        \brief Constructor.
+
+        \param state        Rain history (retained across deep sleep)
+        \param raingauge_max Rain gauge overflow value [mm]
+        */
+        RainHistory(rain_history_t *state, float raingauge_max = 100000) {
+            _state = state;
+            set_max(raingauge_max);
+        };
+
+        /*!
+        \brief Initialization - clears history if retained data is invalid.
+        */
+        void begin(void) {
+            if (_state->magic != RAIN_HIST_MAGIC) {
+                memset(_state, 0, sizeof(rain_history_t));
+                _state->magic = RAIN_HIST_MAGIC;
+            }
+        };
+
+        /*!
+        \brief Set rain gauge overflow value.
+
+        \param raingauge_max    Overflow value [mm]
+        */
+        void set_max(float raingauge_max) {
+            _max = lroundf(raingauge_max * 10);
+        };
+
+        /*!
+        \brief Reset statistics.
+
+        \param flags    RESET_RAIN_H | RESET_RAIN_D | RESET_RAIN_W | RESET_RAIN_M
+        */
+        void reset(uint8_t flags = RESET_RAIN_H | RESET_RAIN_D | RESET_RAIN_W | RESET_RAIN_M);
+
+        /*!
+        \brief Update statistics.
+
+        \param timestamp    time (for local time conversion with localtime_r())
+        \param rain         rain gauge value [mm]
+        \param startup      sensor startup flag
+        */
+        void update(time_t timestamp, float rain, bool startup = false);
+
+        /// Rain during past 60 minutes [mm]
+        float pastHour(void) const {
+            if (_state->buckets == 0)
+                return 0;
+            // Oldest bucket within the past 60 minutes (or oldest bucket available)
+            uint8_t n = (_state->buckets < RAIN_HIST_BUCKETS) ? _state->buckets : RAIN_HIST_BUCKETS;
+            return (_state->total - _state->prefix[(_state->bucket - (n - 1)) % RAIN_HIST_BUCKETS]) / 10.0;
+        };
+
+        /// Rain during current day [mm]
+        float currentDay(void) const {
+            return (_state->total - _state->day_base) / 10.0;
+        };
+
+        /// Rain during current week [mm]
+        float currentWeek(void) const {
+            return (_state->total - _state->week_base) / 10.0;
+        };
+
+        /// Rain during current month [mm]
+        float currentMonth(void) const {
+            return (_state->total - _state->month_base) / 10.0;
+        };
+
+    protected:
+        rain_history_t *_state; //!< rain history
+        int32_t         _max;   //!< rain gauge overflow value [0.1 mm]
+
+        /// Days since 1970-01-01 from civil date
+        static int32_t daysFromCivil(int y, unsigned m, unsigned d);
+};
+
+#endif // RAIN_HISTORY_H
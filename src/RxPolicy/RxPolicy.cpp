@@ -0,0 +1,135 @@
+///////////////////////////////////////////////////////////////////////////////
+// RxPolicy.cpp
+//
+// Weather sensor receive policy with early exit and adaptive deadline
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//          Added callback parameter to receive()
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "RxPolicy.h"
+#include "../../logging.h"
+
+void RxPolicy::begin(void)
+{
+    if ((_history->magic != RX_HISTORY_MAGIC) || (_history->idx >= RX_HISTORY_SIZE) || (_history->count > RX_HISTORY_SIZE)) {
+        memset(_history, 0, sizeof(rx_history_t));
+        _history->magic = RX_HISTORY_MAGIC;
+    }
+}
+
+uint32_t RxPolicy::deadline(uint32_t timeout_ms)
+{
+    if (_history->count < RX_HISTORY_MIN) {
+        return timeout_ms;
+    }
+
+    uint32_t max_s = 0;
+    for (int i=0; i < _history->count; i++) {
+        if (_history->arrival_s[i] > max_s) {
+            max_s = _history->arrival_s[i];
+        }
+    }
+
+    uint32_t deadline_ms = (max_s * RX_DEADLINE_MARGIN / 100 + RX_DEADLINE_GUARD) * 1000;
+    return (deadline_ms < timeout_ms) ? deadline_ms : timeout_ms;
+}
+
+uint8_t RxPolicy::status(void)
+{
+    uint8_t res = 0;
+
+    int ws = _ws.findType(SENSOR_TYPE_WEATHER0);
+    if (ws < 0) {
+        ws = _ws.findType(SENSOR_TYPE_WEATHER1);
+    }
+    if ((ws > -1) && _ws.sensor[ws].valid && _ws.sensor[ws].complete) {
+        res |= RX_REQ_WEATHER;
+    }
+
+    // Same channel as in cSensor::doUplink()
+    int s1 = _ws.findType(SENSOR_TYPE_SOIL, 1);
+    if ((s1 > -1) && _ws.sensor[s1].valid) {
+        res |= RX_REQ_SOIL;
+    }
+
+    int ls = _ws.findType(SENSOR_TYPE_LIGHTNING);
+    if ((ls > -1) && _ws.sensor[ls].valid) {
+        res |= RX_REQ_LIGHTNING;
+    }
+
+    return res;
+}
+
+uint8_t RxPolicy::receive(uint8_t required, uint32_t timeout_ms, void (*func)())
+{
+    const uint32_t deadline_ms = deadline(timeout_ms);
+    const uint32_t start = millis();
+    uint8_t received = 0;
+
+    log_d("Required: 0x%02X, deadline: %u ms", required, (unsigned)deadline_ms);
+
+    while (((received & required) != required) && ((millis() - start) < deadline_ms)) {
+        if (_ws.getMessage() == DECODE_OK) {
+            received = status();
+        }
+        if (func) {
+            func();
+        }
+    }
+
+    uint32_t elapsed_ms = millis() - start;
+    if ((received & required) == required) {
+        record((elapsed_ms + 999) / 1000);
+        log_d("Required sensors received after %u ms", (unsigned)elapsed_ms);
+    } else {
+        // Deadline missed - let deadline grow
+        uint32_t timeout_s = timeout_ms / 1000;
+        uint32_t grow_s = deadline_ms / 1000 * 2;
+        record((grow_s < timeout_s) ? grow_s : timeout_s);
+        log_d("Deadline missed - received: 0x%02X", received);
+    }
+
+    return received;
+}
+
+void RxPolicy::record(uint32_t arrival_s)
+{
+    _history->arrival_s[_history->idx] = (arrival_s < 0xFFFF) ? arrival_s : 0xFFFF;
+    _history->idx = (_history->idx + 1) % RX_HISTORY_SIZE;
+    if (_history->count < RX_HISTORY_SIZE) {
+        _history->count++;
+    }
+}
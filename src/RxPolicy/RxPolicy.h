@@ -0,0 +1,144 @@
+///////////////////////////////////////////////////////////////////////////////
+// RxPolicy.h
+//
+// Weather sensor receive policy with early exit and adaptive deadline
+//
+// Instead of waiting until all slots have been filled (or the timeout
+// has expired), sensor messages are received until a configurable set of
+// sensor types is available. The time needed to receive the required
+// sensors is stored in a history buffer provided by the caller - if this
+// buffer is retained during deep sleep, reception is aborted with partial
+// data after an adaptive deadline derived from the recent arrival times:
+//
+//   deadline = max(history) * RX_DEADLINE_MARGIN / 100 + RX_DEADLINE_GUARD
+//
+// limited to the configured timeout. If the deadline is missed, twice the
+// deadline is stored in the history, i.e. the deadline grows until the
+// sensors are received again.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//          Added callback parameter to receive()
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(RX_POLICY_H)
+#define RX_POLICY_H
+
+#include <Arduino.h>
+#include "WeatherSensorCfg.h"
+#include "WeatherSensor.h"
+
+// Required sensor types (bitmap)
+#define RX_REQ_WEATHER      0x01    //!< weather sensor (SENSOR_TYPE_WEATHER0/1), complete
+#define RX_REQ_SOIL         0x02    //!< soil sensor (SENSOR_TYPE_SOIL), channel 1
+#define RX_REQ_LIGHTNING    0x04    //!< lightning sensor (SENSOR_TYPE_LIGHTNING)
+
+#define RX_HISTORY_MAGIC    0x52584830  // "RXH0"
+#define RX_HISTORY_SIZE     8       //!< number of arrival times in history
+#define RX_HISTORY_MIN      3       //!< min. number of arrival times for adaptive deadline
+#define RX_DEADLINE_MARGIN  150     //!< deadline margin [%]
+#define RX_DEADLINE_GUARD   10      //!< deadline guard time [s]
+
+/// Arrival time history - must be retained across deep sleep (e.g. in RTC RAM)
+struct RxHistoryS {
+    uint32_t magic;                             //!< validation of retained data
+    uint8_t  idx;                               //!< index of next entry
+    uint8_t  count;                             //!< number of valid entries
+    uint16_t arrival_s[RX_HISTORY_SIZE];        //!< time until required sensors were received [s]
+};
+
+typedef struct RxHistoryS rx_history_t; //!< Shortcut for struct RxHistoryS
+
+
+/*!
+  \class RxPolicy
+  \brief Weather sensor receive policy with early exit and adaptive deadline
+*/
+class RxPolicy {
+    public:
+        /*!
+        \brief Constructor.
+
+        \param ws       WeatherSensor object
+        \param history  Arrival time history (retained across deep sleep)
+        */
+        RxPolicy(WeatherSensor &ws, rx_history_t *history) : _ws(ws) {
+            _history = history;
+        };
+
+        /*!
+        \brief Initialization - clears history if retained data is invalid.
+        */
+        void begin(void);
+
+        /*!
+        \brief Receive sensor messages until all required sensors are available.
+
+        The WeatherSensor object must have been initialized and its slots cleared before.
+
+        \param required     Required sensor types (RX_REQ_* bitmap)
+        \param timeout_ms   Max. reception time in ms
+        \param func         Callback function for each receive attempt (like WeatherSensor::getData())
+
+        \returns Received sensor types (RX_REQ_* bitmap)
+        */
+        uint8_t receive(uint8_t required, uint32_t timeout_ms, void (*func)() = NULL);
+
+        /*!
+        \brief Get current reception deadline.
+
+        \param timeout_ms   Max. reception time in ms
+
+        \returns Deadline in ms
+        */
+        uint32_t deadline(uint32_t timeout_ms);
+
+        /*!
+        \brief Get sensor types available in WeatherSensor slots.
+
+        \returns Sensor types (RX_REQ_* bitmap)
+        */
+        uint8_t status(void);
+
+    protected:
+        WeatherSensor &_ws;         //!< WeatherSensor object
+        rx_history_t  *_history;    //!< arrival time history
+
+        /*!
+        \brief Add arrival time to history.
+        */
+        void record(uint32_t arrival_s);
+};
+
+#endif // RX_POLICY_H
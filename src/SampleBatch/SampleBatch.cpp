@@ -0,0 +1,149 @@
+///////////////////////////////////////////////////////////////////////////////
+// SampleBatch.cpp
+//
+// Batching of weather sensor samples across deep sleep cycles
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//          encode(): return 0 if buffer is too small
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SampleBatch.h"
+#include <LoraMessage.h>
+#include "../../logging.h"
+
+void SampleBatch::begin(void)
+{
+    if ((_state->magic != SAMPLE_BATCH_MAGIC) || (_state->count > SAMPLE_BATCH_MAX) || (_state->head >= SAMPLE_BATCH_MAX)) {
+        memset(_state, 0, sizeof(batch_state_t));
+        _state->magic = SAMPLE_BATCH_MAGIC;
+    }
+    _state->pending = 0;
+}
+
+void SampleBatch::add(uint32_t time, bool valid, bool battery_ok, float temp_c, uint8_t humidity,
+                      uint16_t wind_gust_fp1, uint16_t wind_avg_fp1, uint16_t wind_dir_fp1, float rain_mm)
+{
+    batch_sample_t *sample;
+
+    if (_state->count < SAMPLE_BATCH_MAX) {
+        sample = &_state->samples[(_state->head + _state->count) % SAMPLE_BATCH_MAX];
+        _state->count++;
+    } else {
+        // Buffer full - overwrite oldest sample
+        sample = &_state->samples[_state->head];
+        _state->head = (_state->head + 1) % SAMPLE_BATCH_MAX;
+        log_d("Sample buffer full - oldest sample dropped");
+    }
+
+    memset(sample, 0, sizeof(batch_sample_t));
+    sample->time = time;
+    if (!valid) {
+        sample->rain_mm  = -1;
+        sample->humidity = SAMPLE_BATCH_NO_DATA;
+        return;
+    }
+    sample->rain_mm   = rain_mm;
+    sample->temp_c100 = (int16_t)(temp_c * 100);
+    sample->humidity  = ((humidity < SAMPLE_BATCH_NO_DATA) ? humidity : SAMPLE_BATCH_NO_DATA - 1) | (battery_ok ? 0x80 : 0);
+    sample->wind_gust = (wind_gust_fp1 / 2 < 0xFF) ? wind_gust_fp1 / 2 : 0xFF;
+    sample->wind_avg  = (wind_avg_fp1 / 2 < 0xFF) ? wind_avg_fp1 / 2 : 0xFF;
+    sample->wind_dir  = (wind_dir_fp1 / 20) % 180;
+    log_d("Sample #%u stored", _state->count);
+}
+
+uint8_t SampleBatch::encode(uint8_t *buf, uint8_t size)
+{
+    uint8_t n = _state->count;
+
+    if (size < SAMPLE_BATCH_HDR_SIZE + SAMPLE_BATCH_REC_SIZE) {
+        log_w("Batch: buffer too small (%u bytes)", size);
+        return 0;
+    }
+    if (SAMPLE_BATCH_HDR_SIZE + n * SAMPLE_BATCH_REC_SIZE > size) {
+        n = (size - SAMPLE_BATCH_HDR_SIZE) / SAMPLE_BATCH_REC_SIZE;
+    }
+
+    const batch_sample_t *base = &_state->samples[_state->head];
+    LoraEncoder encoder(buf);
+
+    // Base rain gauge value - from oldest sample with valid rain data
+    float base_rain = -1;
+    for (uint8_t i=0; i < n; i++) {
+        const batch_sample_t *sample = &_state->samples[(_state->head + i) % SAMPLE_BATCH_MAX];
+        if (sample->rain_mm >= 0) {
+            base_rain = sample->rain_mm;
+            break;
+        }
+    }
+
+    encoder.writeUint8(n);
+    encoder.writeUnixtime(base->time);
+    encoder.writeRawFloat(base_rain);
+
+    for (uint8_t i=0; i < n; i++) {
+        const batch_sample_t *sample = &_state->samples[(_state->head + i) % SAMPLE_BATCH_MAX];
+        uint32_t dt = sample->time - base->time;
+        uint16_t rain = 0xFFFF;
+
+        if ((sample->rain_mm >= 0) && (base_rain >= 0) && (sample->rain_mm >= base_rain)) {
+            float delta = (sample->rain_mm - base_rain) * 10;
+            rain = (delta < 0xFFFF) ? (uint16_t)(delta + 0.5f) : 0xFFFE;
+        }
+        encoder.writeUint16((dt < 0xFFFF) ? dt : 0xFFFF);
+        // same encoding as LoraEncoder::writeTemperature(), but without float conversion
+        encoder.writeUint8((uint16_t)sample->temp_c100 >> 8);
+        encoder.writeUint8((uint16_t)sample->temp_c100 & 0xFF);
+        encoder.writeUint8(sample->humidity);
+        encoder.writeUint8(sample->wind_gust);
+        encoder.writeUint8(sample->wind_avg);
+        encoder.writeUint8(sample->wind_dir);
+        encoder.writeUint16(rain);
+    }
+    _state->pending = n;
+    log_d("Batch: %u samples, %u bytes", n, encoder.getLength());
+
+    return encoder.getLength();
+}
+
+void SampleBatch::confirm(bool ack)
+{
+    if (ack && (_state->pending > 0)) {
+        // Remove transmitted samples
+        uint8_t n = (_state->pending < _state->count) ? _state->pending : _state->count;
+        _state->head   = (_state->head + n) % SAMPLE_BATCH_MAX;
+        _state->count -= n;
+    }
+    _state->pending = 0;
+}
@@ -0,0 +1,161 @@
+///////////////////////////////////////////////////////////////////////////////
+// SampleBatch.h
+//
+// Batching of weather sensor samples across deep sleep cycles
+//
+// Compact weather sensor samples are stored in a ring buffer provided by
+// the caller - if this buffer is located in RAM which is retained during
+// deep sleep, LoRaWAN transmission can be skipped until a number of samples
+// has been collected. All samples are then sent in a single uplink
+// (FPort 5), i.e. the energy for TX and the RX1/RX2 windows is spent only
+// once per batch. The samples are removed from the buffer only after the
+// uplink has been acknowledged; if the buffer is full, the oldest sample
+// is overwritten.
+//
+// Frame format
+// -------------
+// byte 0:      number of samples n
+// byte 1..4:   base time - unixtime (LE) of the oldest sample
+// byte 5..8:   base rain gauge value [mm] - float (LE) of the oldest sample with valid rain data
+// n x 10 bytes sample:
+//   0..1:      time offset to base time [s] - uint16 (LE)
+//   2..3:      air temperature [degC * 100] - int16 (BE), as LoraEncoder::writeTemperature()
+//   4:         bit 7: battery o.k., bits 6:0: humidity [%], 0x7F: no sensor data
+//   5:         wind gust speed [0.2 m/s]
+//   6:         wind average speed [0.2 m/s]
+//   7:         wind direction [2 deg]
+//   8..9:      rain gauge value - base rain [0.1 mm] - uint16 (LE), 0xFFFF: invalid
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//          encode(): return 0 if buffer is too small
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(SAMPLE_BATCH_H)
+#define SAMPLE_BATCH_H
+
+#include <Arduino.h>
+
+#define SAMPLE_BATCH_MAGIC      0x42415443 // "BATC"
+#define SAMPLE_BATCH_MAX        4          //!< max. number of samples in ring buffer
+#define SAMPLE_BATCH_HDR_SIZE   9          //!< frame header size in bytes
+#define SAMPLE_BATCH_REC_SIZE   10         //!< sample size in frame in bytes
+#define SAMPLE_BATCH_NO_DATA    0x7F       //!< humidity value indicating missing sensor data
+
+/// Weather sensor sample
+struct BatchSampleS {
+    uint32_t time;          //!< unixtime
+    float    rain_mm;       //!< rain gauge value [mm] (< 0: invalid)
+    int16_t  temp_c100;     //!< air temperature [degC * 100]
+    uint8_t  humidity;      //!< bit 7: battery o.k., bits 6:0: humidity [%] / SAMPLE_BATCH_NO_DATA
+    uint8_t  wind_gust;     //!< wind gust speed [0.2 m/s]
+    uint8_t  wind_avg;      //!< wind average speed [0.2 m/s]
+    uint8_t  wind_dir;      //!< wind direction [2 deg]
+};
+
+/// Ring buffer - must be retained across deep sleep (e.g. in RTC RAM)
+struct BatchStateS {
+    uint32_t     magic;                         //!< validation of retained data
+    uint8_t      head;                          //!< index of oldest sample
+    uint8_t      count;                         //!< number of samples
+    uint8_t      pending;                       //!< number of samples in frame waiting for acknowledgement
+    BatchSampleS samples[SAMPLE_BATCH_MAX];     //!< samples
+};
+
+typedef struct BatchSampleS batch_sample_t;     //!< Shortcut for struct BatchSampleS
+typedef struct BatchStateS  batch_state_t;      //!< Shortcut for struct BatchStateS
+
+
+/*!
+  \class SampleBatch
+  \brief Batching of weather sensor samples across deep sleep cycles
+*/
+class SampleBatch {
+    public:
+        /*!
+        \brief Constructor.
+
+        \param state    Ring buffer (retained across deep sleep)
+        */
+        SampleBatch(batch_state_t *state) {
+            _state = state;
+        };
+
+        /*!
+        \brief Initialization - clears ring buffer if retained data is invalid.
+        */
+        void begin(void);
+
+        /*!
+        \brief Add sample - overwrites the oldest sample if buffer is full.
+
+        \param time             unixtime
+        \param valid            weather sensor data valid
+        \param battery_ok       weather sensor battery o.k.
+        \param temp_c           air temperature [degC]
+        \param humidity         humidity [%]
+        \param wind_gust_fp1    wind gust speed [0.1 m/s]
+        \param wind_avg_fp1     wind average speed [0.1 m/s]
+        \param wind_dir_fp1     wind direction [0.1 deg]
+        \param rain_mm          rain gauge value [mm] (< 0: invalid)
+        */
+        void add(uint32_t time, bool valid, bool battery_ok, float temp_c, uint8_t humidity,
+                 uint16_t wind_gust_fp1, uint16_t wind_avg_fp1, uint16_t wind_dir_fp1, float rain_mm);
+
+        /*!
+        \brief Get number of samples in buffer.
+        */
+        uint8_t count(void) {
+            return _state->count;
+        };
+
+        /*!
+        \brief Encode all samples into uplink frame.
+
+        \param buf      Output buffer
+        \param size     Size of output buffer
+
+        \returns Frame length in bytes or 0 if not even a single sample fits
+        */
+        uint8_t encode(uint8_t *buf, uint8_t size);
+
+        /*!
+        \brief Remove transmitted samples after acknowledgement.
+
+        \param ack      true if frame has been acknowledged by the network
+        */
+        void confirm(bool ack);
+
+    protected:
+        batch_state_t *_state;  //!< ring buffer
+};
+
+#endif // SAMPLE_BATCH_H
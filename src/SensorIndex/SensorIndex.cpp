@@ -0,0 +1,63 @@
+///////////////////////////////////////////////////////////////////////////////
+// SensorIndex.cpp
+//
+// Sensor type -> slot index for WeatherSensor data
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SensorIndex.h"
+#include "../../logging.h"
+
+void SensorIndex::build(void)
+{
+    clear();
+
+    // Store first valid slot for each type/channel
+    for (size_t i = 0; (i < _ws.sensor.size()) && (i < INT8_MAX); i++) {
+        const Sensor &s = _ws.sensor[i];
+
+        if (!s.valid || (s.s_type >= SENSOR_INDEX_TYPES))
+            continue;
+
+        if (_slot[s.s_type][SENSOR_INDEX_ANY] < 0) {
+            _slot[s.s_type][SENSOR_INDEX_ANY] = i;
+        }
+        if ((s.chan <= SENSOR_INDEX_CH_MAX) && (_slot[s.s_type][s.chan + 1] < 0)) {
+            _slot[s.s_type][s.chan + 1] = i;
+        }
+        log_v("Slot %u: type %u, ch %u", (unsigned)i, s.s_type, s.chan);
+    }
+}
@@ -0,0 +1,121 @@
+///////////////////////////////////////////////////////////////////////////////
+// SensorIndex.h
+//
+// Sensor type -> slot index for WeatherSensor data
+//
+// WeatherSensor::findType() scans all slots on every call. The index is
+// built once after sensor data reception has been completed; afterwards all
+// lookups are done in constant time and refer to the same snapshot of
+// the slot array.
+//
+// For each sensor type, the first valid slot is stored for any channel
+// and for each channel 0...SENSOR_INDEX_CH_MAX.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(SENSOR_INDEX_H)
+#define SENSOR_INDEX_H
+
+#include <Arduino.h>
+#include "WeatherSensorCfg.h"
+#include "WeatherSensor.h"
+
+#define SENSOR_INDEX_TYPES      16      //!< number of sensor types (SENSOR_TYPE_xxx < 16)
+#define SENSOR_INDEX_CH_MAX     7       //!< max. channel number stored in index
+#define SENSOR_INDEX_ANY        0       //!< table column: any channel
+
+
+/*!
+  \class SensorIndex
+  \brief Sensor type -> slot index for WeatherSensor data
+*/
+class SensorIndex {
+    public:
+        /*!
+        \brief Constructor.
+
+        \param ws       WeatherSensor object
+        */
+        SensorIndex(WeatherSensor &ws) : _ws(ws) {
+            clear();
+        };
+
+        /*!
+        \brief Clear index - all lookups fail until build() is called.
+        */
+        void clear(void) {
+            memset(_slot, -1, sizeof(_slot));
+        };
+
+        /*!
+        \brief Build index from WeatherSensor slots.
+        */
+        void build(void);
+
+        /*!
+        \brief Find slot with valid data of given sensor type (same semantics as WeatherSensor::findType()).
+
+        \param type     sensor type (SENSOR_TYPE_xxx)
+        \param ch       channel (0xFF: any channel)
+
+        \returns slot index or -1 if not found
+        */
+        int find(uint8_t type, uint8_t ch = 0xFF) const {
+            if (type >= SENSOR_INDEX_TYPES)
+                return -1;
+            if (ch == 0xFF)
+                return _slot[type][SENSOR_INDEX_ANY];
+            if (ch > SENSOR_INDEX_CH_MAX)
+                return -1;
+            return _slot[type][ch + 1];
+        };
+
+        /*!
+        \brief Find weather sensor slot (SENSOR_TYPE_WEATHER0, otherwise SENSOR_TYPE_WEATHER1).
+
+        \returns slot index or -1 if not found
+        */
+        int weather(void) const {
+            int ws = find(SENSOR_TYPE_WEATHER0);
+            return (ws > -1) ? ws : find(SENSOR_TYPE_WEATHER1);
+        };
+
+    protected:
+        WeatherSensor &_ws;                                         //!< WeatherSensor object
+        int8_t         _slot[SENSOR_INDEX_TYPES][SENSOR_INDEX_CH_MAX + 2]; //!< slot index per type/channel
+};
+
+#endif // SENSOR_INDEX_H
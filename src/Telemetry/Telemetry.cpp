@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////////////////////
+// Telemetry.cpp
+//
+// Wake cycle diagnostics - log2 histograms and error counters (FPort 7)
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Telemetry.h"
+#include "../../logging.h"
+
+static const uint8_t hist_shift[TLM_HIST_NUM] = {
+    TELEMETRY_SHIFT_AWAKE,
+    TELEMETRY_SHIFT_RX,
+    TELEMETRY_SHIFT_BLE,
+    TELEMETRY_SHIFT_JOIN
+};
+
+void Telemetry::begin(void)
+{
+    if (_state->magic != TELEMETRY_MAGIC) {
+        memset(_state, 0, sizeof(telemetry_state_t));
+        _state->magic = TELEMETRY_MAGIC;
+    }
+}
+
+void Telemetry::sample(telemetry_hist_t hist, uint32_t value)
+{
+    uint32_t v = value >> hist_shift[hist];
+    uint8_t bucket = 0;
+
+    // bucket = number of significant bits, limited to last bucket
+    while (v && (bucket < TELEMETRY_BUCKETS - 1)) {
+        v >>= 1;
+        bucket++;
+    }
+    inc(_state->hist[hist][bucket]);
+}
+
+void Telemetry::endCycle(uint32_t awake_ms)
+{
+    sample(TLM_AWAKE, awake_ms);
+    sample(TLM_JOIN, _join_attempts);
+    inc(_state->cycles);
+    log_d("Telemetry: %u cycles, TX failures: %u, sleep timeouts: %u",
+        _state->cycles, _state->tx_fail, _state->sleep_timeouts);
+}
+
+uint8_t Telemetry::encode(uint8_t *buf, uint8_t size)
+{
+    if (size < TELEMETRY_FRAME_SIZE) {
+        return 0;
+    }
+    buf[0] = _state->cycles;
+    buf[1] = _state->tx_fail;
+    buf[2] = _state->sleep_timeouts;
+    memcpy(&buf[3], _state->hist, sizeof(_state->hist));
+    _sent = true;
+    return TELEMETRY_FRAME_SIZE;
+}
+
+void Telemetry::sent(bool ack)
+{
+    _sent = true;
+    if (ack) {
+        memset(_state, 0, sizeof(telemetry_state_t));
+        _state->magic = TELEMETRY_MAGIC;
+    }
+}
@@ -0,0 +1,193 @@
+///////////////////////////////////////////////////////////////////////////////
+// Telemetry.h
+//
+// Wake cycle diagnostics - log2 histograms and error counters (FPort 7)
+//
+// The awake time, the weather sensor reception time, the BLE scan duration
+// and the number of join attempts of each wake cycle are accumulated in
+// histograms with logarithmic buckets; TX failures (uplinks not
+// acknowledged) and sleep timeouts (FORCE_SLEEP) are counted.
+// The state is retained across deep sleep cycles; after the configured
+// number of cycles, it is sent in a diagnostic uplink and cleared.
+//
+// Histogram buckets
+// ------------------
+// Each value is scaled by 2^-shift (see TELEMETRY_SHIFT_*):
+//   bucket 0:    v < 1
+//   bucket k:    2^(k-1) <= v < 2^k    (k = 1..6)
+//   bucket 7:    v >= 64
+//
+// Frame format
+// -------------
+// byte 0:      number of cycles
+// byte 1:      TX failures
+// byte 2:      sleep timeouts
+// byte 3..10:  awake time histogram       (shift 10 - ms)
+// byte 11..18: sensor reception histogram (shift 9 - ms)
+// byte 19..26: BLE scan histogram         (shift 9 - ms)
+// byte 27..34: join attempts histogram    (shift 0)
+// All counters saturate at 255.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(TELEMETRY_H)
+#define TELEMETRY_H
+
+#include <Arduino.h>
+
+#define TELEMETRY_MAGIC         0x544C4D31 // "TLM1"
+#define TELEMETRY_BUCKETS       8
+#define TELEMETRY_SHIFT_AWAKE   10
+#define TELEMETRY_SHIFT_RX      9
+#define TELEMETRY_SHIFT_BLE     9
+#define TELEMETRY_SHIFT_JOIN    0
+
+/// Histograms
+enum telemetry_hist_t {
+    TLM_AWAKE,              //!< awake time in ms
+    TLM_SENSOR_RX,          //!< weather sensor reception time in ms
+    TLM_BLE_SCAN,           //!< BLE scan duration in ms
+    TLM_JOIN,               //!< join attempts
+    TLM_HIST_NUM            //!< number of histograms
+};
+
+/// Telemetry state - must be retained across deep sleep (e.g. in RTC RAM)
+struct TelemetryStateS {
+    uint32_t magic;                                     //!< validation of retained data
+    uint8_t  cycles;                                    //!< number of cycles
+    uint8_t  tx_fail;                                   //!< uplinks not acknowledged
+    uint8_t  sleep_timeouts;                            //!< sleep timer expired
+    uint8_t  hist[TLM_HIST_NUM][TELEMETRY_BUCKETS];     //!< histograms
+};
+
+typedef struct TelemetryStateS telemetry_state_t; //!< Shortcut for struct TelemetryStateS
+
+/// Frame size
+#define TELEMETRY_FRAME_SIZE (3 + TLM_HIST_NUM * TELEMETRY_BUCKETS)
+
+
+/*!
+  \class Telemetry
+  \brief Wake cycle diagnostics
+*/
+class Telemetry {
+    public:
+        /*!
+        \brief Constructor.
+
+        \param state    Telemetry state (retained across deep sleep)
+        \param cycles   Number of cycles per diagnostic uplink (max. 255)
+        */
+        Telemetry(telemetry_state_t *state, uint8_t cycles) {
+            _state  = state;
+            _cycles = cycles;
+        };
+
+        /*!
+        \brief Initialization - clears state if retained data is invalid.
+        */
+        void begin(void);
+
+        /*!
+        \brief Add value to histogram.
+
+        \param hist     Histogram
+        \param value    Value
+        */
+        void sample(telemetry_hist_t hist, uint32_t value);
+
+        /// Count join attempt in current cycle
+        void joinAttempt(void) {
+            _join_attempts++;
+        };
+
+        /// Count uplink which has not been acknowledged
+        void txFailure(void) {
+            inc(_state->tx_fail);
+        };
+
+        /// Count expired sleep timer
+        void sleepTimeout(void) {
+            inc(_state->sleep_timeouts);
+        };
+
+        /*!
+        \brief Complete cycle before entering sleep mode.
+
+        \param awake_ms Awake time in ms
+        */
+        void endCycle(uint32_t awake_ms);
+
+        /*!
+        \brief Check if a diagnostic uplink has to be sent in this cycle.
+
+        \returns true if <cycles> have been accumulated and no frame has been encoded in this cycle
+        */
+        bool pending(void) {
+            return (_state->cycles >= _cycles) && !_sent;
+        };
+
+        /*!
+        \brief Encode diagnostic frame.
+
+        \param buf      Output buffer
+        \param size     Size of output buffer
+
+        \returns Frame length in bytes or 0 if buffer is too small
+        */
+        uint8_t encode(uint8_t *buf, uint8_t size);
+
+        /*!
+        \brief Diagnostic uplink completed - clears state if acknowledged.
+
+        \param ack      true if frame has been acknowledged by the network
+        */
+        void sent(bool ack);
+
+    protected:
+        telemetry_state_t   *_state;                //!< retained state
+        uint8_t             _cycles;                //!< cycles per diagnostic uplink
+        uint8_t             _join_attempts = 0;     //!< join attempts in current cycle
+        bool                _sent = false;          //!< diagnostic uplink tried in current cycle
+
+        static void inc(uint8_t &counter) {
+            if (counter < UINT8_MAX) {
+                counter++;
+            }
+        };
+};
+
+#endif
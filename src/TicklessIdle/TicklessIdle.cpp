@@ -0,0 +1,146 @@
+///////////////////////////////////////////////////////////////////////////////
+// TicklessIdle.cpp
+//
+// Tickless idle while waiting for the LMIC
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TicklessIdle.h"
+#include <arduino_lmic.h>
+#include "../../logging.h"
+
+#if defined(ESP32)
+    #include <esp_sleep.h>
+    #include <driver/gpio.h>
+#elif defined(ARDUINO_ARCH_RP2040)
+    #include <pico/time.h>
+
+// Empty ISR - the interrupt only terminates WFE
+static void dioIsr(void)
+{
+}
+#endif
+
+#define DIO_UNUSED 0xFF
+
+void TicklessIdle::begin(void)
+{
+    #if defined(ARDUINO_ARCH_RP2040)
+        for (int i=0; i < 2; i++) {
+            if (_dio[i] != DIO_UNUSED) {
+                attachInterrupt(digitalPinToInterrupt(_dio[i]), dioIsr, RISING);
+            }
+        }
+    #endif
+}
+
+uint32_t TicklessIdle::available(void)
+{
+    // Note: os_queryTimeCriticalJobs() expects an absolute time
+    const ostime_t now = os_getTime();
+    uint32_t lo = _min_ms;
+    uint32_t hi = _max_ms;
+
+    if (os_queryTimeCriticalJobs(now + ms2osticks(lo + _guard_ms))) {
+        return 0;
+    }
+    if (!os_queryTimeCriticalJobs(now + ms2osticks(hi + _guard_ms))) {
+        return hi;
+    }
+
+    // Binary search for the deadline of the next job
+    while (hi - lo > 1) {
+        uint32_t mid = (lo + hi) / 2;
+        if (os_queryTimeCriticalJobs(now + ms2osticks(mid + _guard_ms))) {
+            hi = mid;
+        } else {
+            lo = mid;
+        }
+    }
+    return lo;
+}
+
+uint32_t TicklessIdle::idle(void)
+{
+    uint32_t duration_ms = available();
+
+    if (duration_ms == 0) {
+        return 0;
+    }
+
+    // The DIO lines are still high if the LMIC has not handled the radio interrupt yet
+    for (int i=0; i < 2; i++) {
+        if ((_dio[i] != DIO_UNUSED) && digitalRead(_dio[i])) {
+            return 0;
+        }
+    }
+
+    uint32_t start = millis();
+
+    #if defined(ESP32)
+        Serial.flush();
+        esp_sleep_enable_timer_wakeup(duration_ms * 1000ULL);
+        for (int i=0; i < 2; i++) {
+            if (_dio[i] != DIO_UNUSED) {
+                gpio_wakeup_enable((gpio_num_t)_dio[i], GPIO_INTR_HIGH_LEVEL);
+            }
+        }
+        esp_sleep_enable_gpio_wakeup();
+
+        esp_err_t res = esp_light_sleep_start();
+
+        for (int i=0; i < 2; i++) {
+            if (_dio[i] != DIO_UNUSED) {
+                gpio_wakeup_disable((gpio_num_t)_dio[i]);
+            }
+        }
+        // Deep sleep wake-up sources are configured separately
+        esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_ALL);
+        if (res != ESP_OK) {
+            // e.g. rejected while the BLE controller is active
+            log_v("Light sleep failed: %d", res);
+            return 0;
+        }
+    #elif defined(ARDUINO_ARCH_RP2040)
+        best_effort_wfe_or_timeout(make_timeout_time_ms(duration_ms));
+    #else
+        return 0;
+    #endif
+
+    uint32_t elapsed_ms = millis() - start;
+    _idle_ms += elapsed_ms;
+    return elapsed_ms;
+}
@@ -0,0 +1,134 @@
+///////////////////////////////////////////////////////////////////////////////
+// TicklessIdle.h
+//
+// Tickless idle while waiting for the LMIC
+//
+// Between the LoRaWAN transmission and the receive windows, while waiting
+// for the join accept and between join attempts, the LMIC has nothing to do
+// until its next scheduled job or a radio DIO interrupt. Instead of polling
+// in loop() at full speed, the MCU is put into a low power state until
+//
+//   (next LMIC job deadline) - guard time
+//
+// or until one of the radio's DIO lines goes high:
+// - ESP32:  light sleep (timer and GPIO wake-up); the system time (micros(),
+//           used by the LMIC HAL) is compensated by the ESP-IDF
+// - RP2040: wait for event (WFE) until a hardware timer alarm or a DIO
+//           interrupt; dormant mode can not be used, because it stops the
+//           timer used by the LMIC
+//
+// Time-critical LMIC jobs (TX start, receive windows) are timed jobs, which
+// are found with os_queryTimeCriticalJobs(). Jobs posted by the DIO interrupt
+// processing are run in the same os_runloop_once() call.
+//
+// Notes:
+// - The idle duration is limited to max_ms, so the other tasks in loop()
+//   are still polled regularly.
+// - ESP32: The UART output is flushed before light sleep; USB CDC consoles
+//   (ESP32-S2/S3) may be disconnected during light sleep.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#if !defined(TICKLESS_IDLE_H)
+#define TICKLESS_IDLE_H
+
+#include <Arduino.h>
+
+
+/*!
+  \class TicklessIdle
+  \brief Low power idle until the next LMIC deadline or radio interrupt
+*/
+class TicklessIdle {
+    public:
+        /*!
+        \brief Constructor.
+
+        \param dio0         Radio DIO0 pin
+        \param dio1         Radio DIO1 pin (0xFF: unused)
+        \param min_ms       Min. idle duration [ms] - shorter intervals are polled
+        \param max_ms       Max. idle duration [ms]
+        \param guard_ms     Wake-up time before the next LMIC job [ms]
+        */
+        TicklessIdle(uint8_t dio0, uint8_t dio1, uint16_t min_ms, uint16_t max_ms, uint8_t guard_ms) {
+            _dio[0]   = dio0;
+            _dio[1]   = dio1;
+            _min_ms   = min_ms;
+            _max_ms   = max_ms;
+            _guard_ms = guard_ms;
+            _idle_ms  = 0;
+        };
+
+        /*!
+        \brief Initialization - configures the DIO pins as wake-up sources.
+        */
+        void begin(void);
+
+        /*!
+        \brief Enter low power state until the next LMIC job or radio interrupt.
+
+        Returns immediately if the next LMIC job is due within min_ms.
+
+        \returns idle duration [ms]
+        */
+        uint32_t idle(void);
+
+        /*!
+        \brief Get accumulated idle duration.
+
+        \returns idle duration since start [ms]
+        */
+        uint32_t idleMs(void) {
+            return _idle_ms;
+        };
+
+    protected:
+        uint8_t  _dio[2];       //!< radio DIO pins
+        uint16_t _min_ms;       //!< min. idle duration [ms]
+        uint16_t _max_ms;       //!< max. idle duration [ms]
+        uint8_t  _guard_ms;     //!< wake-up time before next LMIC job [ms]
+        uint32_t _idle_ms;      //!< accumulated idle duration [ms]
+
+        /*!
+        \brief Get time until the next LMIC job.
+
+        \returns time [ms] (max. _max_ms)
+        */
+        uint32_t available(void);
+};
+
+#endif // TICKLESS_IDLE_H
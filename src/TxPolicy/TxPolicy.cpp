@@ -0,0 +1,129 @@
+///////////////////////////////////////////////////////////////////////////////
+// TxPolicy.cpp
+//
+// LoRaWAN uplink transmit policy
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//          Added parameter 'force' to confirm()
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TxPolicy.h"
+#include "../../logging.h"
+
+void TxPolicy::begin(void)
+{
+    if ((_history->magic != TX_HISTORY_MAGIC) || (_history->count > TX_HISTORY_SIZE)) {
+        memset(_history, 0, sizeof(tx_history_t));
+        _history->magic = TX_HISTORY_MAGIC;
+    }
+}
+
+bool TxPolicy::confirm(bool force)
+{
+    uint8_t shift = (_history->fails < TX_CONFIRM_SHIFT_MAX) ? _history->fails : TX_CONFIRM_SHIFT_MAX;
+    uint16_t interval = (uint16_t)_confirm_every << shift;
+
+    // The first uplink is always confirmed to get an initial link quality
+    _confirmed = force || (_history->count == 0) || (_history->frames + 1 >= interval);
+    if (_confirmed) {
+        _history->frames = 0;
+    } else if (_history->frames < 0xFFFF) {
+        _history->frames++;
+    }
+    log_d("%s uplink (interval: %u)", _confirmed ? "Confirmed" : "Unconfirmed", interval);
+
+    return _confirmed;
+}
+
+bool TxPolicy::complete(bool fSuccess, int8_t snr)
+{
+    if (!_confirmed) {
+        // No acknowledgement requested - no information about the link
+        return false;
+    }
+
+    _history->acks = (_history->acks << 1) | (fSuccess ? 1 : 0);
+    if (_history->count < TX_HISTORY_SIZE) {
+        _history->count++;
+    }
+    if (fSuccess) {
+        _history->fails = 0;
+        _history->snr   = snr;
+    } else if (_history->fails < 0xFF) {
+        _history->fails++;
+    }
+    log_d("Ack: %d, link quality: %u%%, sleep factor: %u", fSuccess, linkQuality(), sleepFactor());
+
+    return fSuccess;
+}
+
+uint8_t TxPolicy::maxPayload(uint8_t dr)
+{
+    if (dr < _num_dr) {
+        return _max_payload[dr];
+    }
+
+    uint8_t min_size = 0xFF;
+    for (uint8_t i=0; i < _num_dr; i++) {
+        if (_max_payload[i] < min_size) {
+            min_size = _max_payload[i];
+        }
+    }
+    return min_size;
+}
+
+uint8_t TxPolicy::linkQuality(void)
+{
+    if (_history->count == 0) {
+        return 100;
+    }
+
+    uint8_t acks = 0;
+    for (uint8_t i=0; i < _history->count; i++) {
+        acks += (_history->acks >> i) & 1;
+    }
+    return acks * 100 / _history->count;
+}
+
+uint8_t TxPolicy::sleepFactor(void)
+{
+    return (_history->fails < _backoff_max) ? 1 + _history->fails : _backoff_max;
+}
+
+void TxPolicy::print(void)
+{
+    log_i("Tx history: acks=0x%02X (%u) fails=%u snr=%d dB frames=%u - link quality: %u%%",
+        _history->acks, _history->count, _history->fails, _history->snr, _history->frames, linkQuality());
+}
@@ -0,0 +1,179 @@
+///////////////////////////////////////////////////////////////////////////////
+// TxPolicy.h
+//
+// LoRaWAN uplink transmit policy
+//
+// - Only every n-th data uplink is sent as confirmed uplink (unless the
+//   caller forces a confirmed uplink, e.g. for frames which are only
+//   removed when acknowledged). If a confirmed
+//   uplink has not been acknowledged, the interval is doubled for each
+//   consecutive failure (max. 4 * n), because each failed confirmed uplink
+//   costs up to 8 transmissions (LMIC retries).
+// - The max. application payload size for the current data rate is provided
+//   from a table supplied by the caller, i.e. the caller can drop optional
+//   payload sections if the frame would not fit.
+// - The acknowledgement history of the confirmed uplinks (link quality) is
+//   provided as a sleep interval factor: after consecutive failures, the
+//   sleep interval is extended (max. by the factor backoff_max) to bound the
+//   energy spent per delivered sample while the link is poor.
+//
+// The history must be retained across deep sleep (e.g. in RTC RAM).
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261017 Created
+//          Added parameter 'force' to confirm()
+//          Added confirmed()
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#if !defined(TX_POLICY_H)
+#define TX_POLICY_H
+
+#include <Arduino.h>
+
+#define TX_HISTORY_MAGIC    0x54584830  // "TXH0"
+#define TX_HISTORY_SIZE     8       //!< number of confirmed uplinks in ack bitmap
+#define TX_CONFIRM_SHIFT_MAX 2      //!< max. confirmation interval: confirm_every << 2
+
+/// Transmit history - must be retained across deep sleep (e.g. in RTC RAM)
+struct TxHistoryS {
+    uint32_t magic;     //!< validation of retained data
+    uint16_t frames;    //!< unconfirmed uplinks since last confirmed uplink
+    uint8_t  acks;      //!< ack bitmap of last confirmed uplinks (bit 0: latest)
+    uint8_t  count;     //!< number of valid entries in ack bitmap
+    uint8_t  fails;     //!< consecutive confirmed uplinks without ack
+    int8_t   snr;       //!< SNR of last acknowledgement [dB]
+};
+
+typedef struct TxHistoryS tx_history_t; //!< Shortcut for struct TxHistoryS
+
+
+/*!
+  \class TxPolicy
+  \brief LoRaWAN uplink transmit policy
+*/
+class TxPolicy {
+    public:
+        /*!
+        \brief Constructor.
+
+        \param history          Transmit history (retained across deep sleep)
+        \param confirm_every    Send every n-th uplink as confirmed uplink (1: all)
+        \param backoff_max      Max. sleep interval factor after failed uplinks (1: off)
+        \param max_payload      Max. application payload size [bytes], indexed by data rate
+        \param num_dr           Number of entries in max_payload
+        */
+        TxPolicy(tx_history_t *history, uint8_t confirm_every, uint8_t backoff_max,
+                 const uint8_t *max_payload, uint8_t num_dr) {
+            _history       = history;
+            _confirm_every = (confirm_every > 0) ? confirm_every : 1;
+            _backoff_max   = (backoff_max > 0) ? backoff_max : 1;
+            _max_payload   = max_payload;
+            _num_dr        = num_dr;
+            _confirmed     = true;
+        };
+
+        /*!
+        \brief Initialization - clears history if retained data is invalid.
+        */
+        void begin(void);
+
+        /*!
+        \brief Decide if the next uplink is sent as confirmed uplink.
+
+        Must be called once per uplink.
+
+        \param force    Uplink must be confirmed (e.g. batch frame)
+
+        \returns true if the uplink shall be confirmed
+        */
+        bool confirm(bool force = false);
+
+        /*!
+        \brief Check if the current uplink is a confirmed uplink.
+
+        \returns result of the last call of confirm()
+        */
+        bool confirmed(void) {
+            return _confirmed;
+        };
+
+        /*!
+        \brief Uplink completed - update link quality history.
+
+        \param fSuccess     Completion status from the LoRaWAN stack
+        \param snr          SNR of the downlink (acknowledgement) [dB]
+
+        \returns true if the uplink has been acknowledged
+        */
+        bool complete(bool fSuccess, int8_t snr);
+
+        /*!
+        \brief Get max. application payload size.
+
+        \param dr           Data rate
+
+        \returns max. payload size [bytes] (unknown data rate: smallest size)
+        */
+        uint8_t maxPayload(uint8_t dr);
+
+        /*!
+        \brief Get link quality.
+
+        \returns acknowledged confirmed uplinks in history [%] (no history: 100)
+        */
+        uint8_t linkQuality(void);
+
+        /*!
+        \brief Get sleep interval factor.
+
+        \returns 1 + number of consecutive failures, max. backoff_max
+        */
+        uint8_t sleepFactor(void);
+
+        /*!
+        \brief Print history (debug).
+        */
+        void print(void);
+
+    protected:
+        tx_history_t  *_history;        //!< transmit history
+        uint8_t       _confirm_every;   //!< confirmation interval
+        uint8_t       _backoff_max;     //!< max. sleep interval factor
+        const uint8_t *_max_payload;    //!< max. payload size table
+        uint8_t       _num_dr;          //!< number of entries in _max_payload
+        bool          _confirmed;       //!< current uplink is confirmed
+};
+
+#endif // TX_POLICY_H
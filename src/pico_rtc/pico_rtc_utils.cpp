@@ -42,6 +42,7 @@
 // History:
 //
 // 20231006 Created
+// 20261017 Log output with subsystem log level (LOG_LEVEL_RTC)
 //
 // ToDo:
 // - 
@@ -78,11 +79,11 @@ datetime_t *tm_to_datetime(struct tm *ti, datetime_t *dt)
 }
 
 void print_dt(datetime_t dt) {
-    log_i("%4d-%02d-%02d %02d:%02d:%02d", dt.year, dt.month, dt.day, dt.hour, dt.min, dt.sec);
+    logm_i(RTC, "%4d-%02d-%02d %02d:%02d:%02d", dt.year, dt.month, dt.day, dt.hour, dt.min, dt.sec);
 }
 
 void print_tm(struct tm ti) {
-    log_i("%4d-%02d-%02d %02d:%02d:%02d", ti.tm_year+1900, ti.tm_mon+1, ti.tm_mday, ti.tm_hour, ti.tm_min, ti.tm_sec);
+    logm_i(RTC, "%4d-%02d-%02d %02d:%02d:%02d", ti.tm_year+1900, ti.tm_mon+1, ti.tm_mday, ti.tm_hour, ti.tm_min, ti.tm_sec);
 }
 
 time_t datetime_to_epoch(datetime_t *dt, time_t *epoch) {
@@ -121,7 +122,7 @@ datetime_t *epoch_to_datetime(time_t *epoch, datetime_t *dt) {
 void pico_sleep(unsigned duration) {
     datetime_t dt;
     rtc_get_datetime(&dt);
-    log_i("RTC time:");
+    logm_i(RTC, "RTC time:");
     print_dt(dt);
 
     time_t now;
@@ -132,7 +133,7 @@ void pico_sleep(unsigned duration) {
 
     epoch_to_datetime(&wakeup, &dt);
 
-    log_i("Wakeup time:");
+    logm_i(RTC, "Wakeup time:");
     print_dt(dt);
 
     Serial.flush();